@@ -12,64 +12,639 @@
 
 
 #include "./Matrix.h"
+#include "./HalfMatrix.h"
+#include "./kernels/mutation.h"
+#include "./kernels/bitplane.h"
 
 
 namespace tigris{
 
 
-	inline auto sigmoid(float value) -> float {
-		return 1.0f / (1.0f + std::exp(-value));
-	}
+	class AIView;
 
 
 	class AI{
 		public:
-			AI(evo::ArrayProxy<size_t> dimentions) {
+			// `weight_precision` is the precision the weights are stored in. Calculations are always done in fp32.
+			// `layer_activation` is applied to the output of every layer.
+			AI(
+				evo::ArrayProxy<size_t> dimentions,
+				kernels::WeightPrecision weight_precision = kernels::WeightPrecision::FP32,
+				kernels::Activation layer_activation = kernels::Activation::TANH
+			) : activation(layer_activation) {
 				evo::debugAssert(dimentions.size() >= 2, "must have at least 2 dimentions");
 
 				this->matrices.reserve(dimentions.size() - 1);
 				for(size_t i = 0; i < dimentions.size() - 1; i+=1){
 					this->matrices.emplace_back(Matrix::random(dimentions[i + 1], dimentions[i]));
 				}
+
+				if(weight_precision != kernels::WeightPrecision::FP32){
+					*this = this->withPrecision(weight_precision);
+				}
 			}
 
+			// copies the weights of `view` (stored as fp32)
+			explicit AI(const AIView& view);
+
 			~AI() = default;
 
 
+			// Ping-pong buffers for the outputs of the layers.
+			// 	Once it has been used with an AI it will not allocate again for AIs of the same (or smaller) size.
+			struct Workspace{
+				AlignedVector<float, Matrix::ALIGNMENT> ping{};
+				AlignedVector<float, Matrix::ALIGNMENT> pong{};
+
+				auto reserve(const AI& ai) -> void {
+					this->reserve(ai.maxLayerStride());
+				}
+
+				// `layer_size` floats in each buffer
+				auto reserve(size_t layer_size) -> void {
+					if(this->ping.size() < layer_size){
+						this->ping.resize(layer_size);
+						this->pong.resize(layer_size);
+					}
+				}
+			};
+
+
+			// The returned span points into `workspace` and is valid until it is used again
+			EVO_NODISCARD auto calculate(std::span<const float> inputs, Workspace& workspace) const
+			-> std::span<const float> {
+				evo::debugAssert(inputs.size() == this->numInputs(), "Wrong number of inputs");
+
+				workspace.reserve(*this);
+
+				return std::span<const float>(
+					this->calculate_layers(0, inputs.data(), workspace.ping.data(), workspace.pong.data()),
+					this->numOutputs()
+				);
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(std::span<const float> inputs) const -> std::span<const float> {
+				static thread_local auto workspace = Workspace();
+				return this->calculate(inputs, workspace);
+			}
+
 			auto calculate(std::vector<float>&& inputs) const -> Matrix {
-				auto output = tigris::Matrix(this->matrices[0].height(), 1, std::move(inputs));
+				const std::span<const float> outputs = this->calculate(std::span<const float>(inputs));
+				return tigris::Matrix(outputs.size(), 1, evo::ArrayProxy<float>(outputs.data(), outputs.size()));
+			}
 
-				for(const Matrix& matrix : this->matrices){
-					output *= matrix;
 
-					// for(float& value : output.data()){
-					// 	value = sigmoid(value);
-					// }
+			// Bitplane inputs (every input is 0 or 1, like `tic_tac_toe::Board::getBitplanes()`): input `i` is bit
+			// 	`i % 64` of `input_bits[i / 64]`. The first layer only sums the rows of the set inputs (see
+			// 	`kernels/bitplane.h`), which for sparse boards is much less work than a GEMV over every input.
+			// 	Same as `calculate()` on the inputs as 0 / 1 floats
+			EVO_NODISCARD auto calculate(std::span<const uint64_t> input_bits, Workspace& workspace) const
+			-> std::span<const float> {
+				workspace.reserve(*this);
+				this->gather_first_layer(input_bits, workspace.ping.data(), this->activation);
 
-					for(float& value : output.data()){
-						value = std::tanh(value);
-					}
+				return std::span<const float>(
+					this->calculate_layers(1, workspace.ping.data(), workspace.pong.data(), workspace.ping.data()),
+					this->numOutputs()
+				);
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(std::span<const uint64_t> input_bits) const -> std::span<const float> {
+				static thread_local auto workspace = Workspace();
+				return this->calculate(input_bits, workspace);
+			}
+
+
+			// NNUE-style incremental first layer: the sums of the first layer (before its activation) for some inputs.
+			// 	Boards that differ from the current one in a single space (like every possible move of a game) differ
+			// 	in a single input, so their first layer is the accumulator of the current board plus one row of
+			// 	weights, instead of a whole GEMV each.
+			struct Accumulator{
+				AlignedVector<float, Matrix::ALIGNMENT> values{};
+			};
+
+			auto initAccumulator(std::span<const float> inputs, Accumulator& accumulator) const -> void {
+				evo::debugAssert(inputs.size() == this->numInputs(), "Wrong number of inputs");
+
+				this->visit_layers([&](const auto& layers){
+					const auto& layer = layers.front();
+					accumulator.values.resize(layer.stride());
+					kernels::gemv(
+						inputs.data(),
+						layer.data().data(), layer.stride(),
+						accumulator.values.data(),
+						layer.stride(), layer.height(),
+						kernels::Activation::NONE
+					);
+				});
+			}
+
+			// for bitplane inputs (see `calculate(std::span<const uint64_t>)`)
+			auto initAccumulator(std::span<const uint64_t> input_bits, Accumulator& accumulator) const -> void {
+				accumulator.values.resize(this->visit_layers([](const auto& layers){ return layers.front().stride(); }));
+				this->gather_first_layer(input_bits, accumulator.values.data(), kernels::Activation::NONE);
+			}
+
+			// input `input_index` changed by `delta`
+			auto updateAccumulator(Accumulator& accumulator, size_t input_index, float delta) const -> void {
+				this->add_first_layer_row(accumulator, input_index, delta, accumulator.values.data());
+			}
+
+			// Same as `calculate()` on the inputs of `accumulator`
+			EVO_NODISCARD auto calculate(const Accumulator& accumulator, Workspace& workspace) const
+			-> std::span<const float> {
+				workspace.reserve(*this);
+				std::ranges::copy(accumulator.values, workspace.ping.data());
+				return this->calculate_from_accumulator(workspace);
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(const Accumulator& accumulator) const -> std::span<const float> {
+				static thread_local auto workspace = Workspace();
+				return this->calculate(accumulator, workspace);
+			}
+
+			// Same as `calculate()` on the inputs of `accumulator` with input `input_index` changed by `delta`
+			// 	(`accumulator` is not changed). The returned span points into `workspace`
+			EVO_NODISCARD auto calculate(
+				const Accumulator& accumulator, size_t input_index, float delta, Workspace& workspace
+			) const -> std::span<const float> {
+				workspace.reserve(*this);
+				this->add_first_layer_row(accumulator, input_index, delta, workspace.ping.data());
+				return this->calculate_from_accumulator(workspace);
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(const Accumulator& accumulator, size_t input_index, float delta) const
+			-> std::span<const float> {
+				static thread_local auto workspace = Workspace();
+				return this->calculate(accumulator, input_index, delta, workspace);
+			}
+
+
+			// Runs a batch of inputs (one per row of `inputs`) through the network with one GEMM per layer.
+			// 	Row `i` of the output is the output for row `i` of `inputs`. The returned view points into `workspace`
+			// 	and is valid until it is used again
+			EVO_NODISCARD auto calculateBatch(ConstMatrixView inputs, Workspace& workspace) const -> ConstMatrixView {
+				evo::debugAssert(inputs.width() == this->numInputs(), "Wrong number of inputs");
+
+				workspace.reserve(inputs.height() * this->maxLayerStride());
+
+				return this->calculate_batch_layers(0, inputs, workspace.ping.data(), workspace.pong.data());
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculateBatch(ConstMatrixView inputs) const -> ConstMatrixView {
+				static thread_local auto workspace = Workspace();
+				return this->calculateBatch(inputs, workspace);
+			}
+
+			// Same as `calculateBatch()` on the inputs of `accumulator` with input `input_indices[i]` changed by `delta` for
+			// 	row `i` (like every possible move of a game placing the same piece). The first layer is one row of
+			// 	weights per input, and the other layers are one GEMM each
+			EVO_NODISCARD auto calculateBatch(
+				const Accumulator& accumulator, std::span<const size_t> input_indices, float delta, Workspace& workspace
+			) const -> ConstMatrixView {
+				const size_t batch_size = input_indices.size();
+				workspace.reserve(batch_size * this->maxLayerStride());
+
+				const size_t first_layer_stride = accumulator.values.size();
+				for(size_t i = 0; i < batch_size; i+=1){
+					float* first_layer_output = &workspace.ping[i * first_layer_stride];
+					this->add_first_layer_row(accumulator, input_indices[i], delta, first_layer_output);
 				}
 
-				return output;
+				const size_t first_layer_width = this->visit_layers([](const auto& layers){
+					return layers.front().width();
+				});
+				kernels::activate(
+					this->activation, workspace.ping.data(), workspace.ping.data(), batch_size * first_layer_stride
+				);
+
+				return this->calculate_batch_layers(
+					1,
+					ConstMatrixView(workspace.ping.data(), first_layer_width, batch_size, first_layer_stride),
+					workspace.pong.data(),
+					workspace.ping.data()
+				);
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculateBatch(
+				const Accumulator& accumulator, std::span<const size_t> input_indices, float delta
+			) const -> ConstMatrixView {
+				static thread_local auto workspace = Workspace();
+				return this->calculateBatch(accumulator, input_indices, delta, workspace);
 			}
 
 
+			// Each weight is skipped with probability `mutation_rate` and otherwise mutated (see
+			// 	`kernels::MutationSampler`), by adding a value in [0, 1) to it. Reproducible from `stream`
+			auto mutate(float mutation_rate, const kernels::RandomStream& stream) -> void {
+				this->mutate_weights(mutation_rate, stream, [](kernels::MutationSampler& sampler) -> float {
+					return sampler.nextUniform01()/* * 0.2f - 0.1f*/;
+				});
+			}
+
 			auto mutate(float mutation_rate) -> void {
-				evo::debugAssert(mutation_rate >= 0.0f, "Mutation rate must be [0-1]");
-				evo::debugAssert(mutation_rate <= 1.0f, "Mutation rate must be [0-1]");
+				this->mutate(mutation_rate, kernels::RandomStream(kernels::randomSeed(), 0, 0));
+			}
 
-				for(Matrix& matrix : this->matrices){
-					for(float& value : matrix.data()){
-						if(mutation_rate > float(evo::random01())){ continue; }
-						value += float(evo::random01()/* * 0.2f - 0.1f*/);
+			// Same as `mutate()`, but adds zero-mean Gaussian noise with standard deviation `sigma` instead, so weights
+			// 	can move in both directions. Reproducible from `stream`
+			auto mutateGaussian(float mutation_rate, float sigma, const kernels::RandomStream& stream) -> void {
+				this->mutate_weights(mutation_rate, stream, [sigma](kernels::MutationSampler& sampler) -> float {
+					return sampler.nextNormal() * sigma;
+				});
+			}
+
+			auto mutateGaussian(float mutation_rate, float sigma) -> void {
+				this->mutateGaussian(mutation_rate, sigma, kernels::RandomStream(kernels::randomSeed(), 0, 0));
+			}
+
+
+			// Sets every weight to a value in [0, 1), reproducible from (`seed`, `genome_id`, layer index).
+			// 	Only touches this AI, so different AIs can be randomized in parallel.
+			auto randomize(uint64_t seed, uint64_t genome_id) -> void {
+				this->visit_layers([&](auto& layers) -> void {
+					for(size_t i = 0; i < layers.size(); i+=1){
+						const auto stream = kernels::RandomStream(seed, genome_id, uint32_t(i));
+
+						using Layer = std::remove_reference_t<decltype(layers[i])>;
+						if constexpr(std::is_same_v<Layer, Matrix>){
+							layers[i].fillRandom(stream);
+						}else{
+							layers[i] = Layer(Matrix::random(layers[i].width(), layers[i].height(), stream));
+						}
 					}
-				}
+				});
 			}
+
+
+			// copy of this AI with the weights stored in `weight_precision`
+			EVO_NODISCARD auto withPrecision(kernels::WeightPrecision weight_precision) const -> AI {
+				auto output = AI();
+				output.precision = weight_precision;
+				output.activation = this->activation;
+
+				this->visit_layers([&](const auto& layers){
+					for(const auto& layer : layers){
+						const Matrix matrix = to_matrix(layer);
+
+						switch(weight_precision){
+							break; case kernels::WeightPrecision::FP32: output.matrices.emplace_back(matrix);
+							break; case kernels::WeightPrecision::BF16: output.bf16_matrices.emplace_back(matrix);
+							break; case kernels::WeightPrecision::FP16: output.fp16_matrices.emplace_back(matrix);
+						}
+					}
+				});
+
+				return output;
+			}
+
+			EVO_NODISCARD auto getPrecision() const -> kernels::WeightPrecision { return this->precision; }
+
+			EVO_NODISCARD auto getActivation() const -> kernels::Activation { return this->activation; }
+			auto setActivation(kernels::Activation layer_activation) -> void { this->activation = layer_activation; }
+
+
+			// only available for fp32 AIs (see `withPrecision()`)
+			EVO_NODISCARD auto getMatrices() const -> evo::ArrayProxy<Matrix> {
+				evo::debugAssert(this->precision == kernels::WeightPrecision::FP32, "AI is not stored as fp32");
+				return this->matrices;
+			}
+
+			// only available for fp32 AIs. Valid until the layers of this AI are changed or it is destroyed
+			EVO_NODISCARD auto view() const -> AIView;
+
+			EVO_NODISCARD auto numInputs() const -> size_t {
+				return this->visit_layers([](const auto& layers){ return layers.front().height(); });
+			}
+			EVO_NODISCARD auto numOutputs() const -> size_t {
+				return this->visit_layers([](const auto& layers){ return layers.back().width(); });
+			}
+
+			EVO_NODISCARD auto maxLayerStride() const -> size_t {
+				return this->visit_layers([](const auto& layers){
+					size_t max_layer_stride = 0;
+					for(const auto& layer : layers){
+						max_layer_stride = std::max(max_layer_stride, layer.stride());
+					}
+					return max_layer_stride;
+				});
+			}
+
+			// bytes used by the weights (including padding)
+			EVO_NODISCARD auto weightBytes() const -> size_t {
+				return this->visit_layers([](const auto& layers){
+					size_t weight_bytes = 0;
+					for(const auto& layer : layers){
+						weight_bytes += layer.data().size_bytes();
+					}
+					return weight_bytes;
+				});
+			}
+
+
+		private:
+			AI() = default;
+
+			// calls `func` with the vector of layers of the stored precision
+			template<class Func>
+			auto visit_layers(Func&& func) -> std::invoke_result_t<Func&, std::vector<Matrix>&> {
+				if(this->precision == kernels::WeightPrecision::FP32){ return func(this->matrices); }
+				if(this->precision == kernels::WeightPrecision::BF16){ return func(this->bf16_matrices); }
+				return func(this->fp16_matrices);
+			}
+
+			template<class Func>
+			auto visit_layers(Func&& func) const -> std::invoke_result_t<Func&, const std::vector<Matrix>&> {
+				if(this->precision == kernels::WeightPrecision::FP32){ return func(this->matrices); }
+				if(this->precision == kernels::WeightPrecision::BF16){ return func(this->bf16_matrices); }
+				return func(this->fp16_matrices);
+			}
+
+			// Runs the layers from `first_layer` on (`layer_input` is the input of `first_layer`) and returns the output
+			// 	of the last one. `layer_output` and `next_layer_output` are used as ping-pong buffers and must not
+			// 	alias `layer_input`, except that `layer_input` may be `next_layer_output`.
+			// 	The input is a single row, so each layer is a GEMV with the activation fused in. The padding of the
+			// 	layers is included so the kernel always uses whole vectors
+			auto calculate_layers(
+				size_t first_layer, const float* layer_input, float* layer_output, float* next_layer_output
+			) const -> const float* {
+				this->visit_layers([&](const auto& layers){
+					for(size_t i = first_layer; i < layers.size(); i+=1){
+						kernels::gemv(
+							layer_input,
+							layers[i].data().data(), layers[i].stride(),
+							layer_output,
+							layers[i].stride(), layers[i].height(),
+							this->activation
+						);
+
+						layer_input = layer_output;
+						std::swap(layer_output, next_layer_output);
+					}
+				});
+
+				return layer_input;
+			}
+
+			// Same as `calculate_layers()` for a batch of inputs (one per row of `layer_input`), with one GEMM per layer.
+			// 	As in `calculate()`, the padding of the layers is included so the kernels always use whole vectors
+			auto calculate_batch_layers(
+				size_t first_layer, ConstMatrixView layer_input, float* layer_output, float* next_layer_output
+			) const -> ConstMatrixView {
+				const size_t batch_size = layer_input.height();
+
+				this->visit_layers([&](const auto& layers){
+					for(size_t i = first_layer; i < layers.size(); i+=1){
+						const auto& layer = layers[i];
+
+						kernels::gemm(
+							layer_input.data(), layer_input.stride(),
+							layer.data().data(), layer.stride(),
+							layer_output, layer.stride(),
+							batch_size, layer.stride(), layer.height()
+						);
+						kernels::activate(this->activation, layer_output, layer_output, batch_size * layer.stride());
+
+						layer_input = ConstMatrixView(layer_output, layer.width(), batch_size, layer.stride());
+						std::swap(layer_output, next_layer_output);
+					}
+				});
+
+				return layer_input;
+			}
+
+			// output[j] = accumulator[j] + delta * (row `input_index` of the first layer)[j]
+			// 	The padding is included (it stays 0)
+			auto add_first_layer_row(const Accumulator& accumulator, size_t input_index, float delta, float* output) const
+			-> void {
+				evo::debugAssert(input_index < this->numInputs(), "Input index out of range");
+
+				this->visit_layers([&](const auto& layers){
+					const auto& layer = layers.front();
+					const auto row = layer.data().subspan(input_index * layer.stride(), layer.stride());
+					for(size_t j = 0; j < row.size(); j+=1){
+						output[j] = accumulator.values[j] + delta * float(row[j]);
+					}
+				});
+			}
+
+			// output = activation(the sum of the rows of the first layer of the set bits of `input_bits`)
+			// 	The padding is included (it stays 0)
+			auto gather_first_layer(std::span<const uint64_t> input_bits, float* output, kernels::Activation act) const
+			-> void {
+				evo::debugAssert(input_bits.size() == (this->numInputs() + 63) / 64, "Wrong number of input words");
+				evo::debugAssert(
+					this->numInputs() % 64 == 0 || (input_bits.back() >> (this->numInputs() % 64)) == 0,
+					"Input bits set past the last input"
+				);
+
+				this->visit_layers([&](const auto& layers){
+					const auto& layer = layers.front();
+
+					if constexpr(std::is_same_v<std::remove_cvref_t<decltype(layer)>, Matrix>){
+						kernels::bitplaneGemv(input_bits, layer.data().data(), layer.stride(), output, layer.stride(), act);
+
+					}else{
+						// reduced precision weights are widened one row at a time
+						std::fill_n(output, layer.stride(), 0.0f);
+						for(size_t word = 0; word < input_bits.size(); word+=1){
+							for(uint64_t remaining = input_bits[word]; remaining != 0; remaining &= remaining - 1){
+								const size_t input_index = word * 64 + size_t(std::countr_zero(remaining));
+								const auto row = layer.data().subspan(input_index * layer.stride(), layer.stride());
+								for(size_t j = 0; j < row.size(); j+=1){
+									output[j] += float(row[j]);
+								}
+							}
+						}
+						kernels::activate(act, output, output, layer.stride());
+					}
+				});
+			}
+
+			// the sums of the first layer are in `workspace.ping`
+			auto calculate_from_accumulator(Workspace& workspace) const -> std::span<const float> {
+				const size_t first_layer_width = this->visit_layers([](const auto& layers){
+					return layers.front().width();
+				});
+				kernels::activate(this->activation, workspace.ping.data(), workspace.ping.data(), first_layer_width);
+
+				return std::span<const float>(
+					this->calculate_layers(1, workspace.ping.data(), workspace.pong.data(), workspace.ping.data()),
+					this->numOutputs()
+				);
+			}
+
+			// adds `amount(sampler)` to every weight picked by the sampler
+			template<class AmountFunc>
+			auto mutate_weights(float mutation_rate, const kernels::RandomStream& stream, AmountFunc&& amount) -> void {
+				auto sampler = kernels::MutationSampler(1.0f - mutation_rate, stream);
+
+				// reduced precision weights are widened, mutated in fp32, and then rounded back to the stored precision
+				this->visit_layers([&](auto& layers) -> void {
+					for(auto& layer : layers){
+						sampler.forEachMutated(layer.width() * layer.height(), [&](size_t i) -> void {
+							auto& value = layer[i % layer.width(), i / layer.width()];
+
+							using Value = std::remove_reference_t<decltype(value)>;
+							value = Value(float(value) + amount(sampler));
+						});
+					}
+				});
+			}
+
+			EVO_NODISCARD static auto to_matrix(const Matrix& matrix) -> const Matrix& { return matrix; }
+			template<class Half>
+			EVO_NODISCARD static auto to_matrix(const HalfMatrix<Half>& matrix) -> Matrix { return matrix.toMatrix(); }
 	
 		private:
+			kernels::Activation activation = kernels::Activation::TANH;
+			kernels::WeightPrecision precision = kernels::WeightPrecision::FP32;
+
+			// only the vector for `precision` is used
 			std::vector<Matrix> matrices{};
+			std::vector<HalfMatrix<kernels::BF16>> bf16_matrices{};
+			std::vector<HalfMatrix<kernels::FP16>> fp16_matrices{};
+	};
+
+
+
+	// Non-owning fp32 AI: the layers are `tigris::ConstMatrixView`s of weights stored anywhere (an arena, a
+	// 	memory-mapped file, a mapped Vulkan buffer, ...), so inference runs on them without copying anything.
+	// 	Produces the same outputs as an `AI` with the same weights and activation.
+	class AIView{
+		public:
+			using Workspace = AI::Workspace;
+
+
+			AIView(evo::ArrayProxy<ConstMatrixView> view_layers, kernels::Activation layer_activation)
+				: layers(view_layers.begin(), view_layers.end()), activation(layer_activation) {
+				evo::debugAssert(this->layers.empty() == false, "must have at least 1 layer");
+
+				for(size_t i = 1; i < this->layers.size(); i+=1){
+					evo::debugAssert(
+						this->layers[i].height() == this->layers[i - 1].width(), "Layer dimensions do not match"
+					);
+				}
+			}
+
+			~AIView() = default;
+
+
+			// The returned span points into `workspace` and is valid until it is used again
+			EVO_NODISCARD auto calculate(std::span<const float> inputs, Workspace& workspace) const
+			-> std::span<const float> {
+				evo::debugAssert(inputs.size() == this->numInputs(), "Wrong number of inputs");
+
+				workspace.reserve(this->maxLayerWidth());
+
+				const float* layer_input = inputs.data();
+				float* layer_output = workspace.ping.data();
+				float* next_layer_output = workspace.pong.data();
+
+				// nothing is known about the padding of the views, so only the logical columns are calculated
+				for(const ConstMatrixView& layer : this->layers){
+					kernels::gemv(
+						layer_input,
+						layer.data(), layer.stride(),
+						layer_output,
+						layer.width(), layer.height(),
+						this->activation
+					);
+
+					layer_input = layer_output;
+					std::swap(layer_output, next_layer_output);
+				}
+
+				return std::span<const float>(layer_input, this->numOutputs());
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(std::span<const float> inputs) const -> std::span<const float> {
+				static thread_local auto workspace = Workspace();
+				return this->calculate(inputs, workspace);
+			}
+
+
+			// Same as `tigris::AI::calculateBatch()`. The outputs of each layer are laid out like a `tigris::Matrix`.
+			EVO_NODISCARD auto calculateBatch(ConstMatrixView inputs, Workspace& workspace) const -> ConstMatrixView {
+				evo::debugAssert(inputs.width() == this->numInputs(), "Wrong number of inputs");
+
+				const size_t batch_size = inputs.height();
+				workspace.reserve(batch_size * Matrix::strideForWidth(this->maxLayerWidth()));
+
+				ConstMatrixView layer_input = inputs;
+				float* layer_output = workspace.ping.data();
+				float* next_layer_output = workspace.pong.data();
+
+				for(const ConstMatrixView& layer : this->layers){
+					const size_t output_stride = Matrix::strideForWidth(layer.width());
+
+					kernels::gemm(
+						layer_input.data(), layer_input.stride(),
+						layer.data(), layer.stride(),
+						layer_output, output_stride,
+						batch_size, layer.width(), layer.height()
+					);
+					kernels::activate(this->activation, layer_output, layer_output, batch_size * output_stride);
+
+					layer_input = ConstMatrixView(layer_output, layer.width(), batch_size, output_stride);
+					std::swap(layer_output, next_layer_output);
+				}
+
+				return layer_input;
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculateBatch(ConstMatrixView inputs) const -> ConstMatrixView {
+				static thread_local auto workspace = Workspace();
+				return this->calculateBatch(inputs, workspace);
+			}
+
+
+			EVO_NODISCARD auto getLayers() const -> evo::ArrayProxy<ConstMatrixView> { return this->layers; }
+			EVO_NODISCARD auto getActivation() const -> kernels::Activation { return this->activation; }
+
+			EVO_NODISCARD auto numInputs() const -> size_t { return this->layers.front().height(); }
+			EVO_NODISCARD auto numOutputs() const -> size_t { return this->layers.back().width(); }
+
+			EVO_NODISCARD auto maxLayerWidth() const -> size_t {
+				size_t max_layer_width = 0;
+				for(const ConstMatrixView& layer : this->layers){
+					max_layer_width = std::max(max_layer_width, layer.width());
+				}
+				return max_layer_width;
+			}
+	
+		private:
+			evo::SmallVector<ConstMatrixView> layers;
+			kernels::Activation activation;
 	};
 
+
+	inline auto AI::view() const -> AIView {
+		evo::debugAssert(this->precision == kernels::WeightPrecision::FP32, "AI is not stored as fp32");
+
+		auto layer_views = evo::SmallVector<ConstMatrixView>();
+		layer_views.reserve(this->matrices.size());
+		for(const Matrix& matrix : this->matrices){
+			layer_views.emplace_back(matrix.view());
+		}
+
+		return AIView(layer_views, this->activation);
+	}
+
+	inline AI::AI(const AIView& view) : activation(view.getActivation()) {
+		this->matrices.reserve(view.getLayers().size());
+		for(const ConstMatrixView& layer : view.getLayers()){
+			this->matrices.emplace_back(layer);
+		}
+	}
+
 	
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include <new>
+
+
+namespace tigris{
+
+
+	template<class T, size_t ALIGNMENT>
+	class AlignedAllocator{
+		public:
+			static_assert(std::has_single_bit(ALIGNMENT), "Alignment must be a power of 2");
+			static_assert(ALIGNMENT >= alignof(T), "Alignment must be at least the alignment of T");
+
+			using value_type = T;
+
+			template<class U>
+			struct rebind{ using other = AlignedAllocator<U, ALIGNMENT>; };
+
+
+			constexpr AlignedAllocator() = default;
+
+			template<class U>
+			constexpr AlignedAllocator(const AlignedAllocator<U, ALIGNMENT>&) {}
+
+
+			EVO_NODISCARD auto allocate(size_t count) -> T* {
+				return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(ALIGNMENT)));
+			}
+
+			auto deallocate(T* ptr, size_t) -> void {
+				::operator delete(ptr, std::align_val_t(ALIGNMENT));
+			}
+
+
+			template<class U>
+			EVO_NODISCARD constexpr auto operator==(const AlignedAllocator<U, ALIGNMENT>&) const -> bool {
+				return true;
+			}
+	};
+
+
+	template<class T, size_t ALIGNMENT>
+	using AlignedVector = std::vector<T, AlignedAllocator<T, ALIGNMENT>>;
+
+	
+}
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./AI.h"
+
+#include <filesystem>
+
+
+namespace tigris{
+
+
+	// `$XDG_CACHE_HOME/tigris`, or `~/.cache/tigris` if it is not set (empty if the home directory is not known)
+	EVO_NODISCARD auto defaultCodegenCacheDirectory() -> std::filesystem::path;
+
+
+	// How `tigris::CompiledAI` compiles its forward functions
+	struct CodegenOptions{
+		std::string compiler = "c++"; // gcc / clang compatible command line
+		std::string flags = "-O3 -march=native";
+
+		// Each compiled shape is kept here (named by the hash of its source, the compiler command, and the features of
+		// 	the host CPU), so it is only compiled once, not once per process. The libraries in it are loaded into the
+		// 	process, so it is created with mode 0700 and not used (falls back to `tigris::AI`) if it, or a file in it,
+		// 	is a symlink, is not owned by the current user, or can be written by other users
+		std::filesystem::path cacheDirectory = defaultCodegenCacheDirectory();
+	};
+
+
+	// Inference-only copy of a `tigris::AI` whose forward pass is generated C++ compiled at runtime.
+	// 	The dimensions, strides, and activation are constants in the generated source (small layers are fully
+	// 	unrolled), which is compiled by the system compiler into a shared library and loaded with `dlopen`. The
+	// 	weights are not part of the generated code, so every AI of the same shape shares one compiled function.
+	// 	Compiling takes a few hundred milliseconds, so this is for long jobs with a fixed topology whose dimensions
+	// 	are not known when Tigris is compiled (otherwise use `tigris::StaticAI`).
+	// 	If the code can not be compiled or loaded (no compiler, or on Windows), it falls back to `tigris::AI`.
+	class CompiledAI{
+		public:
+			// `layers[i]` is the weights of layer `i`, with the layout of `tigris::Matrix` (including the stride)
+			using ForwardFunc = void(*)(const float* const* layers, const float* input, float* output);
+
+
+			// reduced precision AIs are widened to fp32
+			explicit CompiledAI(const AI& _ai, const CodegenOptions& options = CodegenOptions())
+				: ai(_ai.getPrecision() == kernels::WeightPrecision::FP32
+					? _ai
+					: _ai.withPrecision(kernels::WeightPrecision::FP32)
+				),
+				forward(load_forward_function(this->ai, options)) {
+
+				for(const Matrix& matrix : this->ai.getMatrices()){
+					this->layer_weights.emplace_back(matrix.data().data());
+				}
+			}
+
+			~CompiledAI() = default;
+
+			// the weights are pointed to by `layer_weights`
+			CompiledAI(const CompiledAI&) = delete;
+			auto operator=(const CompiledAI&) = delete;
+			CompiledAI(CompiledAI&&) = default;
+			auto operator=(CompiledAI&&) -> CompiledAI& = default;
+
+
+			// The returned span points into a buffer local to the calling thread and is valid until the next call
+			EVO_NODISCARD auto calculate(std::span<const float> inputs) const -> std::span<const float> {
+				evo::debugAssert(inputs.size() == this->numInputs(), "Wrong number of inputs");
+
+				if(this->forward == nullptr){ return this->ai.calculate(inputs); }
+
+				static thread_local auto output = std::vector<float>();
+				output.resize(this->numOutputs());
+				this->forward(this->layer_weights.data(), inputs.data(), output.data());
+				return output;
+			}
+
+
+			// false if it fell back to `tigris::AI`
+			EVO_NODISCARD auto isCompiled() const -> bool { return this->forward != nullptr; }
+
+			EVO_NODISCARD auto getAI() const -> const AI& { return this->ai; }
+
+			EVO_NODISCARD auto numInputs() const -> size_t { return this->ai.numInputs(); }
+			EVO_NODISCARD auto numOutputs() const -> size_t { return this->ai.numOutputs(); }
+
+
+			// The C++ source of the forward function of the shape of `ai` (which must be fp32).
+			// 	Exports `extern "C" tigris_forward` (a `ForwardFunc`) and `tigris_shape` (the shape it was made for)
+			EVO_NODISCARD static auto generateSource(const AI& ai) -> std::string;
+
+
+		private:
+			// compiles (or loads from the cache) the forward function of the shape of `ai`, nullptr if it can not
+			EVO_NODISCARD static auto load_forward_function(const AI& ai, const CodegenOptions& options) -> ForwardFunc;
+
+		private:
+			AI ai;
+			ForwardFunc forward;
+			evo::SmallVector<const float*> layer_weights{};
+	};
+
+
+}
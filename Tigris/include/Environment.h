@@ -12,21 +12,42 @@
 
 
 #include "./AI.h"
+#include "./Population.h"
+#include "./StackedAI.h"
+#include "./ThreadPool.h"
+#include "./EvaluationCache.h"
 
 
 namespace tigris{
 
 
+	// The population is stored in a `tigris::Population` (the weights of every genome in one arena), and a second
+	// 	arena of the same size is reused for the next generation, so reproduction does not allocate: each child is a
+	// 	`memcpy` of its parent's slot, mutated in place.
 	struct Environment{
 		public:
-			Environment(size_t total_population, evo::ArrayProxy<size_t> _dimentions)
-				: totalPopulation(total_population), dimentions(_dimentions.begin(), _dimentions.end()) {}
+			// `weight_precision` and `layer_activation` are used for every AI of the population (see `tigris::AI`)
+			Environment(
+				size_t total_population,
+				evo::ArrayProxy<size_t> _dimentions,
+				kernels::WeightPrecision weight_precision = kernels::WeightPrecision::FP32,
+				kernels::Activation layer_activation = kernels::Activation::TANH
+			) : totalPopulation(total_population),
+				dimentions(_dimentions.begin(), _dimentions.end()),
+				weightPrecision(weight_precision),
+				activation(layer_activation),
+				population(total_population, _dimentions, weight_precision, layer_activation),
+				next_population(total_population, _dimentions, weight_precision, layer_activation) {}
+
+			// Genome `i` is reproducible from (`seed`, `i`). The weights are generated in parallel.
+			auto initRandom(uint64_t seed) -> void {
+				ThreadPool::get().parallelFor(this->totalPopulation, [&](size_t i) -> void {
+					this->population.randomize(i, seed);
+				});
+			}
 
 			auto initRandom() -> void {
-				this->population.reserve(this->totalPopulation);
-				for(size_t i = 0; i < this->totalPopulation; i+=1){
-					this->population.emplace_back(this->dimentions);
-				}
+				this->initRandom(kernels::randomSeed());
 			}
 
 
@@ -47,43 +68,142 @@ namespace tigris{
 			}
 
 
+			// Each child is a copy of its parent's slot in the second arena, mutated in place. The parents are picked
+			// 	first, and then every child is copied and mutated in parallel (each from its own random stream).
+			// 	`mutation_rate` is the probability of each weight being skipped. The others are mutated by a value in
+			// 	[0, 1) or, if `mutationSigma` is set, by zero-mean Gaussian noise with that standard deviation.
 			auto createNewPopulation(float mutation_rate, float num_new_random) -> void {
 				evo::debugAssert(num_new_random <= this->totalPopulation - 1, "Too many new random");
-				
-				auto new_population = std::vector<AI>();
-				new_population.reserve(this->totalPopulation);
+
+				this->parents.resize(this->totalPopulation);
+				size_t num_new_genomes = 0;
 
 				const size_t best_index_from_last_run = std::distance(
 					this->scores.begin(), std::max_element(this->scores.begin(), this->scores.end())
 				);
-				new_population.emplace_back(this->population[best_index_from_last_run]); // keep the best one
+				this->parents[num_new_genomes] = uint32_t(best_index_from_last_run); // keep the best one
+				num_new_genomes += 1;
 
 				for(size_t i = 0; i < num_new_random; i+=1){
-					new_population.emplace_back(this->dimentions);
+					this->next_population.randomize(num_new_genomes, kernels::randomSeed());
+					this->parents[num_new_genomes] = NO_PARENT;
+					num_new_genomes += 1;
 				}
 
 
+				const size_t first_child = num_new_genomes;
+
 				size_t target_index = 0;
-				while(new_population.size() < totalPopulation){
+				while(num_new_genomes < totalPopulation){
 					if(this->scores[target_index] <= evo::random01()){
-						new_population.emplace_back(this->population[target_index]);
-
-						new_population.back().mutate(mutation_rate);
+						this->parents[num_new_genomes] = uint32_t(target_index);
+						num_new_genomes += 1;
 					}
 
 					target_index += 1;
 					if(target_index >= totalPopulation){ target_index = 0; }
 				}
 
-				this->population = std::move(new_population);
+
+				const uint64_t mutation_seed = kernels::randomSeed();
+
+				ThreadPool::get().parallelFor(this->totalPopulation, [&](size_t i) -> void {
+					if(this->parents[i] == NO_PARENT){ return; }
+
+					this->next_population.copyGenome(i, this->population, this->parents[i]);
+					if(i < first_child){ return; }
+
+					const auto stream = kernels::RandomStream(mutation_seed, i, 0);
+					if(this->mutationSigma > 0.0f){
+						this->next_population.mutateGaussian(i, mutation_rate, this->mutationSigma, stream);
+					}else{
+						this->next_population.mutate(i, mutation_rate, stream);
+					}
+				});
+
+				std::swap(this->population, this->next_population);
+
+				if(this->evaluationCaches.empty() == false){
+					this->update_evaluation_caches(first_child);
+				}
+			}
+
+
+			// Gives every genome an `EvaluationCache` of up to `max_entries` evaluations (see `evaluationCaches`)
+			auto enableEvaluationCache(size_t max_entries) -> void {
+				this->evaluationCaches = std::vector<EvaluationCache>(this->totalPopulation, EvaluationCache(max_entries));
+				this->next_evaluation_caches = this->evaluationCaches;
+				this->evaluation_cache_stats = EvaluationCache::Stats();
+			}
+
+			// the hits and misses of every cache since the last call
+			EVO_NODISCARD auto takeEvaluationCacheStats() -> EvaluationCache::Stats {
+				EvaluationCache::Stats stats = this->evaluation_cache_stats;
+				for(EvaluationCache& cache : this->evaluationCaches){
+					stats += cache.getStats();
+					cache.resetStats();
+				}
+
+				this->evaluation_cache_stats = EvaluationCache::Stats();
+				return stats;
+			}
+
+
+			// owning copy of genome `genome_id`, stored in `weightPrecision`
+			EVO_NODISCARD auto getAI(size_t genome_id) const -> AI {
+				return this->population.toAI(genome_id);
+			}
+
+			// Interleaved copy of the population for scoring all of it at once (see `tigris::StackedAI`).
+			// 	Genome `g` of the copy is `getAI(g)` (widened to fp32)
+			EVO_NODISCARD auto stackPopulation() const -> StackedAI {
+				return StackedAI(this->population);
 			}
 
 
 		public:
 			size_t totalPopulation;
 			evo::SmallVector<size_t> dimentions;
-			std::vector<AI> population{};
+			kernels::WeightPrecision weightPrecision;
+			kernels::Activation activation;
+			Population population;
 			std::vector<float> scores{};
+
+			// standard deviation of the Gaussian mutations (0 for the uniform [0, 1) mutations)
+			float mutationSigma = 0.0f;
+
+			// The evaluations of genome `i` are memoized in `evaluationCaches[i]` (empty unless
+			// 	`enableEvaluationCache()` was called). `createNewPopulation()` clears the cache of every genome that was
+			// 	mutated or is new, and genomes that were copied unchanged keep the entries of their parent
+			std::vector<EvaluationCache> evaluationCaches{};
+
+		private:
+			// the genomes before `first_child` were not mutated
+			auto update_evaluation_caches(size_t first_child) -> void {
+				for(EvaluationCache& cache : this->evaluationCaches){
+					this->evaluation_cache_stats += cache.getStats();
+					cache.resetStats();
+				}
+
+				for(size_t i = 0; i < this->totalPopulation; i+=1){
+					if(i < first_child && this->parents[i] != NO_PARENT){
+						this->next_evaluation_caches[i] = this->evaluationCaches[this->parents[i]];
+					}else{
+						this->next_evaluation_caches[i].clear();
+					}
+				}
+
+				std::swap(this->evaluationCaches, this->next_evaluation_caches);
+			}
+
+		private:
+			static constexpr uint32_t NO_PARENT = std::numeric_limits<uint32_t>::max();
+
+			Population next_population;
+			std::vector<uint32_t> parents{}; // of each genome of the last `createNewPopulation()` (reused)
+
+			std::vector<EvaluationCache> next_evaluation_caches{};
+			EvaluationCache::Stats evaluation_cache_stats{}; // of the caches of previous generations
 	};
 
 	
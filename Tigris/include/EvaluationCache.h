@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+
+namespace tigris{
+
+
+	// Memoized evaluations of one AI: board key (like `tic_tac_toe::Board::getKey()`) -> output of the AI for it.
+	// 	Games between the genomes of a population reach the same positions over and over, so looking up the
+	// 	evaluation is much cheaper than calculating it again. Must be cleared when the weights of the AI change.
+	// 	Flat open-addressing table (linear probing) that grows up to the slots needed for `max_entries`. Once it
+	// 	has `max_entries` entries, new ones are not inserted (so games with many positions use bounded memory).
+	// 	Not thread safe.
+	class EvaluationCache{
+		public:
+			// keys must not be `EMPTY_KEY` (the board keys never are)
+			static constexpr uint64_t EMPTY_KEY = std::numeric_limits<uint64_t>::max();
+
+			explicit EvaluationCache(size_t max_entries) : max_num_entries(max_entries) {
+				evo::debugAssert(max_entries > 0, "Cache must be able to hold at least 1 entry");
+			}
+
+			~EvaluationCache() = default;
+
+
+			// the cached evaluation of `key` (counted as a hit or a miss)
+			EVO_NODISCARD auto find(uint64_t key) -> std::optional<float> {
+				evo::debugAssert(key != EMPTY_KEY, "Invalid key");
+
+				if(this->num_entries == 0){
+					this->stats.misses += 1;
+					return std::nullopt;
+				}
+
+				for(size_t slot = this->home_slot(key); ; slot = (slot + 1) & (this->slots.size() - 1)){
+					const Slot& found = this->slots[slot];
+					if(found.key == key){
+						this->stats.hits += 1;
+						return found.value;
+					}
+					if(found.key == EMPTY_KEY){
+						this->stats.misses += 1;
+						return std::nullopt;
+					}
+				}
+			}
+
+			// does nothing if the cache is full (or `key` is already in it)
+			auto insert(uint64_t key, float value) -> void {
+				evo::debugAssert(key != EMPTY_KEY, "Invalid key");
+
+				if(this->num_entries >= this->max_num_entries){ return; }
+
+				// at most half of the slots are used so the probe sequences stay short
+				if((this->num_entries + 1) * 2 > this->slots.size()){ this->grow(); }
+
+				for(size_t slot = this->home_slot(key); ; slot = (slot + 1) & (this->slots.size() - 1)){
+					Slot& found = this->slots[slot];
+					if(found.key == key){ return; }
+					if(found.key == EMPTY_KEY){
+						found = Slot(key, value);
+						this->num_entries += 1;
+						return;
+					}
+				}
+			}
+
+			// removes every entry (keeps the memory and the stats)
+			auto clear() -> void {
+				if(this->num_entries == 0){ return; }
+				std::ranges::fill(this->slots, Slot());
+				this->num_entries = 0;
+			}
+
+
+			struct Stats{
+				size_t hits = 0;
+				size_t misses = 0;
+
+				EVO_NODISCARD auto hitRate() const -> float {
+					if(this->hits + this->misses == 0){ return 0.0f; }
+					return float(this->hits) / float(this->hits + this->misses);
+				}
+
+				auto operator+=(const Stats& rhs) -> Stats& {
+					this->hits += rhs.hits;
+					this->misses += rhs.misses;
+					return *this;
+				}
+			};
+
+			EVO_NODISCARD auto getStats() const -> const Stats& { return this->stats; }
+			auto resetStats() -> void { this->stats = Stats(); }
+
+
+			EVO_NODISCARD auto size() const -> size_t { return this->num_entries; }
+			EVO_NODISCARD auto maxSize() const -> size_t { return this->max_num_entries; }
+			EVO_NODISCARD auto numSlots() const -> size_t { return this->slots.size(); }
+
+
+		private:
+			// Fibonacci hashing: the top bits of the key times 2^64 / golden ratio. The board keys are dense small
+			// 	integers, which this spreads over the whole table
+			EVO_NODISCARD auto home_slot(uint64_t key) const -> size_t {
+				return size_t((key * 0x9E3779B97F4A7C15ull) >> this->shift);
+			}
+
+			auto grow() -> void {
+				const size_t num_slots = std::max<size_t>(this->slots.size() * 2, 16);
+
+				auto old_slots = std::move(this->slots);
+				this->slots = std::vector<Slot>(num_slots);
+				this->shift = uint32_t(64 - std::countr_zero(num_slots));
+				this->num_entries = 0;
+
+				for(const Slot& slot : old_slots){
+					if(slot.key != EMPTY_KEY){ this->insert(slot.key, slot.value); }
+				}
+			}
+
+		private:
+			struct Slot{
+				uint64_t key = EMPTY_KEY;
+				float value = 0.0f;
+			};
+
+			std::vector<Slot> slots{}; // size is 0 or a power of 2
+			uint32_t shift = 64; // 64 - log2(slots.size())
+			size_t num_entries = 0;
+			size_t max_num_entries;
+			Stats stats{};
+	};
+
+
+}
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./Matrix.h"
+#include "./kernels/half.h"
+
+
+namespace tigris{
+
+
+	// `tigris::Matrix` stored as 16 bit floats (`kernels::BF16` or `kernels::FP16`), for weights that are only read
+	// 	by the kernels. Same layout as `tigris::Matrix` (row-major, rows 64 byte aligned and padded with zeros), so it
+	// 	takes half the memory of the fp32 matrix it was made from.
+	template<class Half>
+	class HalfMatrix{
+		public:
+			static_assert(
+				std::is_same_v<Half, kernels::BF16> || std::is_same_v<Half, kernels::FP16>, "Unknown half type"
+			);
+
+			static constexpr size_t ALIGNMENT = Matrix::ALIGNMENT;
+			static constexpr size_t STRIDE_MULTIPLE = ALIGNMENT / sizeof(Half);
+
+			using Storage = AlignedVector<Half, ALIGNMENT>;
+
+
+			HalfMatrix(size_t mat_width, size_t mat_height)
+				: _width(mat_width),
+				_height(mat_height),
+				_stride(strideForWidth(mat_width)),
+				_data(strideForWidth(mat_width) * mat_height) {}
+
+			// each value is rounded to the nearest representable value
+			explicit HalfMatrix(const Matrix& matrix) : HalfMatrix(matrix.width(), matrix.height()) {
+				for(size_t y = 0; y < this->height(); y+=1){
+					std::ranges::transform(matrix.row(y), this->row(y).begin(), [](float value){ return Half(value); });
+				}
+			}
+
+			~HalfMatrix() = default;
+
+
+			EVO_NODISCARD auto toMatrix() const -> Matrix {
+				auto output = Matrix(this->width(), this->height());
+				for(size_t y = 0; y < this->height(); y+=1){
+					std::ranges::transform(this->row(y), output.row(y).begin(), [](Half value){ return float(value); });
+				}
+				return output;
+			}
+
+
+			EVO_NODISCARD auto width() const -> size_t { return this->_width; }
+			EVO_NODISCARD auto height() const -> size_t { return this->_height; }
+			EVO_NODISCARD auto stride() const -> size_t { return this->_stride; } // in elements
+
+			// the stride of a matrix `mat_width` wide (see `tigris::Matrix::strideForWidth()`)
+			EVO_NODISCARD static auto strideForWidth(size_t mat_width) -> size_t {
+				if(mat_width == 1){ return 1; }
+				return (mat_width + STRIDE_MULTIPLE - 1) / STRIDE_MULTIPLE * STRIDE_MULTIPLE;
+			}
+
+
+			EVO_NODISCARD auto operator[](size_t x, size_t y) const -> const Half& {
+				return this->_data[y * this->stride() + x];
+			}
+			EVO_NODISCARD auto operator[](size_t x, size_t y) -> Half& {
+				return this->_data[y * this->stride() + x];
+			}
+
+
+			// the logical values of a row (without padding)
+			EVO_NODISCARD auto row(size_t y) -> std::span<Half> {
+				return std::span<Half>(&this->_data[y * this->stride()], this->width());
+			}
+			EVO_NODISCARD auto row(size_t y) const -> std::span<const Half> {
+				return std::span<const Half>(&this->_data[y * this->stride()], this->width());
+			}
+
+
+			// includes the padding (see `stride()`)
+			EVO_NODISCARD auto data() -> std::span<Half> { return this->_data; }
+			EVO_NODISCARD auto data() const -> std::span<const Half> { return this->_data; }
+
+
+		private:
+			size_t _width;
+			size_t _height;
+			size_t _stride;
+			Storage _data;
+	};
+
+
+}
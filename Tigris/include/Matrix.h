@@ -10,42 +10,57 @@
 
 #pragma once
 
-#include <mdspan>
+
+#include "./AlignedAllocator.h"
+#include "./MatrixView.h"
+#include "./kernels/gemm.h"
+#include "./kernels/philox.h"
 
 
 namespace tigris{
 
 
+	// Row-major, with each row starting on a 64 byte boundary.
+	// 	Rows are padded with zeros up to `stride()` so SIMD kernels can always load full vectors. Matrices with a
+	// 	width of 1 (column vectors) are left packed as padding each element to a whole cache line would waste 16x
+	// 	the memory. The padding is never part of the logical contents (comparisons, `toString`, etc.).
 	class Matrix{
 		public:
-			Matrix(size_t mat_width, size_t mat_height)
-				: _width(mat_width), _height(mat_height), _data(mat_width * mat_height) {}
+			static constexpr size_t ALIGNMENT = 64;
+			static constexpr size_t STRIDE_MULTIPLE = ALIGNMENT / sizeof(float);
 
-			Matrix(size_t mat_width, size_t mat_height, evo::ArrayProxy<float> mat_data)
-				: _width(mat_width), _height(mat_height), _data(mat_data.begin(), mat_data.end()) {
-				evo::debugAssert(
-					this->width() * this->height() == this->_data.size(), "Dimensions and data do not match"
-				);
+			using Storage = AlignedVector<float, ALIGNMENT>;
+			using View = MatrixView;
+			using ConstView = ConstMatrixView;
+
+
+			Matrix(size_t mat_width, size_t mat_height)
+				: _width(mat_width),
+				_height(mat_height),
+				_stride(strideForWidth(mat_width)),
+				_data(strideForWidth(mat_width) * mat_height) {}
+
+			// `mat_data` is packed (`mat_width` values per row). It is always copied, as the rows are padded and aligned
+			// 	(so this also takes `std::vector<float>`, including temporaries, without any extra copy)
+			Matrix(size_t mat_width, size_t mat_height, evo::ArrayProxy<float> mat_data) : Matrix(mat_width, mat_height) {
+				this->copy_packed(mat_data.data(), mat_data.size());
 			}
 
 			Matrix(size_t mat_width, size_t mat_height, std::initializer_list<float> mat_data)
-				: _width(mat_width), _height(mat_height), _data(mat_data.begin(), mat_data.end()) {
-				evo::debugAssert(
-					this->width() * this->height() == this->_data.size(), "Dimensions and data do not match"
-				);
+				: Matrix(mat_width, mat_height) {
+				this->copy_packed(mat_data.begin(), mat_data.size());
 			}
 
-			Matrix(size_t mat_width, size_t mat_height, std::vector<float>&& mat_data)
-				: _width(mat_width), _height(mat_height), _data(std::move(mat_data)) {
-				evo::debugAssert(
-					this->width() * this->height() == this->_data.size(), "Dimensions and data do not match"
-				);
+			// copies the logical values of `view` (the padding is 0)
+			explicit Matrix(ConstMatrixView view) : Matrix(view.width(), view.height()) {
+				for(size_t y = 0; y < this->height(); y+=1){
+					std::ranges::copy(view.row(y), this->row(y).begin());
+				}
 			}
 
 
 			EVO_NODISCARD static auto identity(size_t dimension) -> Matrix {
 				auto output = Matrix(dimension, dimension);
-				std::memset(output._data.data(), 0, output._data.size() * sizeof(float));
 				for(size_t i = 0; i < dimension; i+=1){
 					output[i, i] = 1.0f;
 				}
@@ -53,14 +68,32 @@ namespace tigris{
 			}
 
 
+			// values in [0, 1), from a stream seeded by `evo::random01()`
 			EVO_NODISCARD static auto random(size_t mat_width, size_t mat_height) -> Matrix {
-				auto data = std::vector<float>();
-				
-				for(size_t i = 0; i < mat_width * mat_height; i+=1){
-					data.emplace_back(float(evo::random01()));
-				}
+				return random(mat_width, mat_height, kernels::RandomStream(kernels::randomSeed(), 0, 0));
+			}
 
-				return Matrix(mat_width, mat_height, std::move(data));
+			// values in [0, 1), reproducible from `stream`
+			EVO_NODISCARD static auto random(size_t mat_width, size_t mat_height, const kernels::RandomStream& stream)
+			-> Matrix {
+				auto output = Matrix(mat_width, mat_height);
+				output.fillRandom(stream);
+				return output;
+			}
+
+			// sets every value to [0, 1), reproducible from `stream` (the padding stays 0)
+			auto fillRandom(const kernels::RandomStream& stream) -> void {
+				kernels::fillUniform01(this->_data, stream);
+
+				if(this->stride() != this->width()){
+					for(size_t y = 0; y < this->height(); y+=1){
+						std::memset(
+							&this->_data[y * this->stride() + this->width()],
+							0,
+							(this->stride() - this->width()) * sizeof(float)
+						);
+					}
+				}
 			}
 
 
@@ -68,19 +101,54 @@ namespace tigris{
 			~Matrix() = default;
 
 
-			EVO_NODISCARD auto operator==(const Matrix&) const -> bool = default;
+			EVO_NODISCARD auto operator==(const Matrix& rhs) const -> bool {
+				if(this->width() != rhs.width() || this->height() != rhs.height()){ return false; }
+
+				for(size_t y = 0; y < this->height(); y+=1){
+					if(std::ranges::equal(this->row(y), rhs.row(y)) == false){ return false; }
+				}
+
+				return true;
+			}
 
 
 
 			EVO_NODISCARD auto width() const -> size_t { return this->_width; }
 			EVO_NODISCARD auto height() const -> size_t { return this->_height; }
+			EVO_NODISCARD auto stride() const -> size_t { return this->_stride; } // in floats
+
+			// the stride of a matrix `mat_width` wide (for laying out matrices in external buffers)
+			EVO_NODISCARD static auto strideForWidth(size_t mat_width) -> size_t {
+				if(mat_width == 1){ return 1; }
+				return (mat_width + STRIDE_MULTIPLE - 1) / STRIDE_MULTIPLE * STRIDE_MULTIPLE;
+			}
+
+
+			EVO_NODISCARD auto view() -> View {
+				return View(this->_data.data(), this->width(), this->height(), this->stride());
+			}
+			EVO_NODISCARD auto view() const -> ConstView {
+				return ConstView(this->_data.data(), this->width(), this->height(), this->stride());
+			}
+
+			operator MatrixView() { return this->view(); }
+			operator ConstMatrixView() const { return this->view(); }
 
 
 			EVO_NODISCARD auto operator[](size_t x, size_t y) const -> const float& {
-				return  std::mdspan(this->_data.data(), this->height(), this->width())[y, x];
+				return this->view()[x, y];
 			}
 			EVO_NODISCARD auto operator[](size_t x, size_t y) -> float& {
-				return  std::mdspan(this->_data.data(), this->height(), this->width())[y, x];
+				return this->view()[x, y];
+			}
+
+
+			// the logical values of a row (without padding)
+			EVO_NODISCARD auto row(size_t y) -> std::span<float> {
+				return std::span<float>(&this->_data[y * this->stride()], this->width());
+			}
+			EVO_NODISCARD auto row(size_t y) const -> std::span<const float> {
+				return std::span<const float>(&this->_data[y * this->stride()], this->width());
 			}
 
 
@@ -90,31 +158,93 @@ namespace tigris{
 				evo::debugAssert(this->width() == rhs.height(), "Invalid dimensions for multiplication");
 
 				auto output = Matrix(rhs.width(), this->height());
-				
-				for(size_t x = 0; x < output.width(); x+=1){
-					for(size_t y = 0; y < output.height(); y+=1){
-						float value = 0.0f;
+				multiplyInto(output, *this, rhs);
+				return output;
+			}
 
-						for(size_t i = 0; i < this->width(); i+=1){
+			auto operator*=(const Matrix& rhs) -> Matrix& {
+				evo::debugAssert(this->width() == rhs.height(), "Invalid dimensions for multiplication");
 
-							const float a = this->operator[](i, y);
-							const float b = rhs[x, i];
+				*this = *this * rhs;
+				return *this;
+			}
 
-							value += a * b;
-						}
 
-						output[x, y] = value;
-					}
-				}
+			// dst = lhs * rhs
+			// 	`dst` must already have the right dimensions and must not be `lhs` or `rhs`
+			static auto multiplyInto(Matrix& dst, const Matrix& lhs, const Matrix& rhs) -> void {
+				evo::debugAssert(lhs.width() == rhs.height(), "Invalid dimensions for multiplication");
+				evo::debugAssert(
+					dst.width() == rhs.width() && dst.height() == lhs.height(), "Invalid dimensions for destination"
+				);
+				evo::debugAssert(&dst != &lhs && &dst != &rhs, "Destination cannot alias an operand");
+
+				// the padding of `rhs` is zero so multiplying it as well only writes zeros into the padding of `dst`,
+				// 	and lets the kernels use whole vectors
+				kernels::gemmParallel(
+					lhs._data.data(), lhs.stride(),
+					rhs._data.data(), rhs.stride(),
+					dst._data.data(), dst.stride(),
+					lhs.height(), rhs.stride(), lhs.width()
+				);
+			}
 
-				return output;
+			// dst = lhs * rhs, for matrices that live somewhere else (see `tigris::MatrixView`)
+			// 	`dst` must already have the right dimensions and must not overlap `lhs` or `rhs`.
+			// 	Only the logical values are read and written, so the padding of the views may hold anything.
+			static auto multiplyInto(MatrixView dst, ConstMatrixView lhs, ConstMatrixView rhs) -> void {
+				evo::debugAssert(lhs.width() == rhs.height(), "Invalid dimensions for multiplication");
+				evo::debugAssert(
+					dst.width() == rhs.width() && dst.height() == lhs.height(), "Invalid dimensions for destination"
+				);
+
+				kernels::gemmParallel(
+					lhs.data(), lhs.stride(),
+					rhs.data(), rhs.stride(),
+					dst.data(), dst.stride(),
+					lhs.height(), rhs.width(), lhs.width()
+				);
 			}
 
-			auto operator*=(const Matrix& rhs) -> Matrix {
-				evo::debugAssert(this->width() == rhs.height(), "Invalid dimensions for multiplication");
 
-				*this = *this * rhs;
-				return *this;
+			// dst[i] = lhs[i] * rhs[i] for every i
+			// 	For many small independent products (e.g. the layers of many networks). Consecutive products with the
+			// 	same dimensions are run as one batch (see `kernels::gemmBatched`), which is much faster than calling
+			// 	`operator*` for each of them. Same requirements as `multiplyInto()` for each product.
+			static auto multiplyBatched(
+				std::span<const MatrixView> dst, std::span<const ConstMatrixView> lhs, std::span<const ConstMatrixView> rhs
+			) -> void {
+				evo::debugAssert(
+					dst.size() == lhs.size() && dst.size() == rhs.size(), "Batches must have the same number of products"
+				);
+
+				auto entries = evo::SmallVector<kernels::GEMMBatchEntry>();
+				entries.reserve(dst.size());
+
+				size_t batch_start = 0;
+				while(batch_start < dst.size()){
+					const size_t m = lhs[batch_start].height();
+					const size_t n = rhs[batch_start].width();
+					const size_t k = lhs[batch_start].width();
+
+					entries.clear();
+					size_t i = batch_start;
+					for(; i < dst.size(); i+=1){
+						if(lhs[i].height() != m || rhs[i].width() != n || lhs[i].width() != k){ break; }
+
+						evo::debugAssert(lhs[i].width() == rhs[i].height(), "Invalid dimensions for multiplication");
+						evo::debugAssert(
+							dst[i].width() == n && dst[i].height() == m, "Invalid dimensions for destination"
+						);
+
+						entries.push_back(kernels::GEMMBatchEntry{
+							lhs[i].data(), lhs[i].stride(), rhs[i].data(), rhs[i].stride(), dst[i].data(), dst[i].stride()
+						});
+					}
+
+					kernels::gemmBatchedParallel(entries, m, n, k);
+					batch_start = i;
+				}
 			}
 			
 
@@ -137,16 +267,31 @@ namespace tigris{
 			}
 
 
+			// includes the padding (see `stride()`)
 			EVO_NODISCARD auto data() -> std::span<float> {
 				return this->_data;
 			}
 
+			EVO_NODISCARD auto data() const -> std::span<const float> {
+				return this->_data;
+			}
+
+
+		private:
+			auto copy_packed(const float* packed_data, size_t size) -> void {
+				evo::debugAssert(this->width() * this->height() == size, "Dimensions and data do not match");
+
+				for(size_t y = 0; y < this->height(); y+=1){
+					std::memcpy(this->row(y).data(), &packed_data[y * this->width()], this->width() * sizeof(float));
+				}
+			}
 
 	
 		private:
 			size_t _width;
 			size_t _height;
-			std::vector<float> _data;
+			size_t _stride;
+			Storage _data;
 	};
 
 	
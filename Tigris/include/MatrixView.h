@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include <mdspan>
+
+#include <Evo.h>
+
+
+namespace tigris{
+
+
+	// Non-owning, row-major view of a matrix in memory managed by someone else (a `tigris::Matrix`, an arena, a
+	// 	memory-mapped file, a mapped Vulkan buffer, ...). `stride` is the distance (in floats) between the starts of
+	// 	two rows and must be at least `width`. Nothing is assumed about the values between `width` and `stride`.
+	// 	Indexed the same way as `tigris::Matrix` (`[x, y]`).
+	template<class T>
+	class BasicMatrixView{
+		public:
+			static_assert(std::is_same_v<std::remove_const_t<T>, float>, "Matrix views are views of floats");
+
+			using Extents = std::dextents<size_t, 2>;
+			using MDSpan = std::mdspan<T, Extents, std::layout_stride>;
+
+
+			BasicMatrixView(T* view_data, size_t view_width, size_t view_height, size_t view_stride)
+				: span(
+					view_data,
+					std::layout_stride::mapping<Extents>(
+						Extents(view_height, view_width), std::array<size_t, 2>{view_stride, 1}
+					)
+				) {
+				evo::debugAssert(view_stride >= view_width, "Stride must be at least the width");
+			}
+
+			// packed (`stride == width`)
+			BasicMatrixView(T* view_data, size_t view_width, size_t view_height)
+				: BasicMatrixView(view_data, view_width, view_height, view_width) {}
+
+			// `MatrixView` -> `ConstMatrixView`
+			template<class U>
+			BasicMatrixView(const BasicMatrixView<U>& rhs) requires(std::is_convertible_v<U*, T*>)
+				: BasicMatrixView(rhs.data(), rhs.width(), rhs.height(), rhs.stride()) {}
+
+			~BasicMatrixView() = default;
+
+
+			EVO_NODISCARD auto width() const -> size_t { return this->span.extent(1); }
+			EVO_NODISCARD auto height() const -> size_t { return this->span.extent(0); }
+			EVO_NODISCARD auto stride() const -> size_t { return this->span.stride(0); } // in floats
+
+
+			EVO_NODISCARD auto operator[](size_t x, size_t y) const -> T& {
+				return this->span[y, x];
+			}
+
+			// the logical values of a row (without padding)
+			EVO_NODISCARD auto row(size_t y) const -> std::span<T> {
+				return std::span<T>(&this->span[y, 0], this->width());
+			}
+
+			// start of the first row
+			EVO_NODISCARD auto data() const -> T* { return this->span.data_handle(); }
+
+			EVO_NODISCARD auto mdspan() const -> const MDSpan& { return this->span; }
+
+
+		private:
+			MDSpan span;
+	};
+
+
+	using MatrixView = BasicMatrixView<float>;
+	using ConstMatrixView = BasicMatrixView<const float>;
+
+
+}
@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./AI.h"
+
+
+namespace tigris{
+
+
+	// The weights of every genome of a population in one contiguous, 64 byte aligned arena, stored in a
+	// 	`kernels::WeightPrecision` (like `tigris::AI`, calculations are always done in fp32).
+	// 	Genome `i` is slot `i` of the arena. Each slot holds the layers of one network laid out like `tigris::Matrix`
+	// 	(or `tigris::HalfMatrix`): row-major, rows padded with zeros to the stride of the weight type, one after the
+	// 	other, so every layer of every genome starts on a cache line. Copying one genome to another is a single
+	// 	`memcpy`, and fp32 genomes can be used through `tigris::AIView`s of their slots.
+	class Population{
+		public:
+			Population(
+				size_t num_genomes,
+				evo::ArrayProxy<size_t> dimentions,
+				kernels::WeightPrecision weight_precision,
+				kernels::Activation layer_activation
+			) : activation(layer_activation), precision(weight_precision) {
+				evo::debugAssert(dimentions.size() >= 2, "must have at least 2 dimentions");
+
+				const size_t weight_size = weight_precision == kernels::WeightPrecision::FP32 ? sizeof(float) : 2;
+				const size_t alignment = Matrix::ALIGNMENT / weight_size;
+
+				this->layers.reserve(dimentions.size() - 1);
+				for(size_t i = 0; i < dimentions.size() - 1; i+=1){
+					const auto layer = Layer(
+						this->genome_size,
+						dimentions[i + 1],
+						dimentions[i],
+						weight_size == sizeof(float)
+							? Matrix::strideForWidth(dimentions[i + 1])
+							: HalfMatrix<kernels::BF16>::strideForWidth(dimentions[i + 1])
+					);
+					this->layers.emplace_back(layer);
+					this->max_layer_stride = std::max(this->max_layer_stride, layer.stride);
+
+					// keeps the next layer (and the next genome) aligned
+					this->genome_size += layer.height * layer.stride;
+					this->genome_size = (this->genome_size + alignment - 1) / alignment * alignment;
+				}
+
+				this->visit_weights([&](auto& weights) -> void {
+					weights.resize(num_genomes * this->genome_size);
+				});
+			}
+
+			~Population() = default;
+
+			// declared so the arenas are moved (not copied) when `tigris::Environment` swaps generations
+			Population(const Population&) = default;
+			Population(Population&&) = default;
+			auto operator=(const Population&) -> Population& = default;
+			auto operator=(Population&&) -> Population& = default;
+
+
+			EVO_NODISCARD auto size() const -> size_t {
+				return this->visit_weights([&](const auto& weights){ return weights.size() / this->genome_size; });
+			}
+			EVO_NODISCARD auto numLayers() const -> size_t { return this->layers.size(); }
+			EVO_NODISCARD auto getPrecision() const -> kernels::WeightPrecision { return this->precision; }
+			EVO_NODISCARD auto getActivation() const -> kernels::Activation { return this->activation; }
+
+			// weights per genome (including padding)
+			EVO_NODISCARD auto genomeSize() const -> size_t { return this->genome_size; }
+
+			EVO_NODISCARD auto numInputs() const -> size_t { return this->layers.front().height; }
+			EVO_NODISCARD auto numOutputs() const -> size_t { return this->layers.back().width; }
+
+			// bytes used by the weights of every genome (including padding)
+			EVO_NODISCARD auto weightBytes() const -> size_t {
+				return this->visit_weights([](const auto& weights){ return weights.size() * sizeof(weights[0]); });
+			}
+
+
+			// Every weight of genome `genome_id` (including padding).
+			// 	`Weight` must be the type of `getPrecision()` (`float`, `kernels::BF16`, or `kernels::FP16`)
+			template<class Weight = float>
+			EVO_NODISCARD auto genome(size_t genome_id) -> std::span<Weight> {
+				evo::debugAssert(genome_id < this->size(), "Genome id out of range");
+				return std::span<Weight>(&get_weights<Weight>(*this)[genome_id * this->genome_size], this->genome_size);
+			}
+			template<class Weight = float>
+			EVO_NODISCARD auto genome(size_t genome_id) const -> std::span<const Weight> {
+				evo::debugAssert(genome_id < this->size(), "Genome id out of range");
+				return std::span<const Weight>(&get_weights<Weight>(*this)[genome_id * this->genome_size], this->genome_size);
+			}
+
+			// only for fp32 populations
+			EVO_NODISCARD auto layer(size_t genome_id, size_t layer_index) -> MatrixView {
+				const Layer& layer = this->layers[layer_index];
+				return MatrixView(&this->genome(genome_id)[layer.offset], layer.width, layer.height, layer.stride);
+			}
+			EVO_NODISCARD auto layer(size_t genome_id, size_t layer_index) const -> ConstMatrixView {
+				const Layer& layer = this->layers[layer_index];
+				return ConstMatrixView(&this->genome(genome_id)[layer.offset], layer.width, layer.height, layer.stride);
+			}
+
+
+			// Network of genome `genome_id`. Valid until the population is destroyed (changing the weights of the genome
+			// 	changes the network). `tigris::AIView` is fp32, so this is only for fp32 populations (see `toAI()`)
+			EVO_NODISCARD auto operator[](size_t genome_id) const -> AIView {
+				evo::debugAssert(
+					this->precision == kernels::WeightPrecision::FP32, "Only fp32 genomes can be viewed (use `toAI()`)"
+				);
+
+				auto layer_views = evo::SmallVector<ConstMatrixView>();
+				layer_views.reserve(this->layers.size());
+				for(size_t i = 0; i < this->layers.size(); i+=1){
+					layer_views.emplace_back(this->layer(genome_id, i));
+				}
+				return AIView(layer_views, this->activation);
+			}
+
+			// Same as `toAI(genome_id).calculate(inputs, workspace)` without making the AI.
+			// 	The padding of the layers is known to be 0, so as in `tigris::AI::calculate()` it is included
+			EVO_NODISCARD auto calculate(size_t genome_id, std::span<const float> inputs, AI::Workspace& workspace) const
+			-> std::span<const float> {
+				evo::debugAssert(inputs.size() == this->numInputs(), "Wrong number of inputs");
+
+				workspace.reserve(this->max_layer_stride);
+
+				const float* layer_input = inputs.data();
+				float* layer_output = workspace.ping.data();
+				float* next_layer_output = workspace.pong.data();
+
+				this->visit_weights([&](const auto& weights) -> void {
+					const auto* genome_weights = &weights[genome_id * this->genome_size];
+
+					for(const Layer& layer : this->layers){
+						kernels::gemv(
+							layer_input,
+							&genome_weights[layer.offset], layer.stride,
+							layer_output,
+							layer.stride, layer.height,
+							this->activation
+						);
+
+						layer_input = layer_output;
+						std::swap(layer_output, next_layer_output);
+					}
+				});
+
+				return std::span<const float>(layer_input, this->numOutputs());
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(size_t genome_id, std::span<const float> inputs) const -> std::span<const float> {
+				static thread_local auto workspace = AI::Workspace();
+				return this->calculate(genome_id, inputs, workspace);
+			}
+
+			// owning copy of genome `genome_id`, stored in the precision of the population
+			EVO_NODISCARD auto toAI(size_t genome_id) const -> AI {
+				if(this->precision == kernels::WeightPrecision::FP32){ return AI(this->operator[](genome_id)); }
+
+				// every reduced precision value is exact in fp32, so widening and rounding back gives the same weights
+				auto matrices = evo::SmallVector<Matrix>();
+				this->visit_weights([&](const auto& weights) -> void {
+					const auto* genome_weights = &weights[genome_id * this->genome_size];
+
+					for(const Layer& layer : this->layers){
+						Matrix& matrix = matrices.emplace_back(layer.width, layer.height);
+						for(size_t y = 0; y < layer.height; y+=1){
+							for(size_t x = 0; x < layer.width; x+=1){
+								matrix[x, y] = float(genome_weights[layer.offset + y * layer.stride + x]);
+							}
+						}
+					}
+				});
+
+				auto layer_views = evo::SmallVector<ConstMatrixView>();
+				for(const Matrix& matrix : matrices){
+					layer_views.emplace_back(matrix.view());
+				}
+				return AI(AIView(layer_views, this->activation)).withPrecision(this->precision);
+			}
+
+			// `ai` must have the dimentions of the population. Its weights are rounded to the precision of the population
+			auto setGenome(size_t genome_id, const AI& ai) -> void {
+				if(ai.getPrecision() != kernels::WeightPrecision::FP32){
+					this->setGenome(genome_id, ai.withPrecision(kernels::WeightPrecision::FP32));
+					return;
+				}
+
+				evo::debugAssert(ai.getMatrices().size() == this->layers.size(), "Dimentions do not match");
+				this->visit_weights([&](auto& weights) -> void {
+					using Weight = std::remove_reference_t<decltype(weights[0])>;
+					Weight* genome_weights = &weights[genome_id * this->genome_size];
+
+					for(size_t i = 0; i < this->layers.size(); i+=1){
+						const Matrix& matrix = ai.getMatrices()[i];
+						const Layer& layer = this->layers[i];
+						evo::debugAssert(
+							matrix.width() == layer.width && matrix.height() == layer.height, "Dimentions do not match"
+						);
+
+						for(size_t y = 0; y < layer.height; y+=1){
+							std::ranges::transform(
+								matrix.row(y), &genome_weights[layer.offset + y * layer.stride], [](float value){
+									return Weight(value);
+								}
+							);
+						}
+					}
+				});
+			}
+
+
+			auto copyGenome(size_t dst_genome_id, size_t src_genome_id) -> void {
+				this->copyGenome(dst_genome_id, *this, src_genome_id);
+			}
+
+			// `src` must have the same dimentions and precision
+			auto copyGenome(size_t dst_genome_id, const Population& src, size_t src_genome_id) -> void {
+				evo::debugAssert(
+					src.genome_size == this->genome_size && src.precision == this->precision, "Dimentions do not match"
+				);
+
+				this->visit_weights([&](auto& weights) -> void {
+					using Weight = std::remove_reference_t<decltype(weights[0])>;
+					std::memcpy(
+						&weights[dst_genome_id * this->genome_size],
+						&get_weights<Weight>(src)[src_genome_id * this->genome_size],
+						this->genome_size * sizeof(Weight)
+					);
+				});
+			}
+
+
+			// Same weights as `tigris::AI::randomize(seed, genome_id)` on an AI of the same dimentions and precision.
+			// 	Only touches genome `genome_id`, so different genomes can be randomized in parallel.
+			auto randomize(size_t genome_id, uint64_t seed) -> void {
+				if(this->precision == kernels::WeightPrecision::FP32){
+					for(size_t i = 0; i < this->layers.size(); i+=1){
+						const MatrixView layer = this->layer(genome_id, i);
+						kernels::fillUniform01(
+							std::span<float>(layer.data(), layer.height() * layer.stride()),
+							kernels::RandomStream(seed, genome_id, uint32_t(i))
+						);
+
+						if(layer.stride() != layer.width()){
+							for(size_t y = 0; y < layer.height(); y+=1){
+								float* padding = &layer.data()[y * layer.stride() + layer.width()];
+								std::memset(padding, 0, (layer.stride() - layer.width()) * sizeof(float));
+							}
+						}
+					}
+					return;
+				}
+
+				// the values are drawn in the layout of a fp32 `tigris::Matrix` (like `AI::randomize()` does before
+				// 	rounding them), so the same stream gives the same weights in every precision
+				static thread_local auto values = AlignedVector<float, Matrix::ALIGNMENT>();
+
+				this->visit_weights([&](auto& weights) -> void {
+					using Weight = std::remove_reference_t<decltype(weights[0])>;
+					Weight* genome_weights = &weights[genome_id * this->genome_size];
+
+					for(size_t i = 0; i < this->layers.size(); i+=1){
+						const Layer& layer = this->layers[i];
+						const size_t fp32_stride = Matrix::strideForWidth(layer.width);
+
+						values.resize(layer.height * fp32_stride);
+						kernels::fillUniform01(values, kernels::RandomStream(seed, genome_id, uint32_t(i)));
+
+						for(size_t y = 0; y < layer.height; y+=1){
+							for(size_t x = 0; x < layer.width; x+=1){
+								genome_weights[layer.offset + y * layer.stride + x] = Weight(values[y * fp32_stride + x]);
+							}
+						}
+					}
+				});
+			}
+
+			// Same as `tigris::AI::mutate()` on genome `genome_id` (reduced precision weights are mutated in fp32 and
+			// 	rounded back)
+			auto mutate(size_t genome_id, float mutation_rate, const kernels::RandomStream& stream) -> void {
+				this->add_to_weights(genome_id, [&](auto&& add) -> void {
+					this->for_each_mutated(mutation_rate, stream, add, uniform_amount);
+				});
+			}
+
+			auto mutate(size_t genome_id, float mutation_rate) -> void {
+				this->mutate(genome_id, mutation_rate, kernels::RandomStream(kernels::randomSeed(), genome_id, 0));
+			}
+
+			// Same as `tigris::AI::mutateGaussian()` on genome `genome_id`
+			auto mutateGaussian(size_t genome_id, float mutation_rate, float sigma, const kernels::RandomStream& stream)
+			-> void {
+				this->add_to_weights(genome_id, [&](auto&& add) -> void {
+					this->for_each_mutated(mutation_rate, stream, add, GaussianAmount(sigma));
+				});
+			}
+
+
+		private:
+			// where a layer is in a genome (in weights)
+			struct Layer{
+				size_t offset;
+				size_t width;
+				size_t height;
+				size_t stride;
+			};
+
+			// only the arena of `precision` is used
+			template<class Func>
+			auto visit_weights(Func&& func) -> std::invoke_result_t<Func&, AlignedVector<float, Matrix::ALIGNMENT>&> {
+				if(this->precision == kernels::WeightPrecision::FP32){ return func(this->weights); }
+				if(this->precision == kernels::WeightPrecision::BF16){ return func(this->bf16_weights); }
+				return func(this->fp16_weights);
+			}
+
+			template<class Func>
+			auto visit_weights(Func&& func) const
+			-> std::invoke_result_t<Func&, const AlignedVector<float, Matrix::ALIGNMENT>&> {
+				if(this->precision == kernels::WeightPrecision::FP32){ return func(this->weights); }
+				if(this->precision == kernels::WeightPrecision::BF16){ return func(this->bf16_weights); }
+				return func(this->fp16_weights);
+			}
+
+			// the arena of `Weight` (`self` is a `Population` or a `const Population`)
+			template<class Weight, class Self>
+			EVO_NODISCARD static auto get_weights(Self& self) -> auto& {
+				if constexpr(std::is_same_v<Weight, float>){
+					evo::debugAssert(self.precision == kernels::WeightPrecision::FP32, "Population is not fp32");
+					return self.weights;
+				}else if constexpr(std::is_same_v<Weight, kernels::BF16>){
+					evo::debugAssert(self.precision == kernels::WeightPrecision::BF16, "Population is not bf16");
+					return self.bf16_weights;
+				}else{
+					static_assert(std::is_same_v<Weight, kernels::FP16>, "Unknown weight type");
+					evo::debugAssert(self.precision == kernels::WeightPrecision::FP16, "Population is not fp16");
+					return self.fp16_weights;
+				}
+			}
+
+			// Calls `func(add)`, where `add(index, amount)` adds `amount` to weight `index` of genome `genome_id`.
+			// 	Reduced precision weights are widened, added to in fp32, and rounded back (like `AI::mutate_weights()`)
+			template<class Func>
+			auto add_to_weights(size_t genome_id, Func&& func) -> void {
+				this->visit_weights([&](auto& weights) -> void {
+					using Weight = std::remove_reference_t<decltype(weights[0])>;
+					Weight* genome_weights = &weights[genome_id * this->genome_size];
+
+					func([&](size_t index, float amount) -> void {
+						genome_weights[index] = Weight(float(genome_weights[index]) + amount);
+					});
+				});
+			}
+
+			// how much a mutation adds to a weight
+			static auto uniform_amount(kernels::MutationSampler& sampler) -> float { return sampler.nextUniform01(); }
+
+			struct GaussianAmount{
+				float sigma;
+
+				auto operator()(kernels::MutationSampler& sampler) const -> float {
+					return sampler.nextNormal() * this->sigma;
+				}
+			};
+
+			// calls `func(index, amount(sampler))` for every mutated weight (`index` is into `genome()`)
+			template<class Func, class AmountFunc>
+			auto for_each_mutated(
+				float mutation_rate, const kernels::RandomStream& stream, Func&& func, AmountFunc&& amount
+			) const -> void {
+				auto sampler = kernels::MutationSampler(1.0f - mutation_rate, stream);
+
+				for(const Layer& layer : this->layers){
+					sampler.forEachMutated(layer.width * layer.height, [&](size_t i) -> void {
+						func(layer.offset + i / layer.width * layer.stride + i % layer.width, amount(sampler));
+					});
+				}
+			}
+
+		private:
+			kernels::Activation activation;
+			kernels::WeightPrecision precision;
+			size_t genome_size = 0;
+			size_t max_layer_stride = 0;
+			evo::SmallVector<Layer> layers{};
+
+			// only the arena for `precision` is used
+			AlignedVector<float, Matrix::ALIGNMENT> weights{};
+			AlignedVector<kernels::BF16, Matrix::ALIGNMENT> bf16_weights{};
+			AlignedVector<kernels::FP16, Matrix::ALIGNMENT> fp16_weights{};
+	};
+
+
+}
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./AI.h"
+#include "./kernels/int8.h"
+
+
+namespace tigris{
+
+
+	// Inference-only int8 copy of a trained `tigris::AI`.
+	// 	Weights are quantized with one scale per output of each layer, and the input of each layer is quantized with
+	// 	one scale per call. Results are close to (but not the same as) the `tigris::AI` it was made from; see
+	// 	`tigris::benchmarks::quantizedAI()` for how often it picks the same move.
+	class QuantizedAI{
+		public:
+			explicit QuantizedAI(const AI& ai) : activation(ai.getActivation()) {
+				if(ai.getPrecision() != kernels::WeightPrecision::FP32){
+					*this = QuantizedAI(ai.withPrecision(kernels::WeightPrecision::FP32));
+					return;
+				}
+
+				this->layers.reserve(ai.getMatrices().size());
+				for(const Matrix& matrix : ai.getMatrices()){
+					this->layers.emplace_back(matrix);
+
+					this->max_padded_rows = std::max(this->max_padded_rows, kernels::int8PaddedRows(matrix.height()));
+					this->max_padded_columns = std::max(
+						this->max_padded_columns, kernels::int8PaddedColumns(matrix.width())
+					);
+				}
+			}
+
+			~QuantizedAI() = default;
+
+
+			struct Workspace{
+				AlignedVector<float, Matrix::ALIGNMENT> output{};
+				AlignedVector<int8_t, Matrix::ALIGNMENT> quantized_input{};
+
+				auto reserve(const QuantizedAI& ai) -> void {
+					if(this->output.size() < ai.max_padded_columns){
+						this->output.resize(ai.max_padded_columns);
+					}
+					if(this->quantized_input.size() < ai.max_padded_rows){
+						this->quantized_input.resize(ai.max_padded_rows);
+					}
+				}
+			};
+
+
+			// The returned span points into `workspace` and is valid until it is used again
+			EVO_NODISCARD auto calculate(std::span<const float> inputs, Workspace& workspace) const
+			-> std::span<const float> {
+				evo::debugAssert(inputs.size() == this->numInputs(), "Wrong number of inputs");
+
+				workspace.reserve(*this);
+
+				std::span<const float> layer_input = inputs;
+
+				for(const Layer& layer : this->layers){
+					// the kernel reads the input in groups of 4, so it is padded with zeros
+					const float input_scale = kernels::quantizeInt8(
+						layer_input.data(), workspace.quantized_input.data(), layer.height
+					);
+					std::memset(
+						&workspace.quantized_input[layer.height], 0, kernels::int8PaddedRows(layer.height) - layer.height
+					);
+
+					kernels::gemvInt8(
+						workspace.quantized_input.data(), input_scale,
+						layer.weights.data(), layer.scales.data(), layer.column_sums.data(),
+						workspace.output.data(),
+						layer.width, layer.height,
+						this->activation
+					);
+
+					layer_input = std::span<const float>(workspace.output.data(), layer.width);
+				}
+
+				return layer_input;
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(std::span<const float> inputs) const -> std::span<const float> {
+				static thread_local auto workspace = Workspace();
+				return this->calculate(inputs, workspace);
+			}
+
+
+			EVO_NODISCARD auto numInputs() const -> size_t { return this->layers.front().height; }
+			EVO_NODISCARD auto numOutputs() const -> size_t { return this->layers.back().width; }
+
+			// bytes used by the weights, scales, and column sums
+			EVO_NODISCARD auto weightBytes() const -> size_t {
+				size_t weight_bytes = 0;
+				for(const Layer& layer : this->layers){
+					weight_bytes += layer.weights.size() + layer.scales.size() * sizeof(float)
+						+ layer.column_sums.size() * sizeof(int32_t);
+				}
+				return weight_bytes;
+			}
+
+
+		private:
+			struct Layer{
+				size_t width;
+				size_t height;
+				AlignedVector<int8_t, Matrix::ALIGNMENT> weights;
+				AlignedVector<float, Matrix::ALIGNMENT> scales;
+				AlignedVector<int32_t, Matrix::ALIGNMENT> column_sums;
+
+				explicit Layer(const Matrix& matrix)
+					: width(matrix.width()),
+					height(matrix.height()),
+					weights(kernels::int8PaddedRows(matrix.height()) * kernels::int8PaddedColumns(matrix.width())),
+					scales(kernels::int8PaddedColumns(matrix.width())),
+					column_sums(kernels::int8PaddedColumns(matrix.width())) {
+					kernels::packInt8Weights(
+						matrix.data().data(), matrix.stride(),
+						this->weights.data(), this->scales.data(), this->column_sums.data(),
+						this->width, this->height
+					);
+				}
+			};
+
+		private:
+			kernels::Activation activation;
+			std::vector<Layer> layers{};
+			size_t max_padded_rows = 0;
+			size_t max_padded_columns = 0;
+	};
+
+
+}
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./AI.h"
+#include "./SparseMatrix.h"
+
+
+namespace tigris{
+
+
+	// Inference-only, magnitude pruned copy of a trained `tigris::AI`.
+	// 	Every layer keeps its largest weights (see `tigris::SparseMatrix`), so the time of a forward pass scales with
+	// 	the number of weights that are left. See `tigris::benchmarks::sparseAI()` for the speedup at each sparsity.
+	class SparseAI{
+		public:
+			// `sparsity` is the fraction of the weights of each layer that are dropped, in [0, 1]
+			SparseAI(const AI& ai, float sparsity) : activation(ai.getActivation()) {
+				if(ai.getPrecision() != kernels::WeightPrecision::FP32){
+					*this = SparseAI(ai.withPrecision(kernels::WeightPrecision::FP32), sparsity);
+					return;
+				}
+
+				this->layers.reserve(ai.getMatrices().size());
+				for(const Matrix& matrix : ai.getMatrices()){
+					this->layers.emplace_back(matrix, sparsity);
+					this->max_layer_width = std::max(this->max_layer_width, matrix.width());
+				}
+			}
+
+			~SparseAI() = default;
+
+
+			// Ping-pong buffers for the outputs of the layers
+			struct Workspace{
+				AlignedVector<float, Matrix::ALIGNMENT> ping{};
+				AlignedVector<float, Matrix::ALIGNMENT> pong{};
+
+				auto reserve(const SparseAI& ai) -> void {
+					if(this->ping.size() < ai.max_layer_width){
+						this->ping.resize(ai.max_layer_width);
+						this->pong.resize(ai.max_layer_width);
+					}
+				}
+			};
+
+
+			// The returned span points into `workspace` and is valid until it is used again
+			EVO_NODISCARD auto calculate(std::span<const float> inputs, Workspace& workspace) const
+			-> std::span<const float> {
+				evo::debugAssert(inputs.size() == this->numInputs(), "Wrong number of inputs");
+
+				workspace.reserve(*this);
+
+				const float* layer_input = inputs.data();
+				float* layer_output = workspace.ping.data();
+				float* next_layer_output = workspace.pong.data();
+
+				for(const SparseMatrix& layer : this->layers){
+					kernels::spmv(
+						layer_input,
+						layer.rowOffsets().data(), layer.columnIndices().data(), layer.values().data(),
+						layer_output,
+						layer.width(),
+						this->activation
+					);
+
+					layer_input = layer_output;
+					std::swap(layer_output, next_layer_output);
+				}
+
+				return std::span<const float>(layer_input, this->numOutputs());
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(std::span<const float> inputs) const -> std::span<const float> {
+				static thread_local auto workspace = Workspace();
+				return this->calculate(inputs, workspace);
+			}
+
+
+			EVO_NODISCARD auto getLayers() const -> evo::ArrayProxy<SparseMatrix> { return this->layers; }
+
+			EVO_NODISCARD auto numInputs() const -> size_t { return this->layers.front().height(); }
+			EVO_NODISCARD auto numOutputs() const -> size_t { return this->layers.back().width(); }
+
+			EVO_NODISCARD auto numNonZeros() const -> size_t {
+				size_t num_non_zeros = 0;
+				for(const SparseMatrix& layer : this->layers){
+					num_non_zeros += layer.numNonZeros();
+				}
+				return num_non_zeros;
+			}
+
+			EVO_NODISCARD auto weightBytes() const -> size_t {
+				size_t weight_bytes = 0;
+				for(const SparseMatrix& layer : this->layers){
+					weight_bytes += layer.weightBytes();
+				}
+				return weight_bytes;
+			}
+
+
+		private:
+			kernels::Activation activation;
+			std::vector<SparseMatrix> layers{};
+			size_t max_layer_width = 0;
+	};
+
+
+}
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./Matrix.h"
+#include "./kernels/sparse.h"
+
+
+namespace tigris{
+
+
+	// Magnitude pruned copy of a `tigris::Matrix` used as the weights of a layer (`x * matrix`).
+	// 	Stored as CSR with one row per column of the matrix (see `kernels/sparse.h`), so each output of the layer is
+	// 	the dot product of one row with the gathered inputs.
+	class SparseMatrix{
+		public:
+			// Keeps the largest (by magnitude) values of `matrix` and drops the rest.
+			// 	`sparsity` is the fraction of the values that are dropped, in [0, 1].
+			SparseMatrix(const Matrix& matrix, float sparsity)
+				: _width(matrix.width()), _height(matrix.height()), row_offsets(matrix.width() + 1) {
+				evo::debugAssert(sparsity >= 0.0f && sparsity <= 1.0f, "Sparsity must be [0-1]");
+
+				const size_t num_values = matrix.width() * matrix.height();
+				const size_t num_dropped = std::min(num_values, size_t(double(sparsity) * double(num_values) + 0.5));
+
+				// every value with a magnitude at or below `threshold` is dropped (ties can drop a few more)
+				float threshold = -1.0f;
+				if(num_dropped > 0){
+					auto magnitudes = std::vector<float>();
+					magnitudes.reserve(num_values);
+					for(size_t y = 0; y < matrix.height(); y+=1){
+						for(float value : matrix.row(y)){
+							magnitudes.emplace_back(std::abs(value));
+						}
+					}
+
+					std::ranges::nth_element(magnitudes, magnitudes.begin() + (num_dropped - 1));
+					threshold = magnitudes[num_dropped - 1];
+				}
+
+				this->column_indices.reserve(num_values - num_dropped);
+				this->_values.reserve(num_values - num_dropped);
+
+				for(size_t x = 0; x < matrix.width(); x+=1){
+					this->row_offsets[x] = uint32_t(this->_values.size());
+
+					for(size_t y = 0; y < matrix.height(); y+=1){
+						const float value = matrix[x, y];
+						if(std::abs(value) <= threshold){ continue; }
+
+						this->column_indices.emplace_back(uint32_t(y));
+						this->_values.emplace_back(value);
+					}
+				}
+				this->row_offsets[matrix.width()] = uint32_t(this->_values.size());
+			}
+
+			~SparseMatrix() = default;
+
+
+			// the dropped values are 0
+			EVO_NODISCARD auto toMatrix() const -> Matrix {
+				auto output = Matrix(this->width(), this->height());
+				for(size_t x = 0; x < this->width(); x+=1){
+					for(uint32_t i = this->row_offsets[x]; i < this->row_offsets[x + 1]; i+=1){
+						output[x, this->column_indices[i]] = this->_values[i];
+					}
+				}
+				return output;
+			}
+
+
+			EVO_NODISCARD auto width() const -> size_t { return this->_width; }
+			EVO_NODISCARD auto height() const -> size_t { return this->_height; }
+
+			EVO_NODISCARD auto numNonZeros() const -> size_t { return this->_values.size(); }
+
+			// fraction of the values that were dropped
+			EVO_NODISCARD auto sparsity() const -> float {
+				return 1.0f - float(this->numNonZeros()) / float(this->width() * this->height());
+			}
+
+
+			EVO_NODISCARD auto rowOffsets() const -> std::span<const uint32_t> { return this->row_offsets; }
+			EVO_NODISCARD auto columnIndices() const -> std::span<const uint32_t> { return this->column_indices; }
+			EVO_NODISCARD auto values() const -> std::span<const float> { return this->_values; }
+
+			// bytes used by the offsets, indices, and values
+			EVO_NODISCARD auto weightBytes() const -> size_t {
+				return this->rowOffsets().size_bytes() + this->columnIndices().size_bytes() + this->values().size_bytes();
+			}
+
+
+		private:
+			size_t _width;
+			size_t _height;
+			std::vector<uint32_t> row_offsets;
+			std::vector<uint32_t> column_indices{};
+			std::vector<float> _values{};
+	};
+
+
+}
@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./AI.h"
+#include "./Population.h"
+#include "./kernels/stacked.h"
+
+
+namespace tigris{
+
+
+	// Inference-only copy of a population of `tigris::AI`s with the same topology and activation.
+	// 	The weights of every `kernels::STACK_LANES` genomes are interleaved (see `kernels/stacked.h`), so one SIMD
+	// 	instruction runs the same step of 16 networks instead of one network having to fill a whole vector by itself.
+	// 	This is the fast way to score a whole generation when the networks are small.
+	class StackedAI{
+		public:
+			// `ais` must all have the same dimentions and activation
+			explicit StackedAI(evo::ArrayProxy<AIView> ais) {
+				evo::debugAssert(ais.empty() == false, "StackedAI needs at least 1 AI");
+
+				this->activation = ais.front().getActivation();
+				this->num_genomes = ais.size();
+				const size_t num_stacks = this->numStacks();
+
+				const evo::ArrayProxy<ConstMatrixView> first_layers = ais.front().getLayers();
+				this->dimentions.emplace_back(first_layers.front().height());
+				for(const ConstMatrixView& layer : first_layers){
+					this->dimentions.emplace_back(layer.width());
+					this->max_layer_width = std::max(this->max_layer_width, layer.width());
+				}
+
+				// genomes past the end of the population are left as zero weights
+				this->layers.resize(first_layers.size());
+				for(size_t i = 0; i < this->layers.size(); i+=1){
+					const size_t k = this->dimentions[i];
+					const size_t n = this->dimentions[i + 1];
+					this->layers[i].resize(num_stacks * n * k * kernels::STACK_LANES);
+				}
+
+				for(size_t genome = 0; genome < this->num_genomes; genome+=1){
+					evo::debugAssert(
+						ais[genome].getActivation() == this->activation, "All stacked AIs must have the same activation"
+					);
+
+					const evo::ArrayProxy<ConstMatrixView> genome_layers = ais[genome].getLayers();
+					evo::debugAssert(
+						genome_layers.size() == this->layers.size(), "All stacked AIs must have the same dimentions"
+					);
+
+					const size_t stack = genome / kernels::STACK_LANES;
+					const size_t lane = genome % kernels::STACK_LANES;
+
+					for(size_t i = 0; i < this->layers.size(); i+=1){
+						const ConstMatrixView& layer = genome_layers[i];
+						const size_t k = this->dimentions[i];
+						const size_t n = this->dimentions[i + 1];
+						evo::debugAssert(
+							layer.height() == k && layer.width() == n, "All stacked AIs must have the same dimentions"
+						);
+
+						float* stack_weights = &this->layers[i][stack * n * k * kernels::STACK_LANES];
+						for(size_t j = 0; j < n; j+=1){
+							for(size_t p = 0; p < k; p+=1){
+								stack_weights[(j * k + p) * kernels::STACK_LANES + lane] = layer[j, p];
+							}
+						}
+					}
+				}
+			}
+
+			// reduced precision AIs are widened to fp32
+			explicit StackedAI(evo::ArrayProxy<AI> ais) : StackedAI(GenomeViews(ais).views) {}
+
+			// reduced precision populations are widened to fp32
+			explicit StackedAI(const Population& population) : StackedAI(GenomeViews(population).views) {}
+
+			~StackedAI() = default;
+
+
+			// Ping-pong buffers for the outputs of the layers of one stack, and the outputs of every genome
+			struct Workspace{
+				AlignedVector<float, Matrix::ALIGNMENT> ping{};
+				AlignedVector<float, Matrix::ALIGNMENT> pong{};
+				AlignedVector<float, Matrix::ALIGNMENT> output{};
+
+				auto reserve(const StackedAI& ai, size_t num_inputs) -> void {
+					const size_t layer_size = num_inputs * ai.max_layer_width * kernels::STACK_LANES;
+					if(this->ping.size() < layer_size){
+						this->ping.resize(layer_size);
+						this->pong.resize(layer_size);
+					}
+
+					const size_t output_size = num_inputs * ai.numOutputs() * ai.numStacks() * kernels::STACK_LANES;
+					if(this->output.size() < output_size){
+						this->output.resize(output_size);
+					}
+				}
+			};
+
+
+			// Runs every input (one per row of `inputs`) through every genome.
+			// 	Element [g, b * numOutputs() + o] of the output is output `o` of genome `g` for row `b` of `inputs`, so
+			// 	the outputs of one input are contiguous across the population. The returned view points into
+			// 	`workspace` and is valid until it is used again
+			EVO_NODISCARD auto calculate(ConstMatrixView inputs, Workspace& workspace) const -> ConstMatrixView {
+				evo::debugAssert(inputs.width() == this->numInputs(), "Wrong number of inputs");
+
+				const size_t num_inputs = inputs.height();
+				const size_t num_outputs = this->numOutputs();
+				const size_t output_stride = this->numStacks() * kernels::STACK_LANES;
+				workspace.reserve(*this, num_inputs);
+
+				for(size_t stack = 0; stack < this->numStacks(); stack+=1){
+					float* layer_output = workspace.ping.data();
+					float* next_layer_output = workspace.pong.data();
+
+					for(size_t i = 0; i < this->layers.size(); i+=1){
+						const size_t k = this->dimentions[i];
+						const size_t n = this->dimentions[i + 1];
+						const float* stack_weights = &this->layers[i][stack * n * k * kernels::STACK_LANES];
+
+						if(i == 0){
+							kernels::stackedGemvShared(
+								inputs.data(), inputs.stride(), stack_weights, layer_output, num_inputs, n, k, this->activation
+							);
+						}else{
+							kernels::stackedGemv(
+								next_layer_output, stack_weights, layer_output, num_inputs, n, k, this->activation
+							);
+						}
+
+						std::swap(layer_output, next_layer_output);
+					}
+
+					// after the last swap the outputs of the stack are in `next_layer_output`
+					for(size_t b = 0; b < num_inputs; b+=1){
+						for(size_t o = 0; o < num_outputs; o+=1){
+							std::copy_n(
+								&next_layer_output[(b * num_outputs + o) * kernels::STACK_LANES],
+								kernels::STACK_LANES,
+								&workspace.output[(b * num_outputs + o) * output_stride + stack * kernels::STACK_LANES]
+							);
+						}
+					}
+				}
+
+				return ConstMatrixView(workspace.output.data(), this->num_genomes, num_inputs * num_outputs, output_stride);
+			}
+
+			// Uses a workspace local to the calling thread
+			EVO_NODISCARD auto calculate(ConstMatrixView inputs) const -> ConstMatrixView {
+				static thread_local auto workspace = Workspace();
+				return this->calculate(inputs, workspace);
+			}
+
+
+			EVO_NODISCARD auto getActivation() const -> kernels::Activation { return this->activation; }
+
+			EVO_NODISCARD auto numGenomes() const -> size_t { return this->num_genomes; }
+			EVO_NODISCARD auto numStacks() const -> size_t {
+				return (this->num_genomes + kernels::STACK_LANES - 1) / kernels::STACK_LANES;
+			}
+
+			EVO_NODISCARD auto numInputs() const -> size_t { return this->dimentions.front(); }
+			EVO_NODISCARD auto numOutputs() const -> size_t { return this->dimentions.back(); }
+
+			// bytes used by the weights (including the empty lanes of the last stack)
+			EVO_NODISCARD auto weightBytes() const -> size_t {
+				size_t weight_bytes = 0;
+				for(const auto& layer : this->layers){
+					weight_bytes += layer.size() * sizeof(float);
+				}
+				return weight_bytes;
+			}
+
+
+		private:
+			// Views of the genomes to stack, for the constructors that delegate to the one from views (the widened
+			// 	copies of reduced precision AIs live as long as the views)
+			struct GenomeViews{
+				explicit GenomeViews(evo::ArrayProxy<AI> ais) {
+					evo::debugAssert(ais.empty() == false, "StackedAI needs at least 1 AI");
+
+					if(ais.front().getPrecision() != kernels::WeightPrecision::FP32){
+						this->fp32_ais.reserve(ais.size());
+						for(const AI& ai : ais){
+							this->fp32_ais.emplace_back(ai.withPrecision(kernels::WeightPrecision::FP32));
+						}
+						ais = this->fp32_ais;
+					}
+
+					this->views.reserve(ais.size());
+					for(const AI& ai : ais){
+						this->views.emplace_back(ai.view());
+					}
+				}
+
+				explicit GenomeViews(const Population& population) {
+					this->views.reserve(population.size());
+
+					if(population.getPrecision() != kernels::WeightPrecision::FP32){
+						this->fp32_ais.reserve(population.size());
+						for(size_t i = 0; i < population.size(); i+=1){
+							this->fp32_ais.emplace_back(population.toAI(i).withPrecision(kernels::WeightPrecision::FP32));
+							this->views.emplace_back(this->fp32_ais.back().view());
+						}
+						return;
+					}
+
+					for(size_t i = 0; i < population.size(); i+=1){
+						this->views.emplace_back(population[i]);
+					}
+				}
+
+				std::vector<AI> fp32_ais{};
+				std::vector<AIView> views{};
+			};
+
+		private:
+			kernels::Activation activation = kernels::Activation::TANH;
+			size_t num_genomes = 0;
+			evo::SmallVector<size_t> dimentions{};
+			size_t max_layer_width = 0;
+
+			// one buffer per layer, stack after stack
+			std::vector<AlignedVector<float, Matrix::ALIGNMENT>> layers{};
+	};
+
+
+}
@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./StaticMatrix.h"
+#include "./AI.h"
+#include "./kernels/cpu.h"
+
+
+namespace tigris{
+
+
+	// `tigris::AI` with the topology known at compile time.
+	// 	The whole forward pass is a single inlined function, so the hidden layers can stay in registers and there
+	// 	are no size checks or indirections. Produces the same results as the `tigris::AI` it was made from.
+	template<size_t... DIMENSIONS>
+	class StaticAI{
+		public:
+			static_assert(sizeof...(DIMENSIONS) >= 2, "must have at least 2 dimentions");
+
+			static constexpr auto DIMS = std::array<size_t, sizeof...(DIMENSIONS)>{DIMENSIONS...};
+			static constexpr size_t NUM_LAYERS = DIMS.size() - 1;
+			static constexpr size_t NUM_INPUTS = DIMS.front();
+			static constexpr size_t NUM_OUTPUTS = DIMS.back();
+			static constexpr size_t MAX_LAYER_WIDTH = std::ranges::max(DIMS);
+
+			template<size_t LAYER>
+			using Layer = StaticMatrix<DIMS[LAYER + 1], DIMS[LAYER]>;
+
+
+		public:
+			StaticAI() = default;
+
+			// reduced precision AIs are widened to fp32
+			explicit StaticAI(const AI& ai) : activation(ai.getActivation()) {
+				if(ai.getPrecision() != kernels::WeightPrecision::FP32){
+					*this = StaticAI(ai.withPrecision(kernels::WeightPrecision::FP32));
+					return;
+				}
+
+				*this = StaticAI(ai.view());
+			}
+
+			explicit StaticAI(const AIView& ai) : activation(ai.getActivation()) {
+				evo::debugAssert(ai.getLayers().size() == NUM_LAYERS, "Number of layers do not match");
+
+				unroll<NUM_LAYERS>([&]<size_t LAYER>(){
+					std::get<LAYER>(this->layers) = Layer<LAYER>(ai.getLayers()[LAYER]);
+				});
+			}
+
+			EVO_NODISCARD static auto random() -> StaticAI {
+				auto output = StaticAI();
+				unroll<NUM_LAYERS>([&]<size_t LAYER>(){
+					std::get<LAYER>(output.layers) = Layer<LAYER>::random();
+				});
+				return output;
+			}
+
+			~StaticAI() = default;
+
+
+			EVO_NODISCARD auto calculate(const std::array<float, NUM_INPUTS>& inputs) const
+			-> std::array<float, NUM_OUTPUTS> {
+				if(kernels::getCPUFeatures().avx2){
+					return this->calculate_avx2(inputs);
+				}else{
+					return this->calculate_layer<0>(inputs);
+				}
+			}
+
+
+			// Same as `tigris::AI::calculateBatch()` (one GEMM per layer for a batch of inputs, one per row).
+			// 	The returned view points into a buffer local to the calling thread and is valid until the next call.
+			EVO_NODISCARD auto calculateBatch(ConstMatrixView inputs) const -> ConstMatrixView {
+				evo::debugAssert(inputs.width() == NUM_INPUTS, "Wrong number of inputs");
+
+				return this->calculate_batch_layers<0>(inputs, batch_buffers(inputs.height()));
+			}
+
+
+			// The sums of the first layer (before its activation) for some inputs (see `tigris::AI::Accumulator`)
+			struct Accumulator{
+				std::array<float, DIMS[1]> values{};
+			};
+
+			EVO_NODISCARD auto makeAccumulator(const std::array<float, NUM_INPUTS>& inputs) const -> Accumulator {
+				const Layer<0>& weights = std::get<0>(this->layers);
+
+				auto accumulator = Accumulator{};
+				for(size_t i = 0; i < NUM_INPUTS; i+=1){
+					const float input = inputs[i];
+					for(size_t x = 0; x < DIMS[1]; x+=1){
+						accumulator.values[x] += input * weights[x, i];
+					}
+				}
+				return accumulator;
+			}
+
+			// Bitplane inputs (see `tigris::AI::calculate(std::span<const uint64_t>)`): only the rows of the set bits
+			// 	are added (with `kernels::bitplaneGemv()`, the rows of the first layer are contiguous)
+			EVO_NODISCARD auto makeAccumulator(std::span<const uint64_t> input_bits) const -> Accumulator {
+				evo::debugAssert(input_bits.size() == (NUM_INPUTS + 63) / 64, "Wrong number of input words");
+				evo::debugAssert(
+					NUM_INPUTS % 64 == 0 || (input_bits.back() >> (NUM_INPUTS % 64)) == 0,
+					"Input bits set past the last input"
+				);
+
+				auto accumulator = Accumulator{};
+				kernels::bitplaneGemv(
+					input_bits,
+					std::get<0>(this->layers).data().data(), DIMS[1],
+					accumulator.values.data(),
+					DIMS[1],
+					kernels::Activation::NONE
+				);
+				return accumulator;
+			}
+
+			// Same as `calculate()` on bitplane inputs as 0 / 1 floats
+			EVO_NODISCARD auto calculate(std::span<const uint64_t> input_bits) const -> std::array<float, NUM_OUTPUTS> {
+				return this->calculate(this->makeAccumulator(input_bits));
+			}
+
+			// input `input_index` changed by `delta`
+			auto updateAccumulator(Accumulator& accumulator, size_t input_index, float delta) const -> void {
+				evo::debugAssert(input_index < NUM_INPUTS, "Input index out of range");
+
+				const Layer<0>& weights = std::get<0>(this->layers);
+				for(size_t x = 0; x < DIMS[1]; x+=1){
+					accumulator.values[x] += delta * weights[x, input_index];
+				}
+			}
+
+			// Same as `calculate()` on the inputs of `accumulator`
+			EVO_NODISCARD auto calculate(const Accumulator& accumulator) const -> std::array<float, NUM_OUTPUTS> {
+				if(kernels::getCPUFeatures().avx2){
+					return this->calculate_from_accumulator_avx2(accumulator);
+				}else{
+					return this->calculate_from_accumulator(accumulator);
+				}
+			}
+
+			// Same as `calculate()` on the inputs of `accumulator` with input `input_index` changed by `delta`
+			// 	(`accumulator` is not changed)
+			EVO_NODISCARD auto calculate(const Accumulator& accumulator, size_t input_index, float delta) const
+			-> std::array<float, NUM_OUTPUTS> {
+				Accumulator child = accumulator;
+				this->updateAccumulator(child, input_index, delta);
+				return this->calculate(child);
+			}
+
+			// Same as `tigris::AI::calculateBatch()` on an accumulator: row `i` is the output for the inputs of
+			// 	`accumulator` with input `input_indices[i]` changed by `delta`.
+			// 	The returned view points into a buffer local to the calling thread and is valid until the next call.
+			EVO_NODISCARD auto calculateBatch(
+				const Accumulator& accumulator, std::span<const size_t> input_indices, float delta
+			) const -> ConstMatrixView {
+				static constexpr size_t WIDTH = DIMS[1];
+
+				const size_t batch_size = input_indices.size();
+				std::array<AlignedVector<float, Matrix::ALIGNMENT>, 2>& buffers = batch_buffers(batch_size);
+
+				const Layer<0>& weights = std::get<0>(this->layers);
+				for(size_t i = 0; i < batch_size; i+=1){
+					evo::debugAssert(input_indices[i] < NUM_INPUTS, "Input index out of range");
+
+					float* first_layer_output = &buffers[0][i * WIDTH];
+					for(size_t x = 0; x < WIDTH; x+=1){
+						first_layer_output[x] = accumulator.values[x] + delta * weights[x, input_indices[i]];
+					}
+				}
+				kernels::activate(this->activation, buffers[0].data(), buffers[0].data(), batch_size * WIDTH);
+
+				return this->calculate_batch_layers<1>(ConstMatrixView(buffers[0].data(), WIDTH, batch_size), buffers);
+			}
+
+
+			auto mutate(float mutation_rate) -> void {
+				evo::debugAssert(mutation_rate >= 0.0f, "Mutation rate must be [0-1]");
+				evo::debugAssert(mutation_rate <= 1.0f, "Mutation rate must be [0-1]");
+
+				unroll<NUM_LAYERS>([&]<size_t LAYER>(){
+					for(float& value : std::get<LAYER>(this->layers).data()){
+						if(mutation_rate > float(evo::random01())){ continue; }
+						value += float(evo::random01());
+					}
+				});
+			}
+
+
+			template<size_t LAYER>
+			EVO_NODISCARD auto getLayer() const -> const Layer<LAYER>& { return std::get<LAYER>(this->layers); }
+
+
+		private:
+			// same code as the generic path, but the layers get inlined into a function compiled for AVX2
+			TIGRIS_TARGET_AVX2
+			auto calculate_avx2(const std::array<float, NUM_INPUTS>& inputs) const -> std::array<float, NUM_OUTPUTS> {
+				return this->calculate_layer<0>(inputs);
+			}
+
+
+			// ping-pong buffers for the outputs of the layers of a batch (layer `i` writes to buffer `i % 2`)
+			static auto batch_buffers(size_t batch_size) -> std::array<AlignedVector<float, Matrix::ALIGNMENT>, 2>& {
+				static thread_local auto buffers = std::array<AlignedVector<float, Matrix::ALIGNMENT>, 2>();
+
+				if(buffers[0].size() < batch_size * MAX_LAYER_WIDTH){
+					buffers[0].resize(batch_size * MAX_LAYER_WIDTH);
+					buffers[1].resize(batch_size * MAX_LAYER_WIDTH);
+				}
+
+				return buffers;
+			}
+
+			// runs the layers from `FIRST_LAYER` on (`layer_input` is the input of `FIRST_LAYER`)
+			template<size_t FIRST_LAYER>
+			auto calculate_batch_layers(
+				ConstMatrixView layer_input, std::array<AlignedVector<float, Matrix::ALIGNMENT>, 2>& buffers
+			) const -> ConstMatrixView {
+				const size_t batch_size = layer_input.height();
+
+				unroll<NUM_LAYERS>([&]<size_t LAYER>(){
+					if constexpr(LAYER >= FIRST_LAYER){
+						static constexpr size_t WIDTH = Layer<LAYER>::width();
+
+						float* layer_output = buffers[LAYER % 2].data();
+
+						kernels::gemm(
+							layer_input.data(), layer_input.stride(),
+							std::get<LAYER>(this->layers).data().data(), WIDTH,
+							layer_output, WIDTH,
+							batch_size, WIDTH, Layer<LAYER>::height()
+						);
+						kernels::activate(this->activation, layer_output, layer_output, batch_size * WIDTH);
+
+						layer_input = ConstMatrixView(layer_output, WIDTH, batch_size);
+					}
+				});
+
+				return layer_input;
+			}
+
+
+			TIGRIS_TARGET_AVX2
+			auto calculate_from_accumulator_avx2(const Accumulator& accumulator) const -> std::array<float, NUM_OUTPUTS> {
+				return this->calculate_from_accumulator(accumulator);
+			}
+
+			TIGRIS_FORCE_INLINE auto calculate_from_accumulator(const Accumulator& accumulator) const
+			-> std::array<float, NUM_OUTPUTS> {
+				auto first_layer_output = accumulator.values;
+				kernels::activate(
+					this->activation, first_layer_output.data(), first_layer_output.data(), first_layer_output.size()
+				);
+
+				if constexpr(NUM_LAYERS == 1){
+					return first_layer_output;
+				}else{
+					return this->calculate_layer<1>(first_layer_output);
+				}
+			}
+
+
+			template<size_t LAYER>
+			TIGRIS_FORCE_INLINE auto calculate_layer(const std::array<float, DIMS[LAYER]>& layer_input) const
+			-> std::array<float, NUM_OUTPUTS> {
+				const Layer<LAYER>& weights = std::get<LAYER>(this->layers);
+
+				auto layer_output = std::array<float, DIMS[LAYER + 1]>{};
+
+				for(size_t i = 0; i < DIMS[LAYER]; i+=1){
+					const float input = layer_input[i];
+					for(size_t x = 0; x < DIMS[LAYER + 1]; x+=1){
+						layer_output[x] += input * weights[x, i];
+					}
+				}
+
+				kernels::activate(this->activation, layer_output.data(), layer_output.data(), layer_output.size());
+
+				if constexpr(LAYER + 1 == NUM_LAYERS){
+					return layer_output;
+				}else{
+					return this->calculate_layer<LAYER + 1>(layer_output);
+				}
+			}
+
+
+			using Layers = decltype(
+				[]<size_t... LAYER>(std::index_sequence<LAYER...>){
+					return std::tuple<Layer<LAYER>...>();
+				}(std::make_index_sequence<NUM_LAYERS>())
+			);
+
+		private:
+			kernels::Activation activation = kernels::Activation::TANH;
+			Layers layers{};
+	};
+
+
+}
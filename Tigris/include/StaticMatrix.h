@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include "./Matrix.h"
+
+
+namespace tigris{
+
+
+	// calls `func.template operator()<I>()` for every I in [0, N), with the loop unrolled at compile time
+	template<size_t N, class Func>
+	inline auto unroll(Func&& func) -> void {
+		[&]<size_t... I>(std::index_sequence<I...>){
+			(func.template operator()<I>(), ...);
+		}(std::make_index_sequence<N>());
+	}
+
+
+	// Matrix with dimensions known at compile time, stored dense in `WIDTH * HEIGHT` floats: row-major with no padding
+	// 	between the rows (unlike `tigris::Matrix`, whose rows are padded to `stride()`)
+	template<size_t WIDTH, size_t HEIGHT>
+	class StaticMatrix{
+		public:
+			constexpr StaticMatrix() = default;
+
+			constexpr StaticMatrix(const std::array<float, WIDTH * HEIGHT>& mat_data) : _data(mat_data) {}
+
+			explicit StaticMatrix(ConstMatrixView matrix) {
+				evo::debugAssert(
+					matrix.width() == WIDTH && matrix.height() == HEIGHT, "Dimensions of matrix do not match"
+				);
+
+				for(size_t y = 0; y < HEIGHT; y+=1){
+					for(size_t x = 0; x < WIDTH; x+=1){
+						this->operator[](x, y) = matrix[x, y];
+					}
+				}
+			}
+
+
+			EVO_NODISCARD static auto random() -> StaticMatrix {
+				auto output = StaticMatrix();
+				for(float& value : output._data){
+					value = float(evo::random01());
+				}
+				return output;
+			}
+
+			~StaticMatrix() = default;
+
+
+			EVO_NODISCARD constexpr auto operator==(const StaticMatrix&) const -> bool = default;
+
+
+			EVO_NODISCARD static consteval auto width() -> size_t { return WIDTH; }
+			EVO_NODISCARD static consteval auto height() -> size_t { return HEIGHT; }
+
+
+			EVO_NODISCARD constexpr auto operator[](size_t x, size_t y) const -> const float& {
+				return this->_data[y * WIDTH + x];
+			}
+			EVO_NODISCARD constexpr auto operator[](size_t x, size_t y) -> float& {
+				return this->_data[y * WIDTH + x];
+			}
+
+
+			template<size_t RHS_WIDTH>
+			EVO_NODISCARD constexpr auto operator*(const StaticMatrix<RHS_WIDTH, WIDTH>& rhs) const
+			-> StaticMatrix<RHS_WIDTH, HEIGHT> {
+				auto output = StaticMatrix<RHS_WIDTH, HEIGHT>();
+
+				for(size_t y = 0; y < HEIGHT; y+=1){
+					unroll<WIDTH>([&]<size_t I>(){
+						const float a = this->operator[](I, y);
+						for(size_t x = 0; x < RHS_WIDTH; x+=1){
+							output[x, y] += a * rhs[x, I];
+						}
+					});
+				}
+
+				return output;
+			}
+
+
+			EVO_NODISCARD constexpr auto data() -> std::span<float, WIDTH * HEIGHT> { return this->_data; }
+			EVO_NODISCARD constexpr auto data() const -> std::span<const float, WIDTH * HEIGHT> { return this->_data; }
+
+
+		private:
+			std::array<float, WIDTH * HEIGHT> _data{};
+	};
+
+
+}
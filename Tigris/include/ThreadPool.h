@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+
+namespace tigris{
+
+
+	// Fixed set of worker threads that run `parallelFor` jobs.
+	// 	Calls to `parallelFor` from inside a task (or while another thread's job is running) run serially on the
+	// 	calling thread, so nesting parallel code (for example a parallel GEMM inside parallel games) never creates
+	// 	more threads than there are cores.
+	class ThreadPool{
+		public:
+			ThreadPool(size_t num_workers);
+			~ThreadPool();
+
+			ThreadPool(const ThreadPool&) = delete;
+			auto operator=(const ThreadPool&) = delete;
+
+
+			// shared pool with one worker per hardware thread (minus the calling thread)
+			EVO_NODISCARD static auto get() -> ThreadPool&;
+
+
+			// Calls `func(task_index)` for each task in [0, num_tasks). The calling thread also runs tasks.
+			// 	Returns once all tasks are done
+			auto parallelFor(size_t num_tasks, const std::function<void(size_t)>& func) -> void;
+
+			// Same as `parallelFor`, but if the workers can not be used (called from inside a task, or another
+			// 	thread's job is running) it returns false without calling `func` instead of running it serially
+			EVO_NODISCARD auto tryParallelFor(size_t num_tasks, const std::function<void(size_t)>& func) -> bool;
+
+
+			// workers + the calling thread
+			EVO_NODISCARD auto numThreads() const -> size_t { return this->workers.size() + 1; }
+
+			EVO_NODISCARD static auto isInsideTask() -> bool { return is_inside_task; }
+
+
+		private:
+			auto worker_loop() -> void;
+			auto run_tasks() -> void;
+
+			struct Job{
+				const std::function<void(size_t)>* func = nullptr;
+				size_t num_tasks = 0;
+				std::atomic<size_t> next_task = 0;
+				std::atomic<size_t> num_remaining = 0;
+			};
+	
+		private:
+			std::vector<std::thread> workers{};
+
+			std::mutex submit_mutex{}; // only one job runs at a time
+
+			std::mutex mutex{};
+			std::condition_variable work_condition{};
+			std::condition_variable done_condition{};
+			uint64_t generation = 0;
+			size_t num_active_workers = 0;
+			bool is_stopping = false;
+
+			Job job{};
+
+			static thread_local bool is_inside_task;
+	};
+
+	
+}
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+
+namespace tigris::benchmarks{
+
+	// Each benchmark prints the timings of an optimized path against the code it replaces.
+	// 	The results of the optimized paths are checked by the tests (`Tigris/tests/`), not here.
+
+
+	// Runs the benchmark called `name` (the name of its function, like "gemm"), or all of them for "all".
+	// 	Returns false if there is no benchmark called `name`
+	auto run(std::string_view name) -> bool;
+
+
+	// kernels
+	auto gemm() -> void;
+	auto gemmParallel() -> void;
+	auto gemmBatched() -> void;
+	auto activations() -> void;
+
+	// inference
+	auto aiCalculate() -> void;
+	auto calculateBatch() -> void;
+	auto policyHead() -> void;
+	auto accumulator() -> void;
+	auto bitplanes() -> void;
+	auto compiledAI() -> void;
+	auto stackedAI() -> void;
+	auto weightPrecision() -> void;
+	auto quantizedAI() -> void;
+	auto sparseAI() -> void;
+
+	// population
+	auto populationArena() -> void;
+	auto mutation() -> void;
+	auto normalMutation() -> void;
+	auto populationInit() -> void;
+
+	// games
+	auto evaluationCache() -> void;
+	auto moveTable() -> void;
+
+
+}
@@ -42,6 +42,36 @@ namespace tigris::connect_4{
 			EVO_NODISCARD auto getGameStatus() const -> GameStatus;
 
 
+			// space (row, collumn) is index `row * 7 + collumn`, row 0 is the bottom
+			static constexpr size_t AI_DATA_SIZE = 42;
+			EVO_NODISCARD auto getAIData() const -> std::vector<float>;
+			auto getAIData(std::span<float> output) const -> void; // output.size() must be AI_DATA_SIZE
+
+			// From the view of `player` (the player to move): its pieces are 1 and the other player's are -1.
+			// 	For policy heads (see `tigris::pickMove()`), so the same network can play both X and O
+			auto getAIData(std::span<float> output, Space player) const -> void;
+
+
+			// One-hot occupancy planes from the view of `player`: bit `i` is set if space `i` (see `AI_DATA_SIZE`) has a
+			// 	piece of `player` and bit `42 + i` if it has a piece of the other player.
+			// 	For the bitplane inputs of `tigris::AI` (see `kernels/bitplane.h`)
+			static constexpr size_t BITPLANE_SIZE = 84;
+			using Bitplanes = std::array<uint64_t, (BITPLANE_SIZE + 63) / 64>;
+			EVO_NODISCARD auto getBitplanes(Space player) const -> Bitplanes;
+
+			// the same planes as 0 / 1 floats (for networks that take dense inputs)
+			auto getBitplaneAIData(std::span<float> output, Space player) const -> void; // size must be BITPLANE_SIZE
+
+
+			// one move per collumn (a move is legal if the collumn is not full)
+			static constexpr size_t NUM_MOVES = 7;
+			EVO_NODISCARD auto getLegalMoves() const -> std::array<bool, NUM_MOVES>;
+
+
+			// Unique key of the board (49 bits), for `tigris::EvaluationCache`.
+			// 	7 bits per collumn: a bit per piece of X, from the bottom, and a 1 above the top piece
+			EVO_NODISCARD auto getKey() const -> uint64_t;
+
 			EVO_NODISCARD auto toString() const -> std::string;
 
 
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+
+namespace tigris{
+
+	inline auto sigmoid(float value) -> float {
+		return 1.0f / (1.0f + std::exp(-value));
+	}
+
+}
+
+
+namespace tigris::kernels{
+
+
+	enum class Activation{
+		NONE,
+		TANH,
+		SIGMOID,
+		FAST_TANH,    // `fastTanh()`
+		FAST_SIGMOID, // `fastSigmoid()`
+	};
+
+
+	// tanh(x) ~= x * P(x^2) / Q(x^2) (degree 13 / 6), with x clamped to where tanh rounds to +/-1 in fp32.
+	// 	Max absolute error compared to `std::tanh` is below 1e-6 (checked by `Tigris/tests/kernels.cpp`).
+	EVO_NODISCARD inline auto fastTanh(float value) -> float {
+		const float x = std::clamp(value, -7.90531110763549805f, 7.90531110763549805f);
+		const float x2 = x * x;
+
+		float p = -2.76076847742355e-16f;
+		p = p * x2 + 2.00018790482477e-13f;
+		p = p * x2 - 8.60467152213735e-11f;
+		p = p * x2 + 5.12229709037114e-08f;
+		p = p * x2 + 1.48572235717979e-05f;
+		p = p * x2 + 6.37261928875436e-04f;
+		p = p * x2 + 4.89352455891786e-03f;
+
+		float q = 1.19825839466702e-06f;
+		q = q * x2 + 1.18534705686654e-04f;
+		q = q * x2 + 2.26843463243900e-03f;
+		q = q * x2 + 4.89352518554385e-03f;
+
+		return x * p / q;
+	}
+
+	// sigmoid(x) = 0.5 + 0.5 * tanh(x / 2)
+	// 	Max absolute error is below 1e-6. The relative error grows for large negative inputs (as sigmoid goes to 0).
+	EVO_NODISCARD inline auto fastSigmoid(float value) -> float {
+		return 0.5f + 0.5f * fastTanh(0.5f * value);
+	}
+
+
+	// SIMD versions of `fastTanh()` and `fastSigmoid()` (same error bound). `input` and `output` may alias
+	auto fastTanh(const float* input, float* output, size_t count) -> void;
+	auto fastSigmoid(const float* input, float* output, size_t count) -> void;
+
+
+	EVO_NODISCARD inline auto activate(Activation activation, float value) -> float {
+		switch(activation){
+			case Activation::NONE:         return value;
+			case Activation::TANH:         return std::tanh(value);
+			case Activation::SIGMOID:      return sigmoid(value);
+			case Activation::FAST_TANH:    return fastTanh(value);
+			case Activation::FAST_SIGMOID: return fastSigmoid(value);
+		}
+
+		evo::debugFatalBreak("Unknown activation");
+		return value;
+	}
+
+
+	// `input` and `output` may alias
+	inline auto activate(Activation activation, const float* input, float* output, size_t count) -> void {
+		switch(activation){
+			case Activation::NONE: {
+				if(input != output){ std::memmove(output, input, count * sizeof(float)); }
+			} break;
+
+			case Activation::TANH: {
+				for(size_t i = 0; i < count; i+=1){
+					output[i] = std::tanh(input[i]);
+				}
+			} break;
+
+			case Activation::SIGMOID: {
+				for(size_t i = 0; i < count; i+=1){
+					output[i] = sigmoid(input[i]);
+				}
+			} break;
+
+			case Activation::FAST_TANH: {
+				fastTanh(input, output, count);
+			} break;
+
+			case Activation::FAST_SIGMOID: {
+				fastSigmoid(input, output, count);
+			} break;
+		}
+	}
+
+
+}
@@ -0,0 +1,41 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include "./activation.h"
+
+
+namespace tigris::kernels{
+
+	// Bitplane inputs: inputs that are all 0 or 1 (like the one-hot occupancy planes of a board), stored as bits.
+	// 	Input `i` is bit `i % 64` of `bits[i / 64]`.
+
+
+	// y[1 x n] = activation(x[1 x k] * w[k x n]) for a bitplane `x`: the sum of the rows of `w` (`w_stride` apart) of
+	// 	the set bits, with no multiplications. The time depends on the number of set bits rather than `k`.
+	// 	`bits` must not have bits set past the last row of `w`
+	auto bitplaneGemv(
+		std::span<const uint64_t> bits,
+		const float* w, size_t w_stride,
+		float* y,
+		size_t n,
+		Activation activation
+	) -> void;
+
+
+	// Name of the implementation selected for this CPU ("avx512", "avx2", or "scalar")
+	EVO_NODISCARD auto bitplaneImplementationName() -> std::string_view;
+
+
+}
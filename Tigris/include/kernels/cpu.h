@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+
+// Marks a function as compiled for a specific instruction set so it can live in the same translation unit as the
+// 	generic code. MSVC allows intrinsics everywhere, so it needs nothing.
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define TIGRIS_TARGET(isa)
+#else
+	#define TIGRIS_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define TIGRIS_FORCE_INLINE __forceinline
+#else
+	#define TIGRIS_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+#define TIGRIS_TARGET_AVX2 TIGRIS_TARGET("avx2,fma,f16c")
+#define TIGRIS_TARGET_AVX512 TIGRIS_TARGET("avx512f,avx512vl,avx512bw,avx512dq,avx2,fma,f16c")
+#define TIGRIS_TARGET_AVX512_VNNI TIGRIS_TARGET("avx512f,avx512vl,avx512bw,avx512dq,avx512vnni,avx2,fma,f16c")
+
+
+namespace tigris::kernels{
+
+
+	struct CPUFeatures{
+		bool avx2       = false; // also requires FMA and F16C
+		bool avx512f    = false; // also requires AVX512VL/BW/DQ
+		bool avx512vnni = false; // also requires `avx512f`
+	};
+
+	// detected once, on first call
+	EVO_NODISCARD auto getCPUFeatures() -> const CPUFeatures&;
+
+	
+}
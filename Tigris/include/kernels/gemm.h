@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include "./activation.h"
+#include "./half.h"
+
+
+namespace tigris::kernels{
+
+	// All matrices are row-major. `*_stride` is the distance (in floats) between the starts of two rows.
+	//
+	// Tolerance:
+	// 	The kernels accumulate with FMA and in a different order than the naive triple loop, so each element of `c`
+	// 	may differ from the naive result by up to `k * FLT_EPSILON * sum_i(|a[y, i]| * |b[i, x]|)`.
+	// 	For the layer sizes used by Tigris (k <= 128, weights in [0, 1)) this is well below 1e-5 relative error.
+
+
+	// c[m x n] = a[m x k] * b[k x n]
+	// 	`c` must not alias `a` or `b`
+	auto gemm(
+		const float* a, size_t a_stride,
+		const float* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void;
+
+
+	// `b` stored in reduced precision. Each element is widened to fp32 when it is loaded and accumulation is done in
+	// 	fp32, so the only additional error is the rounding of `b` itself.
+	auto gemm(
+		const float* a, size_t a_stride,
+		const BF16* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void;
+
+	auto gemm(
+		const float* a, size_t a_stride,
+		const FP16* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void;
+
+
+	// Same as `gemm`, but splits `c` into tiles that are run on `ThreadPool::get()` when the product is big enough to
+	// 	be worth it. Runs serially when called from inside a thread pool task, so it can be used from code that is
+	// 	already parallel without oversubscribing the machine.
+	auto gemmParallel(
+		const float* a, size_t a_stride,
+		const float* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void;
+
+	// Smallest `m * n * k` that `gemmParallel` runs in parallel (`SIZE_MAX` if it never does).
+	// 	`DEFAULT_PARALLEL_GEMM_THRESHOLD` until `calibrateParallelGEMM()` has measured it on this machine.
+	EVO_NODISCARD auto parallelGEMMThreshold() -> size_t;
+
+	static constexpr size_t DEFAULT_PARALLEL_GEMM_THRESHOLD = 128 * 128 * 128;
+
+	// Measures `parallelGEMMThreshold()` on this machine (takes tens of milliseconds), so call it at startup while
+	// 	nothing else is running. If another thread uses `ThreadPool::get()` during the measurement, the timings would
+	// 	be wrong, so the threshold is left as it was and it returns false.
+	auto calibrateParallelGEMM() -> bool;
+
+
+	// One independent product of a batch: c = a * b
+	struct GEMMBatchEntry{
+		const float* a;
+		size_t a_stride;
+		const float* b;
+		size_t b_stride;
+		float* c;
+		size_t c_stride;
+	};
+
+	// Runs every product of `batch` (all of them `c[m x n] = a[m x k] * b[k x n]`).
+	// 	Made for many tiny products: the implementation is only selected once for the whole batch, and products that
+	// 	are too narrow to fill a SIMD register (`n == 1`) are interleaved 4 at a time so their dot products are
+	// 	reduced together. `c` of an entry must not alias `a` or `b` of any entry.
+	auto gemmBatched(std::span<const GEMMBatchEntry> batch, size_t m, size_t n, size_t k) -> void;
+
+	// Same as `gemmBatched`, but splits the batch over `ThreadPool::get()` when it is big enough to be worth it
+	// 	(see `gemmParallel`)
+	auto gemmBatchedParallel(std::span<const GEMMBatchEntry> batch, size_t m, size_t n, size_t k) -> void;
+
+
+	// y[1 x n] = activation(x[1 x k] * w[k x n])
+	// 	The outputs are calculated in blocks of 64 columns. The sums of a block are stored to a small buffer on the stack
+	// 	(which stays in L1) and the activation is applied from there as the block is written to `y`, so `y` is only
+	// 	written once.
+	// 	`y` must not alias `x` or `w`
+	auto gemv(
+		const float* x,
+		const float* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void;
+
+	// `w` stored in reduced precision (see the reduced precision `gemm`)
+	auto gemv(
+		const float* x,
+		const BF16* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void;
+
+	auto gemv(
+		const float* x,
+		const FP16* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void;
+
+
+	// Naive triple loop. Used as the reference when checking the optimized kernels.
+	auto gemmReference(
+		const float* a, size_t a_stride,
+		const float* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void;
+
+
+	// Name of the implementation selected for this CPU ("avx512", "avx2", or "scalar")
+	EVO_NODISCARD auto gemmImplementationName() -> std::string_view;
+
+
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+
+namespace tigris::kernels{
+
+
+	// bfloat16 (top 16 bits of an IEEE float)
+	struct BF16{
+		uint16_t bits = 0;
+
+		BF16() = default;
+		explicit BF16(float value) : bits(from_float(value)) {}
+
+		EVO_NODISCARD explicit operator float() const {
+			return std::bit_cast<float>(uint32_t(this->bits) << 16);
+		}
+
+		EVO_NODISCARD auto operator==(const BF16&) const -> bool = default;
+
+		private:
+			// round to nearest even
+			EVO_NODISCARD static auto from_float(float value) -> uint16_t {
+				const uint32_t float_bits = std::bit_cast<uint32_t>(value);
+
+				if((float_bits & 0x7FFF'FFFF) > 0x7F80'0000){ // NaN (keep it quiet)
+					return uint16_t((float_bits >> 16) | 0x0040);
+				}
+
+				const uint32_t rounding_bias = 0x7FFF + ((float_bits >> 16) & 1);
+				return uint16_t((float_bits + rounding_bias) >> 16);
+			}
+	};
+
+
+	// IEEE 754 half precision
+	struct FP16{
+		uint16_t bits = 0;
+
+		FP16() = default;
+		explicit FP16(float value) : bits(from_float(value)) {}
+
+		EVO_NODISCARD explicit operator float() const {
+			const uint32_t sign = uint32_t(this->bits & 0x8000) << 16;
+			const uint32_t exponent = (this->bits >> 10) & 0x1F;
+			const uint32_t mantissa = this->bits & 0x03FF;
+
+			if(exponent == 0x1F){ // inf / NaN
+				return std::bit_cast<float>(sign | 0x7F80'0000 | (mantissa << 13));
+			}
+
+			if(exponent == 0){
+				if(mantissa == 0){ return std::bit_cast<float>(sign); }
+
+				// subnormal
+				const float magnitude = float(mantissa) * 0x1p-24f;
+				return sign != 0 ? -magnitude : magnitude;
+			}
+
+			return std::bit_cast<float>(sign | ((exponent + (127 - 15)) << 23) | (mantissa << 13));
+		}
+
+		EVO_NODISCARD auto operator==(const FP16&) const -> bool = default;
+
+		private:
+			// round to nearest even
+			EVO_NODISCARD static auto from_float(float value) -> uint16_t {
+				const uint32_t float_bits = std::bit_cast<uint32_t>(value);
+				const uint16_t sign = uint16_t((float_bits >> 16) & 0x8000);
+				const uint32_t abs_bits = float_bits & 0x7FFF'FFFF;
+
+				if(abs_bits > 0x7F80'0000){ return uint16_t(sign | 0x7E00); } // NaN
+				if(abs_bits >= 0x4780'0000){ return uint16_t(sign | 0x7C00); } // overflows to inf
+
+				if(abs_bits < 0x3880'0000){ // subnormal (or zero)
+					const float magnitude = std::bit_cast<float>(abs_bits);
+					return uint16_t(sign | uint16_t(std::nearbyint(magnitude * 0x1p24f)));
+				}
+
+				const uint32_t rounding_bias = 0x0FFF + ((abs_bits >> 13) & 1);
+				const uint32_t rebiased = abs_bits - ((127 - 15) << 23) + rounding_bias;
+				return uint16_t(sign | (rebiased >> 13));
+			}
+	};
+
+
+	enum class WeightPrecision{
+		FP32,
+		BF16,
+		FP16,
+	};
+
+
+}
@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include "./activation.h"
+
+
+namespace tigris::kernels{
+
+	// Symmetric int8 quantization: `value ~= q * scale` with q in [-127, 127] (-128 is never used).
+	//
+	// Packed weight layout:
+	// 	`w[k x n]` is split into blocks of `INT8_BLOCK_COLUMNS` columns, and each block is stored as groups of
+	// 	`INT8_GROUP_SIZE` consecutive rows, column by column:
+	// 		offset(p, j) = ((j / 16 * k_groups + p / 4) * 16 + j % 16) * 4 + p % 4
+	// 	so one group of a block is 64 contiguous bytes (one 4-way dot product for each of the 16 columns).
+	// 	`n` is padded to a multiple of 16 and `k` to a multiple of 4 (with zeros).
+
+	inline constexpr size_t INT8_BLOCK_COLUMNS = 16;
+	inline constexpr size_t INT8_GROUP_SIZE = 4;
+
+	EVO_NODISCARD constexpr auto int8PaddedColumns(size_t n) -> size_t {
+		return (n + INT8_BLOCK_COLUMNS - 1) / INT8_BLOCK_COLUMNS * INT8_BLOCK_COLUMNS;
+	}
+
+	EVO_NODISCARD constexpr auto int8PaddedRows(size_t k) -> size_t {
+		return (k + INT8_GROUP_SIZE - 1) / INT8_GROUP_SIZE * INT8_GROUP_SIZE;
+	}
+
+
+	// Quantizes `count` values with a single scale (the returned value, `max(|input|) / 127`)
+	auto quantizeInt8(const float* input, int8_t* output, size_t count) -> float;
+
+
+	// Quantizes the fp32 `w[k x n]` (row stride `w_stride`) into `packed` with one scale per column (output).
+	// 	`packed` must hold `int8PaddedRows(k) * int8PaddedColumns(n)` values, `scales` and `column_sums`
+	// 	`int8PaddedColumns(n)` values. `column_sums` is the sum of the quantized values of each column, used by
+	// 	kernels that work with unsigned inputs.
+	auto packInt8Weights(
+		const float* w, size_t w_stride,
+		int8_t* packed, float* scales, int32_t* column_sums,
+		size_t n, size_t k
+	) -> void;
+
+
+	// y[1 x n] = activation((x[1 x k] * x_scale) * (w[k x n] * w_scales))
+	// 	`w` is packed by `packInt8Weights()` and `x` must be padded with zeros up to `int8PaddedRows(k)`.
+	// 	The dot products are exact (int32) so every implementation produces the same result.
+	auto gemvInt8(
+		const int8_t* x, float x_scale,
+		const int8_t* w, const float* w_scales, const int32_t* w_column_sums,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void;
+
+
+	// Name of the implementation selected for this CPU ("avx512-vnni", "avx2", or "scalar")
+	EVO_NODISCARD auto int8ImplementationName() -> std::string_view;
+
+
+}
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include "./philox.h"
+
+
+namespace tigris::kernels{
+
+
+	// Picks weights to mutate, each one independently with probability `probability` (a Bernoulli trial per weight).
+	// 	Instead of one trial per weight it draws the gap to the next picked weight from the geometric distribution
+	// 	(inverse transform: floor(log(u) / log(1 - p))), which gives the same distribution of picked weights. So the
+	// 	cost scales with the number of weights that are mutated, not with the size of the network.
+	class MutationSampler{
+		public:
+			MutationSampler(float probability, const RandomStream& stream)
+				: random(stream),
+				normal_random(RandomStream(stream.seed, stream.id, stream.sub_id + 1)),
+				inverse_log_keep(probability < 1.0f ? float(1.0 / std::log1p(-double(probability))) : 0.0f),
+				never(probability <= 0.0f) {
+				evo::debugAssert(probability >= 0.0f, "Probability must be [0-1]");
+				evo::debugAssert(probability <= 1.0f, "Probability must be [0-1]");
+			}
+
+			~MutationSampler() = default;
+
+
+			// Calls `func(i)` for every picked index `i` in [0, size), in ascending order
+			template<class Func>
+			auto forEachMutated(size_t size, Func&& func) -> void {
+				if(this->never){ return; }
+
+				for(size_t i = this->next_gap(); i < size; i += this->next_gap() + 1){
+					func(i);
+				}
+			}
+
+			// the next value of the random stream (uniform in [0, 1)), for the amount of a mutation
+			EVO_NODISCARD auto nextUniform01() -> float { return this->random.next(); }
+
+			// standard normal value (from sub-stream `sub_id + 1` of the stream), for Gaussian mutations
+			EVO_NODISCARD auto nextNormal() -> float { return this->normal_random.next(); }
+
+
+		private:
+			// number of weights skipped before the next picked one
+			EVO_NODISCARD auto next_gap() -> size_t {
+				// 1 - u is in (0, 1] so the log is finite
+				const float gap = std::floor(std::log(1.0f - this->random.next()) * this->inverse_log_keep);
+
+				// very small rates can give gaps larger than any network
+				if(gap >= 0x1p62f){ return size_t(1) << 62; }
+				return size_t(gap);
+			}
+
+		private:
+			RandomBuffer random;
+			NormalRandomBuffer normal_random;
+			float inverse_log_keep; // 1 / log(1 - probability) (0 if every weight is picked)
+			bool never;
+	};
+
+
+}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+
+namespace tigris::kernels{
+
+
+	// An independent stream of random numbers.
+	// 	Every (seed, id, sub_id) is a different stream, and a stream always produces the same values (on every CPU
+	// 	and no matter how the work is split between threads). For weights: id is the genome, sub_id is the layer.
+	struct RandomStream{
+		uint64_t seed;
+		uint64_t id;
+		uint32_t sub_id;
+	};
+
+
+	// 64 bit seed drawn from `evo::random01()`
+	EVO_NODISCARD inline auto randomSeed() -> uint64_t {
+		const uint64_t high = uint64_t(evo::random01() * 0x1p32);
+		const uint64_t low = uint64_t(evo::random01() * 0x1p32);
+		return (high << 32) | low;
+	}
+
+
+	// Philox4x32-10 (Salmon et al. 2011, "Parallel Random Numbers: As Easy as 1, 2, 3").
+	// 	A bijection of `counter` keyed by `key`, so every counter gives 4 independent random words.
+	EVO_NODISCARD inline auto philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key)
+	-> std::array<uint32_t, 4> {
+		for(size_t round = 0; round < 10; round+=1){
+			const uint64_t product_0 = uint64_t(0xD251'1F53) * counter[0];
+			const uint64_t product_1 = uint64_t(0xCD9E'8D57) * counter[2];
+
+			counter = std::array<uint32_t, 4>{
+				uint32_t(product_1 >> 32) ^ counter[1] ^ key[0],
+				uint32_t(product_1),
+				uint32_t(product_0 >> 32) ^ counter[3] ^ key[1],
+				uint32_t(product_0),
+			};
+
+			key[0] += 0x9E37'79B9;
+			key[1] += 0xBB67'AE85;
+		}
+
+		return counter;
+	}
+
+
+	// Values are generated in chunks of 64: 16 consecutive counters, with word `w` of counter `c` going to index
+	// 	`w * 16 + c % 16` of the chunk. This is the order the SIMD implementations produce them in.
+	inline constexpr size_t PHILOX_CHUNK_SIZE = 64;
+
+
+	// Fills `output` with uniform values in [0, 1) (24 random bits each) from `stream`
+	auto fillUniform01(std::span<float> output, const RandomStream& stream) -> void;
+
+	// Same, starting at chunk `first_chunk` of the stream (value `first_chunk * PHILOX_CHUNK_SIZE`)
+	auto fillUniform01(std::span<float> output, const RandomStream& stream, size_t first_chunk) -> void;
+
+
+	// Fills `output` with standard normal values (mean 0, variance 1) from `stream`.
+	// 	Box-Muller on the uniform values of each chunk: the pair (u[i], u[i + 32]) of a chunk gives 2 normal values.
+	// 	The SIMD implementations use polynomial approximations of log / sin / cos (within a few ulp of `std::`), so
+	// 	values can differ in the last bits between CPUs.
+	auto fillNormal(std::span<float> output, const RandomStream& stream) -> void;
+
+	// Same, starting at chunk `first_chunk` of the stream (value `first_chunk * PHILOX_CHUNK_SIZE`)
+	auto fillNormal(std::span<float> output, const RandomStream& stream, size_t first_chunk) -> void;
+
+
+	enum class Distribution{
+		UNIFORM_01, // uniform in [0, 1)
+		NORMAL,     // standard normal
+	};
+
+
+	// Hands out the values of a stream one at a time (in the order `fillUniform01` / `fillNormal` writes them).
+	// 	They are generated `SIZE` at a time with the SIMD kernels, for code that needs an unknown number of values.
+	template<Distribution DISTRIBUTION>
+	class BasicRandomBuffer{
+		public:
+			static constexpr size_t SIZE = 4 * PHILOX_CHUNK_SIZE;
+
+			explicit BasicRandomBuffer(const RandomStream& random_stream) : stream(random_stream) {}
+			~BasicRandomBuffer() = default;
+
+			EVO_NODISCARD auto next() -> float {
+				if(this->index == SIZE){
+					if constexpr(DISTRIBUTION == Distribution::UNIFORM_01){
+						fillUniform01(this->values, this->stream, this->next_chunk);
+					}else{
+						fillNormal(this->values, this->stream, this->next_chunk);
+					}
+					this->next_chunk += SIZE / PHILOX_CHUNK_SIZE;
+					this->index = 0;
+				}
+
+				const float value = this->values[this->index];
+				this->index += 1;
+				return value;
+			}
+
+		private:
+			RandomStream stream;
+			size_t next_chunk = 0;
+			size_t index = SIZE;
+			alignas(64) std::array<float, SIZE> values;
+	};
+
+	using RandomBuffer = BasicRandomBuffer<Distribution::UNIFORM_01>;
+	using NormalRandomBuffer = BasicRandomBuffer<Distribution::NORMAL>;
+
+
+}
@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include "./activation.h"
+
+
+namespace tigris::kernels{
+
+	// Sparse weights are stored in CSR with one row per output (so the rows of the CSR are the columns of the dense
+	// 	`w[k x n]`). The nonzeros of output `j` are `values[row_offsets[j] .. row_offsets[j + 1]]`, and
+	// 	`column_indices` has the index of the input each of them is multiplied with. `row_offsets` has `n + 1` values.
+
+
+	// y[1 x n] = activation(x[1 x k] * w[k x n]) for a sparse `w` (see above)
+	// 	The inputs of each output are gathered, so the time depends on the number of nonzeros rather than `k * n`.
+	// 	`y` must not alias `x`
+	auto spmv(
+		const float* x,
+		const uint32_t* row_offsets, const uint32_t* column_indices, const float* values,
+		float* y,
+		size_t n,
+		Activation activation
+	) -> void;
+
+
+	// Name of the implementation selected for this CPU ("avx512", "avx2", or "scalar")
+	EVO_NODISCARD auto spmvImplementationName() -> std::string_view;
+
+
+}
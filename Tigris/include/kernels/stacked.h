@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include "./activation.h"
+
+
+namespace tigris::kernels{
+
+	// Stacked (AoSoA) layers: the weights of `STACK_LANES` networks with the same topology are interleaved so that
+	// 	lane `l` of every vector belongs to network `l`, and one SIMD instruction does the same step of 16 networks.
+	//
+	// Layout of one layer `w[k x n]` of a stack:
+	// 	w[(j * k + p) * STACK_LANES + lane] (output `j`, input `p`), so the weights of one output are contiguous.
+	// Layout of the values between layers (for a batch of inputs `b`):
+	// 	y[(b * n + j) * STACK_LANES + lane]
+	//
+	// The lane count is part of the layout, not the instruction set: AVX2 and scalar use the same layout.
+
+	inline constexpr size_t STACK_LANES = 16;
+
+
+	// y[b][j][lane] = activation(sum_p x[b * x_stride + p] * w[j][p][lane])
+	// 	The first layer: every network gets the same inputs (one input per row of `x`).
+	auto stackedGemvShared(
+		const float* x, size_t x_stride,
+		const float* w,
+		float* y,
+		size_t num_inputs, size_t n, size_t k,
+		Activation activation
+	) -> void;
+
+	// y[b][j][lane] = activation(sum_p x[b][p][lane] * w[j][p][lane])
+	// 	The other layers: every network has its own inputs (the output of its previous layer).
+	// 	`y` must not alias `x`
+	auto stackedGemv(
+		const float* x,
+		const float* w,
+		float* y,
+		size_t num_inputs, size_t n, size_t k,
+		Activation activation
+	) -> void;
+
+
+	// Name of the implementation selected for this CPU ("avx512", "avx2", or "scalar")
+	EVO_NODISCARD auto stackedImplementationName() -> std::string_view;
+
+
+}
@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+
+namespace tigris{
+
+	// Policy heads: networks with one output (logit) per move of a game, so a player picks its move from a single
+	// 	forward pass on the current board instead of one pass per possible move. The outputs of moves that are not
+	// 	legal in the position are masked out.
+
+
+	// Sets the logits of the illegal moves to -infinity (a softmax over them gives those moves a probability of 0)
+	inline auto maskIllegalMoves(std::span<float> logits, std::span<const bool> legal_moves) -> void {
+		evo::debugAssert(logits.size() == legal_moves.size(), "Need a logit for every move");
+
+		for(size_t i = 0; i < logits.size(); i+=1){
+			if(legal_moves[i] == false){ logits[i] = -std::numeric_limits<float>::infinity(); }
+		}
+	}
+
+
+	// Index of the legal move with the highest logit (the first one if there is a tie).
+	// 	There must be at least 1 legal move
+	EVO_NODISCARD inline auto pickMove(std::span<const float> logits, std::span<const bool> legal_moves) -> size_t {
+		evo::debugAssert(logits.size() == legal_moves.size(), "Need a logit for every move");
+
+		size_t best_move = legal_moves.size();
+		for(size_t i = 0; i < logits.size(); i+=1){
+			if(legal_moves[i] == false){ continue; }
+			if(best_move == legal_moves.size() || logits[i] > logits[best_move]){ best_move = i; }
+		}
+
+		evo::debugAssert(best_move != legal_moves.size(), "No legal moves");
+		return best_move;
+	}
+
+
+}
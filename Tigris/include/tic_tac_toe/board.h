@@ -54,7 +54,35 @@ namespace tigris::tic_tac_toe{
 			EVO_NODISCARD auto getGameStatus() const -> GameStatus;
 
 
+			static constexpr size_t AI_DATA_SIZE = 9;
 			EVO_NODISCARD auto getAIData() const -> std::vector<float>;
+			auto getAIData(std::span<float> output) const -> void; // output.size() must be AI_DATA_SIZE
+
+			// From the view of `player` (the player to move): its pieces are 1 and the other player's are -1.
+			// 	For policy heads (see `tigris::pickMove()`), so the same network can play both X and O
+			auto getAIData(std::span<float> output, Space player) const -> void;
+
+
+			// One-hot occupancy planes from the view of `player`: bit `i` is set if space `i` (row * 3 + collumn) has a
+			// 	piece of `player` and bit `9 + i` if it has a piece of the other player.
+			// 	For the bitplane inputs of `tigris::AI` (see `kernels/bitplane.h`)
+			static constexpr size_t BITPLANE_SIZE = 18;
+			using Bitplanes = std::array<uint64_t, (BITPLANE_SIZE + 63) / 64>;
+			EVO_NODISCARD auto getBitplanes(Space player) const -> Bitplanes;
+
+			// the same planes as 0 / 1 floats (for networks that take dense inputs)
+			auto getBitplaneAIData(std::span<float> output, Space player) const -> void; // size must be BITPLANE_SIZE
+
+
+			// one move per space: move `i` is `Coordinate(i / 3, i % 3)`
+			static constexpr size_t NUM_MOVES = 9;
+			EVO_NODISCARD auto getLegalMoves() const -> std::array<bool, NUM_MOVES>;
+
+			// Unique key of the board (the spaces as a base 3 number, so less than 3^9), for `tigris::EvaluationCache`
+			EVO_NODISCARD auto getKey() const -> uint64_t;
+
+			// the board with key `key` (every key below 3^9 is a board, but not all of them are reachable in a game)
+			EVO_NODISCARD static auto fromKey(uint64_t key) -> Board;
 
 			EVO_NODISCARD auto toString() const -> std::string;
 
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include "../MatrixView.h"
+#include "./board.h"
+
+
+namespace tigris::tic_tac_toe{
+
+
+	// The moves of a trained AI for every board, computed ahead of time.
+	// 	There are only 3^9 boards, so every one of them is played by the AI once and its move is stored at the key of
+	// 	the board (`Board::getKey()`). Playing a move is then a single load instead of a forward pass per possible
+	// 	move, and the table is only 19,683 bytes.
+	class MoveTable{
+		public:
+			static constexpr size_t NUM_KEYS = 19683; // 3^9
+			static constexpr uint8_t NO_MOVE = 0xFF; // the game is over, or the board can not happen in a game
+
+			// `ai` is a value network (like the ones of `run_tic_tac_toe_training()`): every possible move is scored
+			// 	with `calculateBatch()` on its board (`Board::getAIData()`), and X plays the one with the highest
+			// 	output and O the one with the lowest (the first one if there is a tie).
+			// 	X moves first, so X is to move if both players have the same number of pieces.
+			// 	Works with both `tigris::AI` and `tigris::StaticAI`
+			template<class AIType>
+			EVO_NODISCARD static auto fromAI(const AIType& ai) -> MoveTable {
+				auto table = MoveTable();
+
+				for(size_t key = 0; key < NUM_KEYS; key+=1){
+					const Board board = Board::fromKey(key);
+					table.moves[key] = NO_MOVE;
+
+					size_t num_x = 0;
+					size_t num_o = 0;
+					for(size_t digits = key; digits != 0; digits /= 3){
+						if(digits % 3 == size_t(Board::Space::X)){ num_x += 1; }
+						if(digits % 3 == size_t(Board::Space::O)){ num_o += 1; }
+					}
+					if(num_x != num_o && num_x != num_o + 1){ continue; }
+					if(board.getGameStatus() != Board::GameStatus::IN_PROGRESS){ continue; }
+
+					const bool is_x_turn = num_x == num_o;
+					const std::array<bool, Board::NUM_MOVES> legal_moves = board.getLegalMoves();
+
+					// the possible moves, in the order of the spaces (like `Board::getPossibleMovesForX()`)
+					auto ai_data = std::array<float, Board::AI_DATA_SIZE * Board::NUM_MOVES>();
+					auto possible_moves = std::array<uint8_t, Board::NUM_MOVES>();
+					size_t num_possible_moves = 0;
+					for(size_t move = 0; move < Board::NUM_MOVES; move+=1){
+						if(legal_moves[move] == false){ continue; }
+
+						Board child = board;
+						if(is_x_turn){
+							child.placeX(Board::Coordinate(move / 3, move % 3));
+						}else{
+							child.placeO(Board::Coordinate(move / 3, move % 3));
+						}
+						child.getAIData(
+							std::span<float>(&ai_data[num_possible_moves * Board::AI_DATA_SIZE], Board::AI_DATA_SIZE)
+						);
+
+						possible_moves[num_possible_moves] = uint8_t(move);
+						num_possible_moves += 1;
+					}
+
+					const ConstMatrixView results = ai.calculateBatch(
+						ConstMatrixView(ai_data.data(), Board::AI_DATA_SIZE, num_possible_moves)
+					);
+
+					size_t best_move = 0;
+					for(size_t i = 1; i < num_possible_moves; i+=1){
+						if(is_x_turn ? results[0, i] > results[0, best_move] : results[0, i] < results[0, best_move]){
+							best_move = i;
+						}
+					}
+					table.moves[key] = possible_moves[best_move];
+				}
+
+				return table;
+			}
+
+			// a table saved from `data()`
+			explicit MoveTable(std::span<const uint8_t, NUM_KEYS> table_moves) {
+				std::ranges::copy(table_moves, this->moves.begin());
+			}
+
+			~MoveTable() = default;
+
+
+			// Move of the player to move on `board` (move `i` is `Board::Coordinate(i / 3, i % 3)`), or `NO_MOVE`
+			EVO_NODISCARD auto getMove(const Board& board) const -> uint8_t {
+				return this->moves[board.getKey()];
+			}
+
+			// `board` after the move of the player to move (the game must not be over)
+			EVO_NODISCARD auto play(const Board& board, Board::Space player) const -> Board {
+				const uint8_t move = this->getMove(board);
+				evo::debugAssert(move != NO_MOVE, "No move for this board");
+
+				Board output = board;
+				if(player == Board::Space::X){
+					output.placeX(Board::Coordinate(move / 3, move % 3));
+				}else{
+					output.placeO(Board::Coordinate(move / 3, move % 3));
+				}
+				return output;
+			}
+
+
+			EVO_NODISCARD auto data() const -> std::span<const uint8_t, NUM_KEYS> { return this->moves; }
+
+		private:
+			MoveTable() = default;
+
+		private:
+			std::array<uint8_t, NUM_KEYS> moves;
+	};
+
+
+}
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include "../policy.h"
+#include "./board.h"
+
+
+namespace tigris::tic_tac_toe{
+
+	// Players with a policy head (one output per space, see `tigris::pickMove()`): each move is one forward pass on the
+	// 	current board, from the view of the player to move, with the occupied spaces masked.
+	// 	Works with both `tigris::AI` and `tigris::StaticAI`
+
+
+	// Move of `player` on `board` (move `i` is `Board::Coordinate(i / 3, i % 3)`). The game must not be over
+	template<class AIType>
+	EVO_NODISCARD auto pickPolicyMove(const AIType& ai, const Board& board, Board::Space player) -> size_t {
+		auto ai_data = std::array<float, Board::AI_DATA_SIZE>();
+		board.getAIData(ai_data, player);
+
+		return pickMove(ai.calculate(ai_data), board.getLegalMoves());
+	}
+
+
+	// Plays a game from the empty board, X moving first
+	template<class AIType>
+	EVO_NODISCARD auto playPolicyGame(const AIType& x_player, const AIType& o_player) -> Board::GameStatus {
+		auto board = Board();
+		bool is_x_turn = true;
+
+		while(board.getGameStatus() == Board::GameStatus::IN_PROGRESS){
+			if(is_x_turn){
+				const size_t move = pickPolicyMove(x_player, board, Board::Space::X);
+				board.placeX(Board::Coordinate(move / 3, move % 3));
+			}else{
+				const size_t move = pickPolicyMove(o_player, board, Board::Space::O);
+				board.placeO(Board::Coordinate(move / 3, move % 3));
+			}
+
+			is_x_turn = !is_x_turn;
+		}
+
+		return board.getGameStatus();
+	}
+
+
+}
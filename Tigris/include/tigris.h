@@ -11,10 +11,27 @@
 #pragma once
 
 
+#include "./ThreadPool.h"
+#include "./MatrixView.h"
 #include "./Matrix.h"
+#include "./HalfMatrix.h"
+#include "./SparseMatrix.h"
 #include "./AI.h"
+#include "./Population.h"
 #include "./Environment.h"
+#include "./StaticMatrix.h"
+#include "./StaticAI.h"
+#include "./QuantizedAI.h"
+#include "./SparseAI.h"
+#include "./StackedAI.h"
+#include "./CompiledAI.h"
+#include "./policy.h"
+#include "./EvaluationCache.h"
 
 
 #include "./connect_4/board.h"
-#include "./tic_tac_toe/board.h"
\ No newline at end of file
+#include "./tic_tac_toe/board.h"
+#include "./tic_tac_toe/move_table.h"
+#include "./tic_tac_toe/policy_player.h"
+
+#include "./benchmarks.h"
\ No newline at end of file
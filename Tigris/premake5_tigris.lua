@@ -25,6 +25,49 @@ project "tigris"
 		"Vulkan",
 	}
 
+	-- dlopen (tigris::CompiledAI)
+	filter "system:linux"
+		links{
+			"dl",
+		}
+	filter {}
+
+
+
+project "tigris_tests"
+	kind "ConsoleApp"
+
+	targetdir(target.bin)
+	objdir(target.obj)
+
+	files{
+		"./src/**.cpp",
+		"./tests/**.cpp",
+	}
+
+	-- only the library parts of Tigris
+	removefiles{
+		"./src/main.cpp",
+		"./src/benchmarks/**.cpp",
+	}
+
+	includedirs{
+		"./include/",
+		"../dependencies/",
+	}
+
+
+	links{
+		"Evo",
+	}
+
+	-- dlopen (tigris::CompiledAI)
+	filter "system:linux"
+		links{
+			"dl",
+		}
+	filter {}
+
 
 project "*"
 
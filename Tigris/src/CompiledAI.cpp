@@ -0,0 +1,359 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <CompiledAI.h>
+
+#include <kernels/cpu.h>
+
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+#if !defined(EVO_PLATFORM_WINDOWS)
+	#include <dlfcn.h>
+	#include <pwd.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+namespace tigris{
+
+	// layers with at most this many weights have the loop over their inputs fully unrolled
+	static constexpr size_t FULL_UNROLL_WEIGHTS = 4096;
+
+	// max outputs of a layer calculated at once (8 AVX-512 registers of sums)
+	static constexpr size_t TILE_WIDTH = 128;
+
+
+	// description of the shape, compiled into the library to check that a cached library is the right one
+	static auto shape_string(const AI& ai) -> std::string {
+		auto output = std::format("activation={};dims={}", int(ai.getActivation()), ai.numInputs());
+		for(const Matrix& matrix : ai.getMatrices()){
+			output += std::format(",{}/{}", matrix.width(), matrix.stride());
+		}
+		return output;
+	}
+
+
+	// the body of `float activate(float value)` in the generated code (same math as `kernels::activate()`)
+	static auto activation_source(kernels::Activation activation) -> std::string {
+		switch(activation){
+			case kernels::Activation::NONE:    return "return value;";
+			case kernels::Activation::TANH:    return "return __builtin_tanhf(value);";
+			case kernels::Activation::SIGMOID: return "return 1.0f / (1.0f + __builtin_expf(-value));";
+
+			case kernels::Activation::FAST_TANH: case kernels::Activation::FAST_SIGMOID: {
+				// `kernels::fastTanh()`
+				return std::format(
+					"{}"
+					"const float x = value < -7.90531110763549805f ? -7.90531110763549805f"
+						" : (value > 7.90531110763549805f ? 7.90531110763549805f : value);\n"
+					"\tconst float x2 = x * x;\n"
+					"\tfloat p = -2.76076847742355e-16f;\n"
+					"\tp = p * x2 + 2.00018790482477e-13f;\n"
+					"\tp = p * x2 - 8.60467152213735e-11f;\n"
+					"\tp = p * x2 + 5.12229709037114e-08f;\n"
+					"\tp = p * x2 + 1.48572235717979e-05f;\n"
+					"\tp = p * x2 + 6.37261928875436e-04f;\n"
+					"\tp = p * x2 + 4.89352455891786e-03f;\n"
+					"\tfloat q = 1.19825839466702e-06f;\n"
+					"\tq = q * x2 + 1.18534705686654e-04f;\n"
+					"\tq = q * x2 + 2.26843463243900e-03f;\n"
+					"\tq = q * x2 + 4.89352518554385e-03f;\n"
+					"\t{}",
+					activation == kernels::Activation::FAST_SIGMOID ? "value = 0.5f * value;\n\t" : "",
+					activation == kernels::Activation::FAST_SIGMOID ? "return 0.5f + 0.5f * (x * p / q);" : "return x * p / q;"
+				);
+			}
+		}
+
+		evo::debugFatalBreak("Unknown activation");
+		return "return value;";
+	}
+
+
+	auto CompiledAI::generateSource(const AI& ai) -> std::string {
+		const evo::ArrayProxy<Matrix> matrices = ai.getMatrices();
+
+		auto source = std::format(
+			"// generated by Tigris (tigris::CompiledAI)\n"
+			"\n"
+			"extern \"C\" const char* tigris_shape(){{ return \"{}\"; }}\n"
+			"\n"
+			"static inline float activate(float value){{\n"
+			"\t{}\n"
+			"}}\n",
+			shape_string(ai), activation_source(ai.getActivation())
+		);
+
+		// y[1 x width] = activate(x[1 x k] * w[k x width]), the outputs of a layer `TILE_WIDTH` at a time (so the
+		// 	sums stay in registers), one row of `w` (one input) at a time so the loop over the outputs is vectorized.
+		// 	Narrow tiles have few independent sums, so the inputs are split over `lanes` partial sums (for 1 output they
+		// 	are contiguous, so the partial sums are one vector)
+		const auto tile_source = [](std::string_view name, size_t k, size_t width, size_t stride) -> std::string {
+			const size_t num_vectors = (width + 15) / 16;
+			const size_t lanes = width == 1 ? 16 : std::clamp<size_t>(8 / num_vectors, 1, 8);
+			const size_t main_k = k - k % lanes;
+			const size_t unroll = k * width <= FULL_UNROLL_WEIGHTS ? std::max<size_t>(k / lanes, 1) : 4;
+
+			return std::format(
+				"\n"
+				"static inline void {0}(const float* __restrict x, const float* __restrict w, float* __restrict y){{\n"
+				"\talignas(64) float acc[{1}][{2}] = {{}};\n"
+				"\t#pragma GCC unroll {5}\n"
+				"\tfor(int p0 = 0; p0 < {3}; p0 += {1}){{\n"
+				"\t\tfor(int l = 0; l < {1}; l++){{\n"
+				"\t\t\tconst float x_p = x[p0 + l];\n"
+				"\t\t\tconst float* __restrict w_p = w + (p0 + l) * {4};\n"
+				"\t\t\tfor(int j = 0; j < {2}; j++){{ acc[l][j] += x_p * w_p[j]; }}\n"
+				"\t\t}}\n"
+				"\t}}\n"
+				"\tfor(int p = {3}; p < {6}; p++){{\n"
+				"\t\tfor(int j = 0; j < {2}; j++){{ acc[0][j] += x[p] * w[p * {4} + j]; }}\n"
+				"\t}}\n"
+				"\tfor(int j = 0; j < {2}; j++){{\n"
+				"\t\tfloat sum = acc[0][j];\n"
+				"\t\tfor(int l = 1; l < {1}; l++){{ sum += acc[l][j]; }}\n"
+				"\t\ty[j] = activate(sum);\n"
+				"\t}}\n"
+				"}}\n",
+				name, lanes, width, main_k, stride, unroll, k
+			);
+		};
+
+		for(size_t i = 0; i < matrices.size(); i+=1){
+			const size_t k = matrices[i].height();
+			const size_t n = matrices[i].width();
+			const size_t stride = matrices[i].stride();
+
+			const size_t full_width = std::min(TILE_WIDTH, n);
+			const size_t last_width = n % full_width;
+
+			source += tile_source(std::format("layer_{}_tile", i), k, full_width, stride);
+			if(last_width != 0){ source += tile_source(std::format("layer_{}_last_tile", i), k, last_width, stride); }
+
+			source += std::format(
+				"\nstatic inline void layer_{}(const float* __restrict x, const float* __restrict w, float* __restrict y){{\n",
+				i
+			);
+			for(size_t offset = 0; offset + full_width <= n; offset += full_width){
+				source += std::format("\tlayer_{}_tile(x, w + {}, y + {});\n", i, offset, offset);
+			}
+			if(last_width != 0){
+				source += std::format("\tlayer_{}_last_tile(x, w + {}, y + {});\n", i, n - last_width, n - last_width);
+			}
+			source += "}\n";
+		}
+
+		source += "\nextern \"C\" void tigris_forward(const float* const* layers, const float* input, float* output){\n";
+		for(size_t i = 0; i + 1 < matrices.size(); i+=1){
+			source += std::format("\talignas(64) float h{}[{}];\n", i, matrices[i].width());
+		}
+		for(size_t i = 0; i < matrices.size(); i+=1){
+			source += std::format(
+				"\tlayer_{}({}, layers[{}], {});\n",
+				i,
+				i == 0 ? std::string("input") : std::format("h{}", i - 1),
+				i,
+				i + 1 == matrices.size() ? std::string("output") : std::format("h{}", i)
+			);
+		}
+		source += "}\n";
+
+		return source;
+	}
+
+
+
+	#if defined(EVO_PLATFORM_WINDOWS)
+
+		// never used (nothing is compiled on Windows)
+		auto defaultCodegenCacheDirectory() -> std::filesystem::path {
+			return std::filesystem::temp_directory_path() / "tigris_codegen";
+		}
+
+		auto CompiledAI::load_forward_function(const AI&, const CodegenOptions&) -> ForwardFunc {
+			return nullptr;
+		}
+
+	#else
+
+		auto defaultCodegenCacheDirectory() -> std::filesystem::path {
+			// relative paths are invalid in the XDG spec
+			if(const char* cache_home = std::getenv("XDG_CACHE_HOME"); cache_home != nullptr && cache_home[0] == '/'){
+				return std::filesystem::path(cache_home) / "tigris";
+			}
+
+			if(const char* home = std::getenv("HOME"); home != nullptr && home[0] == '/'){
+				return std::filesystem::path(home) / ".cache" / "tigris";
+			}
+
+			if(const passwd* user = getpwuid(getuid()); user != nullptr && user->pw_dir != nullptr){
+				return std::filesystem::path(user->pw_dir) / ".cache" / "tigris";
+			}
+
+			return std::filesystem::path();
+		}
+
+
+		// Only files of the current user that no other user can write to are loaded (or compiled into), as any
+		// 	library that is loaded runs its static constructors before `tigris_shape` can be checked.
+		// 	Symlinks are not followed, so they can not point somewhere else
+		static auto is_private(const std::filesystem::path& path, mode_t type) -> bool {
+			struct stat status;
+			if(lstat(path.c_str(), &status) != 0){ return false; }
+
+			return (status.st_mode & S_IFMT) == type
+				&& status.st_uid == getuid()
+				&& (status.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+		}
+
+		// creates the directory (mode 0700) if needed, false if it can not be used
+		static auto prepare_cache_directory(const std::filesystem::path& directory) -> bool {
+			if(directory.empty()){ return false; }
+
+			auto error_code = std::error_code();
+			std::filesystem::create_directories(directory.parent_path(), error_code);
+			mkdir(directory.c_str(), 0700);
+
+			return is_private(directory, S_IFDIR);
+		}
+
+
+		// `-march=native` compiles for the host CPU, so the instructions a library may use are part of its cache key
+		// 	(otherwise a cache directory shared between machines could load instructions this CPU does not have)
+		static auto host_cpu_string() -> const std::string& {
+			static const std::string cpu_string = [](){
+				auto cpuinfo = std::ifstream("/proc/cpuinfo");
+				auto line = std::string();
+				while(std::getline(cpuinfo, line)){
+					// "flags" on x86, "Features" on ARM
+					if(line.starts_with("flags") || line.starts_with("Features")){ return line; }
+				}
+
+				// no /proc/cpuinfo (macOS)
+				const kernels::CPUFeatures& features = kernels::getCPUFeatures();
+				return std::format(
+					"avx2={};avx512f={};avx512vnni={}", features.avx2, features.avx512f, features.avx512vnni
+				);
+			}();
+
+			return cpu_string;
+		}
+
+		// FNV-1a
+		static auto hash_string(std::string_view string) -> uint64_t {
+			uint64_t hash = 0xcbf29ce484222325ull;
+			for(char character : string){
+				hash ^= uint64_t(uint8_t(character));
+				hash *= 0x100000001b3ull;
+			}
+			return hash;
+		}
+
+
+		// nullptr if the library can not be loaded or is not for `shape`
+		static auto load_library(const std::filesystem::path& path, std::string_view shape) -> CompiledAI::ForwardFunc {
+			void* library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+			if(library == nullptr){ return nullptr; }
+
+			using ShapeFunc = const char*(*)();
+			const auto library_shape = reinterpret_cast<ShapeFunc>(dlsym(library, "tigris_shape"));
+			const auto forward = reinterpret_cast<CompiledAI::ForwardFunc>(dlsym(library, "tigris_forward"));
+
+			if(library_shape == nullptr || forward == nullptr || library_shape() != shape){
+				dlclose(library);
+				return nullptr;
+			}
+
+			// the library is never closed, as every `CompiledAI` of this shape uses it
+			return forward;
+		}
+
+
+		auto CompiledAI::load_forward_function(const AI& ai, const CodegenOptions& options) -> ForwardFunc {
+			const std::string source = generateSource(ai);
+			const std::string shape = shape_string(ai);
+
+			const uint64_t hash = hash_string(
+				source + '\n' + options.compiler + ' ' + options.flags + '\n' + host_cpu_string()
+			);
+
+			// every shape is only loaded once per process
+			static auto mutex = std::mutex();
+			static auto loaded = std::unordered_map<uint64_t, ForwardFunc>();
+			const auto lock = std::scoped_lock(mutex);
+
+			if(const auto find = loaded.find(hash); find != loaded.end()){ return find->second; }
+
+			// not added to `loaded`, so the shape can still be compiled into another directory
+			if(prepare_cache_directory(options.cacheDirectory) == false){
+				evo::log::warning(
+					"tigris::CompiledAI: cache directory `{}` can not be created or is not private to this user, "
+						"using tigris::AI instead",
+					options.cacheDirectory.string()
+				);
+				return nullptr;
+			}
+
+
+			const std::string name = std::format("tigris_forward_{:016x}", hash);
+			const std::filesystem::path library_path = options.cacheDirectory / (name + ".so");
+
+			auto error_code = std::error_code();
+			ForwardFunc forward = nullptr;
+			if(std::filesystem::exists(std::filesystem::symlink_status(library_path, error_code))){
+				if(is_private(library_path, S_IFREG) == false){
+					evo::log::warning(
+						"tigris::CompiledAI: `{}` is not private to this user, using tigris::AI instead",
+						library_path.string()
+					);
+					return nullptr;
+				}
+
+				forward = load_library(library_path, shape);
+			}
+
+			if(forward == nullptr){
+				const std::filesystem::path source_path = options.cacheDirectory / (name + ".cpp");
+				std::ofstream(source_path) << source;
+
+				// compiled to a file of this process and then renamed, so other processes never load a partial library
+				const std::filesystem::path temp_path = options.cacheDirectory / std::format("{}.{}.tmp", name, getpid());
+				const std::filesystem::path log_path = options.cacheDirectory / (name + ".log");
+
+				const std::string command = std::format(
+					"{} {} -shared -fPIC -o \"{}\" \"{}\" > \"{}\" 2>&1",
+					options.compiler, options.flags, temp_path.string(), source_path.string(), log_path.string()
+				);
+
+				if(std::system(nullptr) != 0 && std::system(command.c_str()) == 0){
+					std::filesystem::rename(temp_path, library_path, error_code);
+					if(!error_code){ forward = load_library(library_path, shape); }
+				}else{
+					std::filesystem::remove(temp_path, error_code);
+				}
+
+				if(forward == nullptr){
+					evo::log::warning(
+						"tigris::CompiledAI: could not compile `{}` (see `{}`), using tigris::AI instead",
+						source_path.string(), log_path.string()
+					);
+				}
+			}
+
+			loaded.emplace(hash, forward);
+			return forward;
+		}
+
+	#endif
+
+
+}
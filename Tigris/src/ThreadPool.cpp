@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <ThreadPool.h>
+
+#include <utility>
+
+
+namespace tigris{
+
+
+	thread_local bool ThreadPool::is_inside_task = false;
+
+
+	ThreadPool::ThreadPool(size_t num_workers) {
+		this->workers.reserve(num_workers);
+		for(size_t i = 0; i < num_workers; i+=1){
+			this->workers.emplace_back([this](){ this->worker_loop(); });
+		}
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			const auto lock = std::scoped_lock(this->mutex);
+			this->is_stopping = true;
+		}
+		this->work_condition.notify_all();
+
+		for(std::thread& worker : this->workers){
+			worker.join();
+		}
+	}
+
+
+	auto ThreadPool::get() -> ThreadPool& {
+		static auto thread_pool = ThreadPool(std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1);
+		return thread_pool;
+	}
+
+
+
+	auto ThreadPool::parallelFor(size_t num_tasks, const std::function<void(size_t)>& func) -> void {
+		if(this->tryParallelFor(num_tasks, func)){ return; }
+
+		const bool was_inside_task = std::exchange(is_inside_task, true);
+		for(size_t i = 0; i < num_tasks; i+=1){
+			func(i);
+		}
+		is_inside_task = was_inside_task;
+	}
+
+
+	auto ThreadPool::tryParallelFor(size_t num_tasks, const std::function<void(size_t)>& func) -> bool {
+		if(is_inside_task){ return false; }
+
+		// the workers would not be used anyway
+		if(num_tasks <= 1 || this->workers.empty()){
+			const bool was_inside_task = std::exchange(is_inside_task, true);
+			for(size_t i = 0; i < num_tasks; i+=1){
+				func(i);
+			}
+			is_inside_task = was_inside_task;
+			return true;
+		}
+
+		auto submit_lock = std::unique_lock(this->submit_mutex, std::try_to_lock);
+		if(submit_lock.owns_lock() == false){ return false; } // another thread is already using the workers
+
+
+		{
+			auto lock = std::unique_lock(this->mutex);
+
+			// a worker that woke up late for the previous job may still be looking at it
+			this->done_condition.wait(lock, [&](){ return this->num_active_workers == 0; });
+
+			this->job.func = &func;
+			this->job.num_tasks = num_tasks;
+			this->job.next_task = 0;
+			this->job.num_remaining = num_tasks;
+			this->generation += 1;
+		}
+		this->work_condition.notify_all();
+
+		this->run_tasks();
+
+		auto lock = std::unique_lock(this->mutex);
+		this->done_condition.wait(lock, [&](){
+			return this->job.num_remaining == 0 && this->num_active_workers == 0;
+		});
+
+		return true;
+	}
+
+
+
+	auto ThreadPool::worker_loop() -> void {
+		uint64_t last_generation = 0;
+
+		while(true){
+			auto lock = std::unique_lock(this->mutex);
+			this->work_condition.wait(lock, [&](){
+				return this->is_stopping || this->generation != last_generation;
+			});
+
+			if(this->is_stopping){ return; }
+
+			last_generation = this->generation;
+			this->num_active_workers += 1;
+			lock.unlock();
+
+			this->run_tasks();
+
+			lock.lock();
+			this->num_active_workers -= 1;
+			if(this->num_active_workers == 0){
+				this->done_condition.notify_all();
+			}
+		}
+	}
+
+
+	auto ThreadPool::run_tasks() -> void {
+		const bool was_inside_task = std::exchange(is_inside_task, true);
+
+		while(true){
+			const size_t task = this->job.next_task.fetch_add(1);
+			if(task >= this->job.num_tasks){ break; }
+
+			(*this->job.func)(task);
+
+			this->job.num_remaining.fetch_sub(1);
+		}
+
+		is_inside_task = was_inside_task;
+	}
+
+	
+}
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <benchmarks.h>
+
+
+namespace tigris::benchmarks{
+
+
+	struct Benchmark{
+		std::string_view name;
+		auto(*func)() -> void;
+	};
+
+	static constexpr auto BENCHMARKS = std::to_array<Benchmark>({
+		{"gemm",            &gemm},
+		{"gemmParallel",    &gemmParallel},
+		{"gemmBatched",     &gemmBatched},
+		{"activations",     &activations},
+		{"aiCalculate",     &aiCalculate},
+		{"calculateBatch",  &calculateBatch},
+		{"policyHead",      &policyHead},
+		{"accumulator",     &accumulator},
+		{"bitplanes",       &bitplanes},
+		{"compiledAI",      &compiledAI},
+		{"stackedAI",       &stackedAI},
+		{"weightPrecision", &weightPrecision},
+		{"quantizedAI",     &quantizedAI},
+		{"sparseAI",        &sparseAI},
+		{"populationArena", &populationArena},
+		{"mutation",        &mutation},
+		{"normalMutation",  &normalMutation},
+		{"populationInit",  &populationInit},
+		{"evaluationCache", &evaluationCache},
+		{"moveTable",       &moveTable},
+	});
+
+
+	auto run(std::string_view name) -> bool {
+		if(name == "all"){
+			for(const Benchmark& benchmark : BENCHMARKS){
+				benchmark.func();
+				evo::println();
+			}
+			return true;
+		}
+
+		for(const Benchmark& benchmark : BENCHMARKS){
+			if(benchmark.name == name){
+				benchmark.func();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+}
@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <benchmarks.h>
+
+#include <AI.h>
+#include <Environment.h>
+#include <StaticAI.h>
+#include <EvaluationCache.h>
+#include <tic_tac_toe/board.h>
+#include <tic_tac_toe/move_table.h>
+#include <connect_4/board.h>
+
+#include "./timing.h"
+
+#include <random>
+#include <unordered_set>
+
+
+namespace tigris::benchmarks{
+
+
+	auto evaluationCache() -> void {
+		static constexpr size_t NUM_INPUTS = tic_tac_toe::Board::AI_DATA_SIZE;
+		static constexpr size_t POPULATION = 64;
+
+		using TicTacToeAI = StaticAI<NUM_INPUTS, 64, 1>;
+		using Board = tic_tac_toe::Board;
+
+
+		///////////////////////////////////
+		// keys
+
+		// every reachable position has its own key
+		{
+			auto positions = std::unordered_set<std::string>();
+			auto keys = std::unordered_set<uint64_t>();
+
+			const auto visit = [&](const auto& self, const Board& board, bool is_x_turn) -> void {
+				if(positions.emplace(board.toString()).second == false){ return; }
+				keys.emplace(board.getKey());
+
+				if(board.getGameStatus() != Board::GameStatus::IN_PROGRESS){ return; }
+				for(const Board& child : is_x_turn ? board.getPossibleMovesForX() : board.getPossibleMovesForO()){
+					self(self, child, !is_x_turn);
+				}
+			};
+			visit(visit, Board(), true);
+
+			evo::printlnCyan("evaluation cache");
+			evo::println("tic-tac-toe: {} reachable positions, {} keys", positions.size(), keys.size());
+		}
+
+		{
+			auto positions = std::unordered_set<std::string>();
+			auto keys = std::unordered_set<uint64_t>();
+
+			auto rng = std::mt19937_64(12);
+			for(size_t game = 0; game < 2000; game+=1){
+				auto board = connect_4::Board();
+				bool is_x_turn = true;
+				while(board.getGameStatus() == connect_4::Board::GameStatus::IN_PROGRESS){
+					const std::array<bool, connect_4::Board::NUM_MOVES> legal_moves = board.getLegalMoves();
+					if(std::ranges::find(legal_moves, true) == legal_moves.end()){ break; }
+
+					size_t collumn = rng() % legal_moves.size();
+					while(legal_moves[collumn] == false){ collumn = rng() % legal_moves.size(); }
+					if(is_x_turn){ board.placeX(collumn); }else{ board.placeO(collumn); }
+					is_x_turn = !is_x_turn;
+
+					positions.emplace(board.toString());
+					keys.emplace(board.getKey());
+				}
+			}
+
+			evo::println("connect 4: {} positions from random games, {} keys", positions.size(), keys.size());
+		}
+
+
+		///////////////////////////////////
+		// tournament
+
+		auto environment = Environment(
+			POPULATION, std::to_array<size_t>({NUM_INPUTS, 64, 1}), kernels::WeightPrecision::FP32,
+			kernels::Activation::FAST_TANH
+		);
+		environment.initRandom(12);
+
+		auto population = std::vector<TicTacToeAI>();
+		population.reserve(POPULATION);
+		for(size_t i = 0; i < POPULATION; i+=1){
+			population.emplace_back(environment.population[i]);
+		}
+
+		// X picks the move with the highest evaluation and O the lowest (like `ai_play_tic_tac_toe` in main.cpp)
+		const auto play = [&](size_t x_player, size_t o_player, EvaluationCache* x_cache, EvaluationCache* o_cache)
+		-> Board::GameStatus {
+			auto board = Board();
+			bool is_x_turn = true;
+
+			while(board.getGameStatus() == Board::GameStatus::IN_PROGRESS){
+				const std::vector<Board> possible_moves = is_x_turn
+					? board.getPossibleMovesForX()
+					: board.getPossibleMovesForO();
+				const TicTacToeAI& ai = population[is_x_turn ? x_player : o_player];
+				EvaluationCache* cache = is_x_turn ? x_cache : o_cache;
+
+				// only the moves that are not cached are calculated
+				auto scores = std::array<float, 9>();
+				auto ai_data = std::array<float, NUM_INPUTS * 9>();
+				auto missed_moves = std::array<size_t, 9>();
+				size_t num_missed = 0;
+				for(size_t i = 0; i < possible_moves.size(); i+=1){
+					const std::optional<float> cached = cache != nullptr
+						? cache->find(possible_moves[i].getKey())
+						: std::nullopt;
+
+					if(cached.has_value()){
+						scores[i] = *cached;
+					}else{
+						possible_moves[i].getAIData(std::span(&ai_data[num_missed * NUM_INPUTS], NUM_INPUTS));
+						missed_moves[num_missed] = i;
+						num_missed += 1;
+					}
+				}
+				if(num_missed > 0){
+					const ConstMatrixView results = ai.calculateBatch(ConstMatrixView(ai_data.data(), NUM_INPUTS, num_missed));
+					for(size_t i = 0; i < num_missed; i+=1){
+						scores[missed_moves[i]] = results[0, i];
+						if(cache != nullptr){ cache->insert(possible_moves[missed_moves[i]].getKey(), results[0, i]); }
+					}
+				}
+
+				size_t best_move = 0;
+				for(size_t i = 1; i < possible_moves.size(); i+=1){
+					if(is_x_turn ? scores[i] > scores[best_move] : scores[i] < scores[best_move]){ best_move = i; }
+				}
+
+				board = possible_moves[best_move];
+				is_x_turn = !is_x_turn;
+			}
+
+			return board.getGameStatus();
+		};
+
+		// every pair plays a game as each side, and the caches start empty (like after every genome was mutated)
+		const auto run_tournament = [&](std::vector<EvaluationCache>* caches) -> float {
+			if(caches != nullptr){
+				for(EvaluationCache& cache : *caches){ cache.clear(); }
+			}
+
+			float x_score = 0.0f;
+			for(size_t a = 0; a < POPULATION; a+=1){
+				for(size_t b = 0; b < POPULATION; b+=1){
+					if(a == b){ continue; }
+
+					const Board::GameStatus result = caches != nullptr
+						? play(a, b, &(*caches)[a], &(*caches)[b])
+						: play(a, b, nullptr, nullptr);
+					if(result == Board::GameStatus::X_WIN){ x_score += 1.0f; }
+					if(result == Board::GameStatus::DRAW){ x_score += 0.5f; }
+				}
+			}
+			return x_score;
+		};
+
+		evo::printlnCyan(
+			"tic-tac-toe tournament ({} AIs, {} games, ms per tournament)", POPULATION, POPULATION * (POPULATION - 1)
+		);
+		evo::printlnGray(
+			"{:<16} {:>12} {:>12} {:>8} {:>10} {:>14} {:>10}",
+			"max entries", "no cache", "cached", "speedup", "hit rate", "slots / AI", "same games"
+		);
+
+		const double uncached_ns = time_ns([&](){ do_not_optimize(run_tournament(nullptr)); }, 1.0);
+		const float expected = run_tournament(nullptr);
+
+		for(size_t max_entries : {8192, 1024, 256, 64}){
+			auto caches = std::vector<EvaluationCache>(POPULATION, EvaluationCache(max_entries));
+			const double cached_ns = time_ns([&](){ do_not_optimize(run_tournament(&caches)); }, 1.0);
+
+			for(EvaluationCache& cache : caches){ cache.resetStats(); }
+			const float result = run_tournament(&caches);
+
+			auto stats = EvaluationCache::Stats();
+			size_t num_slots = 0;
+			for(const EvaluationCache& cache : caches){
+				stats += cache.getStats();
+				num_slots = std::max(num_slots, cache.numSlots());
+			}
+
+			evo::println(
+				"{:<16} {:>12.2f} {:>12.2f} {:>7.2f}x {:>9.1f}% {:>14} {:>10}",
+				max_entries, uncached_ns / 1e6, cached_ns / 1e6, uncached_ns / cached_ns,
+				stats.hitRate() * 100.0f, num_slots, result == expected ? "yes" : "no"
+			);
+		}
+	}
+
+
+	auto moveTable() -> void {
+		static constexpr size_t NUM_INPUTS = tic_tac_toe::Board::AI_DATA_SIZE;
+
+		using Board = tic_tac_toe::Board;
+
+		const auto ai = AI(
+			std::to_array<size_t>({NUM_INPUTS, 64, 1}), kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH
+		);
+		const auto static_ai = StaticAI<NUM_INPUTS, 64, 1>(ai);
+
+		// every possible move scored with one batched forward pass (like `ai_play_tic_tac_toe` in main.cpp)
+		const auto pick_value = [&](const auto& player, const Board& board, bool is_x_turn) -> Board {
+			const std::vector<Board> possible_moves = is_x_turn
+				? board.getPossibleMovesForX()
+				: board.getPossibleMovesForO();
+
+			auto ai_data = std::array<float, NUM_INPUTS * 9>();
+			for(size_t i = 0; i < possible_moves.size(); i+=1){
+				possible_moves[i].getAIData(std::span(&ai_data[i * NUM_INPUTS], NUM_INPUTS));
+			}
+
+			const ConstMatrixView results = player.calculateBatch(
+				ConstMatrixView(ai_data.data(), NUM_INPUTS, possible_moves.size())
+			);
+
+			size_t best_move = 0;
+			for(size_t i = 1; i < possible_moves.size(); i+=1){
+				if(is_x_turn ? results[0, i] > results[0, best_move] : results[0, i] < results[0, best_move]){
+					best_move = i;
+				}
+			}
+			return possible_moves[best_move];
+		};
+
+		const auto build_start = std::chrono::steady_clock::now();
+		const auto table = tic_tac_toe::MoveTable::fromAI(static_ai);
+		const double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start)
+			.count();
+
+		// a saved table plays the same moves
+		const auto loaded_table = tic_tac_toe::MoveTable(table.data());
+
+		// every reachable position where the game is not over
+		auto positions = std::vector<std::pair<Board, bool>>();
+		{
+			auto seen = std::unordered_set<uint64_t>();
+			const auto visit = [&](const auto& self, const Board& board, bool is_x_turn) -> void {
+				if(seen.emplace(board.getKey()).second == false){ return; }
+				if(board.getGameStatus() != Board::GameStatus::IN_PROGRESS){ return; }
+
+				positions.emplace_back(board, is_x_turn);
+				for(const Board& child : is_x_turn ? board.getPossibleMovesForX() : board.getPossibleMovesForO()){
+					self(self, child, !is_x_turn);
+				}
+			};
+			visit(visit, Board(), true);
+		}
+
+		size_t num_different = 0;
+		for(const auto& [board, is_x_turn] : positions){
+			const Board::Space player = is_x_turn ? Board::Space::X : Board::Space::O;
+			const uint64_t expected = pick_value(ai, board, is_x_turn).getKey();
+
+			if(table.play(board, player).getKey() != expected){ num_different += 1; }
+			if(loaded_table.play(board, player).getKey() != expected){ num_different += 1; }
+		}
+
+		// one move on every position
+		size_t position_i = 0;
+		const auto next_position = [&]() -> const std::pair<Board, bool>& {
+			position_i = position_i + 1 == positions.size() ? 0 : position_i + 1;
+			return positions[position_i];
+		};
+
+		const double ai_ns = time_ns([&](){
+			const auto& [board, is_x_turn] = next_position();
+			do_not_optimize(pick_value(ai, board, is_x_turn));
+		});
+		const double static_ns = time_ns([&](){
+			const auto& [board, is_x_turn] = next_position();
+			do_not_optimize(pick_value(static_ai, board, is_x_turn));
+		});
+		const double table_ns = time_ns([&](){
+			const auto& [board, is_x_turn] = next_position();
+			do_not_optimize(table.play(board, is_x_turn ? Board::Space::X : Board::Space::O));
+		});
+
+		evo::printlnCyan(
+			"tic-tac-toe move table {{9, 64, 1}} ({} bytes, built in {:.1f} ms)", table.data().size(), build_ms
+		);
+		evo::printlnGray("{:>14} {:>14} {:>14} {:>10} {:>10}", "AI", "StaticAI", "table", "speedup", "different");
+		evo::println(
+			"{:>14.1f} {:>14.1f} {:>14.1f} {:>9.1f}x {:>10}",
+			ai_ns, static_ns, table_ns, static_ns / table_ns, num_different
+		);
+		evo::printlnGray("(ns per move over the {} reachable positions, speedup vs StaticAI)", positions.size());
+	}
+
+
+}
@@ -0,0 +1,891 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <benchmarks.h>
+
+#include <Matrix.h>
+#include <AI.h>
+#include <Environment.h>
+#include <StaticAI.h>
+#include <QuantizedAI.h>
+#include <SparseAI.h>
+#include <StackedAI.h>
+#include <CompiledAI.h>
+#include <tic_tac_toe/board.h>
+#include <tic_tac_toe/policy_player.h>
+#include <connect_4/board.h>
+
+#include "./timing.h"
+
+
+
+namespace tigris::benchmarks{
+
+
+	auto aiCalculate() -> void {
+		static constexpr size_t NUM_INPUTS = 9;
+		static const auto dimensions = std::to_array<size_t>({NUM_INPUTS, 64, 1});
+
+		const auto ai = AI(dimensions);
+
+		auto inputs = std::vector<float>(NUM_INPUTS);
+		for(size_t i = 0; i < NUM_INPUTS; i+=1){
+			inputs[i] = float(int(i % 3) - 1);
+		}
+
+		// the forward pass as a GEMM per layer followed by a separate activation pass
+		const auto reference = [&]() -> Matrix {
+			auto output = Matrix(NUM_INPUTS, 1, evo::ArrayProxy<float>(inputs.data(), inputs.size()));
+			for(const Matrix& matrix : ai.getMatrices()){
+				output *= matrix;
+				for(float& value : output.data()){
+					value = std::tanh(value);
+				}
+			}
+			return output;
+		};
+
+		const double reference_ns = time_ns([&](){
+			const Matrix output = reference();
+			do_not_optimize(output);
+		});
+
+		const double calculate_ns = time_ns([&](){
+			const Matrix output = ai.calculate(std::vector<float>(inputs));
+			do_not_optimize(output);
+		});
+
+		const double workspace_ns = time_ns([&](){
+			const std::span<const float> output = ai.calculate(inputs);
+			do_not_optimize(output[0]);
+		});
+
+		const auto static_ai = StaticAI<NUM_INPUTS, 64, 1>(ai);
+		auto static_inputs = std::array<float, NUM_INPUTS>();
+		std::ranges::copy(inputs, static_inputs.begin());
+
+		const double static_ns = time_ns([&](){
+			const std::array<float, 1> output = static_ai.calculate(static_inputs);
+			do_not_optimize(output[0]);
+		});
+
+		const float error = std::abs(ai.calculate(inputs)[0] - reference()[0, 0]);
+		const float static_error = std::abs(static_ai.calculate(static_inputs)[0] - reference()[0, 0]);
+
+		evo::printlnCyan("AI::calculate {{9, 64, 1}}");
+		evo::printlnGray("{:<34} {:>12}", "path", "ns");
+		evo::println("{:<34} {:>12.1f}", "GEMM + activation pass", reference_ns);
+		evo::println("{:<34} {:>12.1f}", "AI::calculate (returns Matrix)", calculate_ns);
+		evo::println("{:<34} {:>12.1f}", "AI::calculate (workspace)", workspace_ns);
+		evo::println("{:<34} {:>12.1f}", "StaticAI::calculate", static_ns);
+		evo::println("{:<34} {:>12.2f}x (error: {})", "speedup (workspace)", reference_ns / workspace_ns, error);
+		evo::println("{:<34} {:>12.2f}x (error: {})", "speedup (StaticAI)", reference_ns / static_ns, static_error);
+	}
+
+
+	auto calculateBatch() -> void {
+		static constexpr size_t NUM_INPUTS = tic_tac_toe::Board::AI_DATA_SIZE;
+
+		const auto ai = AI(std::to_array<size_t>({NUM_INPUTS, 64, 1}), kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH);
+		const auto static_ai = StaticAI<NUM_INPUTS, 64, 1>(ai);
+
+		evo::printlnCyan("AI::calculateBatch {{9, 64, 1}} (ns per ply: encode every possible move, score, pick the best)");
+		evo::printlnGray(
+			"{:<8} {:>14} {:>14} {:>8} {:>14} {:>14} {:>8} {:>10}",
+			"moves", "AI loop", "AI batch", "speedup", "Static loop", "Static batch", "speedup", "max diff"
+		);
+
+		// a position with `num_moves` possible moves for X
+		const auto make_board = [](size_t num_moves) -> tic_tac_toe::Board {
+			auto board = tic_tac_toe::Board();
+			for(size_t i = 0; i < 9 - num_moves; i+=1){
+				const auto coordinate = tic_tac_toe::Board::Coordinate(uint8_t(i % 3), uint8_t(i / 3));
+				if(i % 2 == 0){ board.placeX(coordinate); }else{ board.placeO(coordinate); }
+			}
+			return board;
+		};
+
+		for(size_t num_moves : {9, 7, 5, 3}){
+			const std::vector<tic_tac_toe::Board> possible_moves = make_board(num_moves).getPossibleMovesForX();
+
+			const auto pick_loop = [&](const auto& player) -> size_t {
+				auto ai_data = std::array<float, NUM_INPUTS>();
+				auto results = std::vector<float>(possible_moves.size());
+
+				for(size_t i = 0; i < possible_moves.size(); i+=1){
+					possible_moves[i].getAIData(ai_data);
+					results[i] = player.calculate(ai_data)[0];
+				}
+
+				return size_t(std::distance(results.begin(), std::ranges::max_element(results)));
+			};
+
+			const auto pick_batch = [&](const auto& player) -> size_t {
+				// at most 9 possible moves, so the boards are encoded on the stack
+				auto ai_data = std::array<float, NUM_INPUTS * 9>();
+				for(size_t i = 0; i < possible_moves.size(); i+=1){
+					possible_moves[i].getAIData(std::span(&ai_data[i * NUM_INPUTS], NUM_INPUTS));
+				}
+
+				const ConstMatrixView results = player.calculateBatch(
+					ConstMatrixView(ai_data.data(), NUM_INPUTS, possible_moves.size())
+				);
+
+				size_t best_move = 0;
+				for(size_t i = 1; i < possible_moves.size(); i+=1){
+					if(results[0, i] > results[0, best_move]){ best_move = i; }
+				}
+				return best_move;
+			};
+
+			const double ai_loop_ns = time_ns([&](){ do_not_optimize(pick_loop(ai)); });
+			const double ai_batch_ns = time_ns([&](){ do_not_optimize(pick_batch(ai)); });
+			const double static_loop_ns = time_ns([&](){ do_not_optimize(pick_loop(static_ai)); });
+			const double static_batch_ns = time_ns([&](){ do_not_optimize(pick_batch(static_ai)); });
+
+			auto inputs = Matrix(NUM_INPUTS, possible_moves.size());
+			for(size_t i = 0; i < possible_moves.size(); i+=1){
+				possible_moves[i].getAIData(inputs.row(i));
+			}
+			float max_diff = 0.0f;
+			for(size_t i = 0; i < possible_moves.size(); i+=1){
+				max_diff = std::max(max_diff, std::abs(ai.calculate(inputs.row(i))[0] - ai.calculateBatch(inputs)[0, i]));
+				max_diff = std::max(
+					max_diff, std::abs(ai.calculate(inputs.row(i))[0] - static_ai.calculateBatch(inputs)[0, i])
+				);
+			}
+
+			evo::println(
+				"{:<8} {:>14.1f} {:>14.1f} {:>7.2f}x {:>14.1f} {:>14.1f} {:>7.2f}x {:>10}",
+				num_moves,
+				ai_loop_ns, ai_batch_ns, ai_loop_ns / ai_batch_ns,
+				static_loop_ns, static_batch_ns, static_loop_ns / static_batch_ns,
+				max_diff
+			);
+		}
+	}
+
+
+	auto policyHead() -> void {
+		static constexpr size_t NUM_INPUTS = tic_tac_toe::Board::AI_DATA_SIZE;
+		static constexpr size_t NUM_MOVES = tic_tac_toe::Board::NUM_MOVES;
+
+		const auto value_ai = AI(
+			std::to_array<size_t>({NUM_INPUTS, 64, 1}), kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH
+		);
+		const auto policy_ai = AI(
+			std::to_array<size_t>({NUM_INPUTS, 64, NUM_MOVES}), kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH
+		);
+		const auto static_value_ai = StaticAI<NUM_INPUTS, 64, 1>(value_ai);
+		const auto static_policy_ai = StaticAI<NUM_INPUTS, 64, NUM_MOVES>(policy_ai);
+
+		evo::printlnCyan(
+			"policy head {{9, 64, 9}} vs value head {{9, 64, 1}} (ns per ply: encode, forward pass(es), pick the move)"
+		);
+		evo::printlnGray(
+			"{:<8} {:>14} {:>14} {:>8} {:>14} {:>14} {:>8}",
+			"moves", "AI value", "AI policy", "speedup", "Static value", "Static policy", "speedup"
+		);
+
+		// a position with `num_moves` possible moves for X
+		const auto make_board = [](size_t num_moves) -> tic_tac_toe::Board {
+			auto board = tic_tac_toe::Board();
+			for(size_t i = 0; i < 9 - num_moves; i+=1){
+				const auto coordinate = tic_tac_toe::Board::Coordinate(uint8_t(i % 3), uint8_t(i / 3));
+				if(i % 2 == 0){ board.placeX(coordinate); }else{ board.placeO(coordinate); }
+			}
+			return board;
+		};
+
+		for(size_t num_moves : {9, 7, 5, 3}){
+			const tic_tac_toe::Board board = make_board(num_moves);
+
+			// every possible move scored with one batched forward pass (like `ai_play_tic_tac_toe` in main.cpp)
+			const auto pick_value = [&](const auto& player) -> size_t {
+				const std::vector<tic_tac_toe::Board> possible_moves = board.getPossibleMovesForX();
+
+				auto ai_data = std::array<float, NUM_INPUTS * 9>();
+				for(size_t i = 0; i < possible_moves.size(); i+=1){
+					possible_moves[i].getAIData(std::span(&ai_data[i * NUM_INPUTS], NUM_INPUTS));
+				}
+
+				const ConstMatrixView results = player.calculateBatch(
+					ConstMatrixView(ai_data.data(), NUM_INPUTS, possible_moves.size())
+				);
+
+				size_t best_move = 0;
+				for(size_t i = 1; i < possible_moves.size(); i+=1){
+					if(results[0, i] > results[0, best_move]){ best_move = i; }
+				}
+				return best_move;
+			};
+
+			// one forward pass on the current board
+			const auto pick_policy = [&](const auto& player) -> size_t {
+				return tic_tac_toe::pickPolicyMove(player, board, tic_tac_toe::Board::Space::X);
+			};
+
+			const double ai_value_ns = time_ns([&](){ do_not_optimize(pick_value(value_ai)); });
+			const double ai_policy_ns = time_ns([&](){ do_not_optimize(pick_policy(policy_ai)); });
+			const double static_value_ns = time_ns([&](){ do_not_optimize(pick_value(static_value_ai)); });
+			const double static_policy_ns = time_ns([&](){ do_not_optimize(pick_policy(static_policy_ai)); });
+
+			evo::println(
+				"{:<8} {:>14.1f} {:>14.1f} {:>7.2f}x {:>14.1f} {:>14.1f} {:>7.2f}x",
+				num_moves,
+				ai_value_ns, ai_policy_ns, ai_value_ns / ai_policy_ns,
+				static_value_ns, static_policy_ns, static_value_ns / static_policy_ns
+			);
+		}
+	}
+
+
+	auto accumulator() -> void {
+		///////////////////////////////////
+		// tic-tac-toe
+
+		static constexpr size_t NUM_INPUTS = tic_tac_toe::Board::AI_DATA_SIZE;
+
+		const auto ai = AI(
+			std::to_array<size_t>({NUM_INPUTS, 64, 1}), kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH
+		);
+		const auto static_ai = StaticAI<NUM_INPUTS, 64, 1>(ai);
+
+		evo::printlnCyan(
+			"accumulator {{9, 64, 1}} (ns per ply: score every possible move of X, batched after the first layer)"
+		);
+		evo::printlnGray(
+			"{:<8} {:>14} {:>14} {:>8} {:>14} {:>14} {:>8} {:>10}",
+			"moves", "AI batch", "AI accum", "speedup", "Static batch", "Static accum", "speedup", "max diff"
+		);
+
+		// a position with `num_moves` possible moves for X
+		const auto make_board = [](size_t num_moves) -> tic_tac_toe::Board {
+			auto board = tic_tac_toe::Board();
+			for(size_t i = 0; i < 9 - num_moves; i+=1){
+				const auto coordinate = tic_tac_toe::Board::Coordinate(uint8_t(i % 3), uint8_t(i / 3));
+				if(i % 2 == 0){ board.placeX(coordinate); }else{ board.placeO(coordinate); }
+			}
+			return board;
+		};
+
+		for(size_t num_moves : {9, 7, 5, 3}){
+			const tic_tac_toe::Board board = make_board(num_moves);
+
+			// every possible move encoded and scored with one batched forward pass (like main.cpp)
+			const auto score_batch = [&](const auto& player, std::span<float> scores) -> void {
+				const std::vector<tic_tac_toe::Board> possible_moves = board.getPossibleMovesForX();
+
+				auto ai_data = std::array<float, NUM_INPUTS * 9>();
+				for(size_t i = 0; i < possible_moves.size(); i+=1){
+					possible_moves[i].getAIData(std::span(&ai_data[i * NUM_INPUTS], NUM_INPUTS));
+				}
+
+				const ConstMatrixView results = player.calculateBatch(
+					ConstMatrixView(ai_data.data(), NUM_INPUTS, possible_moves.size())
+				);
+				for(size_t i = 0; i < possible_moves.size(); i+=1){
+					scores[i] = results[0, i];
+				}
+			};
+
+			// the current board encoded once, and each possible move is its space changed from 0 to 1 (X)
+			const auto get_moves = [&](std::array<size_t, 9>& moves) -> size_t {
+				const std::array<bool, tic_tac_toe::Board::NUM_MOVES> legal_moves = board.getLegalMoves();
+				size_t num_possible_moves = 0;
+				for(size_t move = 0; move < legal_moves.size(); move+=1){
+					if(legal_moves[move] == false){ continue; }
+					moves[num_possible_moves] = move;
+					num_possible_moves += 1;
+				}
+				return num_possible_moves;
+			};
+
+			auto ai_accumulator = AI::Accumulator();
+			const auto score_ai_accumulator = [&](std::span<float> scores) -> void {
+				auto ai_data = std::array<float, NUM_INPUTS>();
+				board.getAIData(ai_data);
+				ai.initAccumulator(ai_data, ai_accumulator);
+
+				auto moves = std::array<size_t, 9>();
+				const size_t num_possible_moves = get_moves(moves);
+				const ConstMatrixView results = ai.calculateBatch(
+					ai_accumulator, std::span(moves.data(), num_possible_moves), 1.0f
+				);
+				for(size_t i = 0; i < num_possible_moves; i+=1){
+					scores[i] = results[0, i];
+				}
+			};
+
+			const auto score_static_accumulator = [&](std::span<float> scores) -> void {
+				auto ai_data = std::array<float, NUM_INPUTS>();
+				board.getAIData(ai_data);
+				const auto accumulator = static_ai.makeAccumulator(ai_data);
+
+				auto moves = std::array<size_t, 9>();
+				const size_t num_possible_moves = get_moves(moves);
+				const ConstMatrixView results = static_ai.calculateBatch(
+					accumulator, std::span(moves.data(), num_possible_moves), 1.0f
+				);
+				for(size_t i = 0; i < num_possible_moves; i+=1){
+					scores[i] = results[0, i];
+				}
+			};
+
+			auto scores = std::array<float, 9>();
+			const double ai_batch_ns = time_ns([&](){ score_batch(ai, scores); do_not_optimize(scores[0]); });
+			const double ai_accumulator_ns = time_ns([&](){ score_ai_accumulator(scores); do_not_optimize(scores[0]); });
+			const double static_batch_ns = time_ns([&](){ score_batch(static_ai, scores); do_not_optimize(scores[0]); });
+			const double static_accumulator_ns = time_ns([&](){
+				score_static_accumulator(scores);
+				do_not_optimize(scores[0]);
+			});
+
+			// possible moves are in the order of the spaces, so the scores line up
+			auto expected = std::array<float, 9>();
+			score_batch(ai, expected);
+			float max_diff = 0.0f;
+			score_ai_accumulator(scores);
+			for(size_t i = 0; i < num_moves; i+=1){ max_diff = std::max(max_diff, std::abs(scores[i] - expected[i])); }
+			score_static_accumulator(scores);
+			for(size_t i = 0; i < num_moves; i+=1){ max_diff = std::max(max_diff, std::abs(scores[i] - expected[i])); }
+
+			evo::println(
+				"{:<8} {:>14.1f} {:>14.1f} {:>7.2f}x {:>14.1f} {:>14.1f} {:>7.2f}x {:>10}",
+				num_moves,
+				ai_batch_ns, ai_accumulator_ns, ai_batch_ns / ai_accumulator_ns,
+				static_batch_ns, static_accumulator_ns, static_batch_ns / static_accumulator_ns,
+				max_diff
+			);
+		}
+
+
+		///////////////////////////////////
+		// connect 4 sized
+
+		static constexpr size_t NUM_CHILDREN = connect_4::Board::NUM_MOVES;
+
+		evo::printlnCyan("accumulator, {} children that each change 1 of 42 inputs (ns per ply)", NUM_CHILDREN);
+		evo::printlnGray("{:<24} {:>14} {:>14} {:>8} {:>10}", "dimensions", "AI batch", "AI accum", "speedup", "max diff");
+
+		const auto run = [&](std::string_view name, evo::ArrayProxy<size_t> dimensions){
+			const auto connect_4_ai = AI(dimensions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH);
+			const size_t num_inputs = dimensions.front();
+
+			// the children drop a piece into an empty space
+			auto parent = std::vector<float>(num_inputs);
+			for(size_t i = 0; i < num_inputs; i+=1){
+				parent[i] = i < 14 ? float(int(i % 2) * 2 - 1) : 0.0f;
+			}
+			auto child_indices = std::array<size_t, NUM_CHILDREN>();
+			for(size_t i = 0; i < NUM_CHILDREN; i+=1){
+				child_indices[i] = 14 + i;
+			}
+
+			auto children = Matrix(num_inputs, NUM_CHILDREN);
+			const auto score_batch = [&](std::span<float> scores) -> void {
+				for(size_t i = 0; i < NUM_CHILDREN; i+=1){
+					std::ranges::copy(parent, children.row(i).begin());
+					children[child_indices[i], i] = 1.0f;
+				}
+
+				const ConstMatrixView results = connect_4_ai.calculateBatch(children);
+				for(size_t i = 0; i < NUM_CHILDREN; i+=1){
+					scores[i] = results[0, i];
+				}
+			};
+
+			auto accumulator = AI::Accumulator();
+			const auto score_accumulator = [&](std::span<float> scores) -> void {
+				connect_4_ai.initAccumulator(parent, accumulator);
+
+				const ConstMatrixView results = connect_4_ai.calculateBatch(accumulator, child_indices, 1.0f);
+				for(size_t i = 0; i < NUM_CHILDREN; i+=1){
+					scores[i] = results[0, i];
+				}
+			};
+
+			auto scores = std::array<float, NUM_CHILDREN>();
+			const double batch_ns = time_ns([&](){ score_batch(scores); do_not_optimize(scores[0]); });
+			const double accumulator_ns = time_ns([&](){ score_accumulator(scores); do_not_optimize(scores[0]); });
+
+			auto expected = std::array<float, NUM_CHILDREN>();
+			score_batch(expected);
+			score_accumulator(scores);
+			float max_diff = 0.0f;
+			for(size_t i = 0; i < NUM_CHILDREN; i+=1){ max_diff = std::max(max_diff, std::abs(scores[i] - expected[i])); }
+
+			evo::println(
+				"{:<24} {:>14.1f} {:>14.1f} {:>7.2f}x {:>10}",
+				name, batch_ns, accumulator_ns, batch_ns / accumulator_ns, max_diff
+			);
+		};
+
+		run("{42, 128, 1}", std::to_array<size_t>({42, 128, 1}));
+		run("{42, 128, 128, 1}", std::to_array<size_t>({42, 128, 128, 1}));
+		run("{42, 512, 1}", std::to_array<size_t>({42, 512, 1}));
+		run("{42, 512, 512, 7}", std::to_array<size_t>({42, 512, 512, 7}));
+	}
+
+
+	auto bitplanes() -> void {
+		evo::printlnCyan(
+			"bitplane inputs (implementation: {}, ns per inference: dense GEMV vs sum of the rows of the set bits)",
+			kernels::bitplaneImplementationName()
+		);
+		evo::printlnGray(
+			"{:<24} {:>8} {:>12} {:>12} {:>8} {:>12} {:>12} {:>8} {:>10}",
+			"board", "pieces", "AI dense", "AI bits", "speedup", "Static dense", "Static bits", "speedup", "max diff"
+		);
+
+		const auto run = [&]<size_t... DIMENSIONS>(std::string_view name, size_t num_pieces, const auto& board){
+			static constexpr auto dimensions = std::to_array<size_t>({DIMENSIONS...});
+			static constexpr size_t NUM_INPUTS = dimensions.front();
+
+			const auto ai = AI(dimensions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH);
+			const auto static_ai = StaticAI<DIMENSIONS...>(ai);
+
+			using Board = std::remove_cvref_t<decltype(board)>;
+			const auto player = Board::Space::X;
+
+			// the dense inputs are the same planes as 0 / 1 floats
+			auto dense_inputs = std::array<float, NUM_INPUTS>();
+			const auto ai_dense = [&]() -> float {
+				board.getBitplaneAIData(dense_inputs, player);
+				return ai.calculate(dense_inputs)[0];
+			};
+			const auto ai_bits = [&]() -> float {
+				const typename Board::Bitplanes bits = board.getBitplanes(player);
+				return ai.calculate(std::span<const uint64_t>(bits))[0];
+			};
+			const auto static_dense = [&]() -> float {
+				board.getBitplaneAIData(dense_inputs, player);
+				return static_ai.calculate(dense_inputs)[0];
+			};
+			const auto static_bits = [&]() -> float {
+				const typename Board::Bitplanes bits = board.getBitplanes(player);
+				return static_ai.calculate(std::span<const uint64_t>(bits))[0];
+			};
+
+			const double ai_dense_ns = time_ns([&](){ do_not_optimize(ai_dense()); });
+			const double ai_bits_ns = time_ns([&](){ do_not_optimize(ai_bits()); });
+			const double static_dense_ns = time_ns([&](){ do_not_optimize(static_dense()); });
+			const double static_bits_ns = time_ns([&](){ do_not_optimize(static_bits()); });
+
+			const float expected = ai_dense();
+			const float max_diff = std::max(std::abs(ai_bits() - expected), std::abs(static_bits() - expected));
+
+			evo::println(
+				"{:<24} {:>8} {:>12.1f} {:>12.1f} {:>7.2f}x {:>12.1f} {:>12.1f} {:>7.2f}x {:>10}",
+				name, num_pieces,
+				ai_dense_ns, ai_bits_ns, ai_dense_ns / ai_bits_ns,
+				static_dense_ns, static_bits_ns, static_dense_ns / static_bits_ns,
+				max_diff
+			);
+		};
+
+		for(size_t num_pieces : {0, 3, 6, 8}){
+			auto board = tic_tac_toe::Board();
+			for(size_t i = 0; i < num_pieces; i+=1){
+				const auto coordinate = tic_tac_toe::Board::Coordinate(i / 3, i % 3);
+				if(i % 2 == 0){ board.placeX(coordinate); }else{ board.placeO(coordinate); }
+			}
+
+			run.template operator()<18, 64, 1>("tic-tac-toe {18, 64, 1}", num_pieces, board);
+		}
+
+		for(size_t num_pieces : {0, 10, 20, 40}){
+			auto board = connect_4::Board();
+			for(size_t i = 0; i < num_pieces; i+=1){
+				// fills the collumns from the sides in, alternating players
+				const size_t collumn = (i / 6 % 2 == 0) ? i / 12 : 6 - i / 12;
+				if(i % 2 == 0){ board.placeX(collumn); }else{ board.placeO(collumn); }
+			}
+
+			run.template operator()<84, 128, 1>("connect 4 {84, 128, 1}", num_pieces, board);
+			run.template operator()<84, 512, 1>("connect 4 {84, 512, 1}", num_pieces, board);
+		}
+	}
+
+
+	auto compiledAI() -> void {
+		// a new cache directory, so the first AI of each shape is compiled
+		auto options = CodegenOptions();
+		options.cacheDirectory = std::filesystem::temp_directory_path() / std::format(
+			"tigris_codegen_benchmark_{}", std::chrono::steady_clock::now().time_since_epoch().count()
+		);
+
+		evo::printlnCyan("CompiledAI (ns per inference, compile time in ms)");
+		evo::printlnGray(
+			"{:<20} {:>10} {:>10} {:>12} {:>12} {:>8} {:>12} {:>10}",
+			"dimensions", "compile", "cached", "AI", "compiled", "speedup", "StaticAI", "max diff"
+		);
+
+		const auto run = [&]<size_t... DIMENSIONS>(std::string_view name){
+			static constexpr auto dimensions = std::to_array<size_t>({DIMENSIONS...});
+
+			const auto ai = AI(dimensions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH);
+			const auto static_ai = StaticAI<DIMENSIONS...>(ai);
+
+			const auto compile_start = std::chrono::steady_clock::now();
+			const auto compiled_ai = CompiledAI(ai, options);
+			const double compile_ms = std::chrono::duration<double, std::milli>(
+				std::chrono::steady_clock::now() - compile_start
+			).count();
+
+			// another AI of the same shape uses the same function
+			const auto cached_start = std::chrono::steady_clock::now();
+			const auto other_compiled_ai = CompiledAI(
+				AI(dimensions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH), options
+			);
+			const double cached_ms = std::chrono::duration<double, std::milli>(
+				std::chrono::steady_clock::now() - cached_start
+			).count();
+
+			auto inputs = std::array<float, dimensions.front()>();
+			for(size_t i = 0; i < inputs.size(); i+=1){
+				inputs[i] = float(int(i % 3) - 1) * 0.1f;
+			}
+
+			const double ai_ns = time_ns([&](){ do_not_optimize(ai.calculate(inputs)[0]); });
+			const double compiled_ns = time_ns([&](){ do_not_optimize(compiled_ai.calculate(inputs)[0]); });
+			const double static_ns = time_ns([&](){ do_not_optimize(static_ai.calculate(inputs)[0]); });
+
+			float max_diff = 0.0f;
+			const std::span<const float> expected = ai.calculate(inputs);
+			const auto expected_outputs = std::vector<float>(expected.begin(), expected.end());
+			const std::span<const float> outputs = compiled_ai.calculate(inputs);
+			for(size_t i = 0; i < outputs.size(); i+=1){
+				max_diff = std::max(max_diff, std::abs(outputs[i] - expected_outputs[i]));
+			}
+
+			evo::println(
+				"{:<20} {:>10.1f} {:>10.3f} {:>12.1f} {:>12.1f} {:>7.2f}x {:>12.1f} {:>10}",
+				compiled_ai.isCompiled() && other_compiled_ai.isCompiled() ? name : std::format("{} (not compiled)", name),
+				compile_ms, cached_ms, ai_ns, compiled_ns, ai_ns / compiled_ns, static_ns, max_diff
+			);
+		};
+
+		run.template operator()<9, 64, 1>("{9, 64, 1}");
+		run.template operator()<42, 128, 1>("{42, 128, 1}");
+		run.template operator()<42, 128, 128, 7>("{42, 128, 128, 7}");
+		run.template operator()<84, 512, 1>("{84, 512, 1}");
+
+		auto error_code = std::error_code();
+		std::filesystem::remove_all(options.cacheDirectory, error_code);
+
+
+		///////////////////////////////////
+		// no compiler
+
+		auto no_compiler = options;
+		no_compiler.compiler = "tigris-missing-compiler";
+
+		const auto ai = AI(std::to_array<size_t>({9, 32, 1}), kernels::WeightPrecision::FP32, kernels::Activation::TANH);
+		const auto fallback = CompiledAI(ai, no_compiler);
+		auto inputs = std::array<float, 9>{1, 0, -1, 0, 1, 0, -1, 0, 1};
+		const float expected = ai.calculate(inputs)[0];
+		evo::println(
+			"without a compiler: compiled: {}, same output as AI: {}",
+			fallback.isCompiled(), fallback.calculate(inputs)[0] == expected
+		);
+		std::filesystem::remove_all(options.cacheDirectory, error_code);
+	}
+
+
+	auto stackedAI() -> void {
+		static constexpr size_t POPULATION = 256;
+		static constexpr size_t NUM_BOARDS = 9;
+
+		evo::printlnCyan(
+			"StackedAI (implementation: {}, {} AIs, {} boards, ns per population)",
+			kernels::stackedImplementationName(), POPULATION, NUM_BOARDS
+		);
+		evo::printlnGray(
+			"{:<20} {:>14} {:>14} {:>14} {:>8} {:>10}",
+			"dimensions", "AI loop", "AI batch", "stacked", "speedup", "max diff"
+		);
+
+		const auto run = [&]<size_t... DIMENSIONS>(std::string_view name){
+			static const auto dimensions = std::to_array<size_t>({DIMENSIONS...});
+
+			auto environment = Environment(
+				POPULATION, dimensions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH
+			);
+			environment.initRandom(12);
+			const StackedAI stacked_ai = environment.stackPopulation();
+
+			auto inputs = Matrix(dimensions.front(), NUM_BOARDS);
+			for(size_t b = 0; b < NUM_BOARDS; b+=1){
+				for(size_t i = 0; i < dimensions.front(); i+=1){
+					inputs[i, b] = float(int((i + b) % 3) - 1);
+				}
+			}
+
+			auto population = std::vector<AI>();
+			population.reserve(POPULATION);
+			for(size_t g = 0; g < POPULATION; g+=1){
+				population.emplace_back(environment.getAI(g));
+			}
+
+			const double loop_ns = time_ns([&](){
+				for(const AI& ai : population){
+					for(size_t b = 0; b < NUM_BOARDS; b+=1){
+						do_not_optimize(ai.calculate(inputs.row(b))[0]);
+					}
+				}
+			});
+
+			const double batch_ns = time_ns([&](){
+				for(const AI& ai : population){
+					do_not_optimize(ai.calculateBatch(inputs)[0, 0]);
+				}
+			});
+
+			const double stacked_ns = time_ns([&](){
+				do_not_optimize(stacked_ai.calculate(inputs)[0, 0]);
+			});
+
+			const ConstMatrixView outputs = stacked_ai.calculate(inputs);
+			const size_t num_outputs = dimensions.back();
+			float max_diff = 0.0f;
+			for(size_t g = 0; g < POPULATION; g+=1){
+				for(size_t b = 0; b < NUM_BOARDS; b+=1){
+					const std::span<const float> expected = population[g].calculate(inputs.row(b));
+					for(size_t o = 0; o < num_outputs; o+=1){
+						max_diff = std::max(max_diff, std::abs(outputs[g, b * num_outputs + o] - expected[o]));
+					}
+				}
+			}
+
+			evo::println(
+				"{:<20} {:>14.0f} {:>14.0f} {:>14.0f} {:>7.2f}x {:>10}",
+				name, loop_ns, batch_ns, stacked_ns, std::min(loop_ns, batch_ns) / stacked_ns, max_diff
+			);
+		};
+
+		run.template operator()<9, 64, 1>("{9, 64, 1}");
+		run.template operator()<9, 16, 16, 9>("{9, 16, 16, 9}");
+		run.template operator()<42, 64, 64, 1>("{42, 64, 64, 1}");
+		run.template operator()<42, 128, 128, 1>("{42, 128, 128, 1}");
+	}
+
+
+	auto weightPrecision() -> void {
+		static constexpr size_t POPULATION = 2048;
+		static const auto dimensions = std::to_array<size_t>({42, 128, 128, 1});
+
+		auto fp32_population = std::vector<AI>();
+		fp32_population.reserve(POPULATION);
+		for(size_t i = 0; i < POPULATION; i+=1){
+			fp32_population.emplace_back(dimensions);
+		}
+
+		auto inputs = std::vector<float>(dimensions.front());
+		for(size_t i = 0; i < inputs.size(); i+=1){
+			inputs[i] = float(int(i % 3) - 1);
+		}
+
+		auto fp32_outputs = std::vector<float>();
+		for(const AI& ai : fp32_population){
+			fp32_outputs.emplace_back(ai.calculate(inputs)[0]);
+		}
+
+		evo::printlnCyan("weight precision ({} AIs of {{42, 128, 128, 1}})", POPULATION);
+		evo::printlnGray("{:<10} {:>12} {:>16} {:>12}", "precision", "MiB", "ns / population", "max error");
+
+		const auto run = [&](std::string_view name, kernels::WeightPrecision precision){
+			auto population = std::vector<AI>();
+			population.reserve(POPULATION);
+			for(const AI& ai : fp32_population){
+				population.emplace_back(ai.withPrecision(precision));
+			}
+
+			size_t weight_bytes = 0;
+			float max_error = 0.0f;
+			for(size_t i = 0; i < POPULATION; i+=1){
+				weight_bytes += population[i].weightBytes();
+				max_error = std::max(max_error, std::abs(population[i].calculate(inputs)[0] - fp32_outputs[i]));
+			}
+
+			const double population_ns = time_ns([&](){
+				for(const AI& ai : population){
+					do_not_optimize(ai.calculate(inputs)[0]);
+				}
+			});
+
+			evo::println(
+				"{:<10} {:>12.2f} {:>16.0f} {:>12}",
+				name, double(weight_bytes) / double(1 << 20), population_ns, max_error
+			);
+		};
+
+		run("fp32", kernels::WeightPrecision::FP32);
+		run("bf16", kernels::WeightPrecision::BF16);
+		run("fp16", kernels::WeightPrecision::FP16);
+	}
+
+
+	auto quantizedAI() -> void {
+		static constexpr size_t NUM_AIS = 50;
+		static constexpr size_t NUM_GAMES_PER_AI = 200;
+
+		///////////////////////////////////
+		// move agreement
+
+		// X picks the move with the highest output (like the players in main.cpp)
+		const auto pick_move = [](const auto& ai, evo::ArrayProxy<tic_tac_toe::Board> possible_moves) -> size_t {
+			auto ai_data = std::array<float, tic_tac_toe::Board::AI_DATA_SIZE>();
+
+			size_t best_move = 0;
+			float best_result = -std::numeric_limits<float>::infinity();
+			for(size_t i = 0; i < possible_moves.size(); i+=1){
+				possible_moves[i].getAIData(ai_data);
+				const float result = ai.calculate(ai_data)[0];
+				if(result > best_result){
+					best_result = result;
+					best_move = i;
+				}
+			}
+			return best_move;
+		};
+
+		size_t num_positions = 0;
+		size_t num_agreements = 0;
+		for(size_t ai_i = 0; ai_i < NUM_AIS; ai_i+=1){
+			const auto ai = AI(std::to_array<size_t>({tic_tac_toe::Board::AI_DATA_SIZE, 64, 1}));
+			const auto quantized_ai = QuantizedAI(ai);
+
+			// positions come from games where both sides play randomly
+			for(size_t game_i = 0; game_i < NUM_GAMES_PER_AI; game_i+=1){
+				auto board = tic_tac_toe::Board();
+				bool is_x_turn = true;
+
+				while(board.getGameStatus() == tic_tac_toe::Board::GameStatus::IN_PROGRESS){
+					const std::vector<tic_tac_toe::Board> possible_moves = is_x_turn
+						? board.getPossibleMovesForX()
+						: board.getPossibleMovesForO();
+
+					if(is_x_turn){
+						num_positions += 1;
+						if(pick_move(ai, possible_moves) == pick_move(quantized_ai, possible_moves)){
+							num_agreements += 1;
+						}
+					}
+
+					board = possible_moves[size_t(evo::random01() * double(possible_moves.size())) % possible_moves.size()];
+					is_x_turn = !is_x_turn;
+				}
+			}
+		}
+
+		evo::printlnCyan("QuantizedAI ({})", kernels::int8ImplementationName());
+		evo::println(
+			"move agreement with fp32: {}/{} ({:.2f}%)",
+			num_agreements, num_positions, 100.0 * double(num_agreements) / double(num_positions)
+		);
+
+
+		///////////////////////////////////
+		// inferences per second
+
+		evo::printlnGray("{:<20} {:>14} {:>14} {:>14}", "dimensions", "fp32 ns", "int8 ns", "speedup");
+
+		const auto run = [&]<size_t... DIMENSIONS>(std::string_view name){
+			static const auto dimensions = std::to_array<size_t>({DIMENSIONS...});
+
+			const auto ai = AI(dimensions);
+			const auto quantized_ai = QuantizedAI(ai);
+
+			auto inputs = std::vector<float>(dimensions.front());
+			for(size_t i = 0; i < inputs.size(); i+=1){
+				inputs[i] = float(int(i % 3) - 1);
+			}
+
+			const double fp32_ns = time_ns([&](){
+				do_not_optimize(ai.calculate(inputs)[0]);
+			});
+
+			const double int8_ns = time_ns([&](){
+				do_not_optimize(quantized_ai.calculate(inputs)[0]);
+			});
+
+			evo::println(
+				"{:<20} {:>14.1f} {:>14.1f} {:>13.2f}x",
+				name, fp32_ns, int8_ns, fp32_ns / int8_ns
+			);
+		};
+
+		run.template operator()<9, 64, 1>("{9, 64, 1}");
+		run.template operator()<42, 128, 128, 1>("{42, 128, 128, 1}");
+		run.template operator()<42, 512, 512, 7>("{42, 512, 512, 7}");
+	}
+
+
+	auto sparseAI() -> void {
+		static constexpr auto sparsities = std::to_array<float>({0.5f, 0.75f, 0.9f, 0.95f, 0.99f});
+
+		evo::printlnCyan("SparseAI (implementation: {}, ns per inference)", kernels::spmvImplementationName());
+		evo::printlnGray(
+			"{:<24} {:>8} {:>12} {:>12} {:>8} {:>12} {:>10}",
+			"dimensions", "sparsity", "dense ns", "sparse ns", "speedup", "weight KiB", "max diff"
+		);
+
+		const auto run = [&]<size_t... DIMENSIONS>(std::string_view name){
+			static const auto dimensions = std::to_array<size_t>({DIMENSIONS...});
+
+			const auto ai = AI(dimensions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH);
+
+			auto inputs = std::vector<float>(dimensions.front());
+			for(size_t i = 0; i < inputs.size(); i+=1){
+				inputs[i] = float(int(i % 3) - 1);
+			}
+
+			const double dense_ns = time_ns([&](){
+				do_not_optimize(ai.calculate(inputs)[0]);
+			});
+
+			for(float sparsity : sparsities){
+				const auto sparse_ai = SparseAI(ai, sparsity);
+
+				const double sparse_ns = time_ns([&](){
+					do_not_optimize(sparse_ai.calculate(inputs)[0]);
+				});
+
+				// against a dense forward pass with the same weights dropped
+				auto expected = Matrix(inputs.size(), 1, inputs);
+				for(const SparseMatrix& layer : sparse_ai.getLayers()){
+					expected = expected * layer.toMatrix();
+					for(float& value : expected.row(0)){
+						value = kernels::fastTanh(value);
+					}
+				}
+
+				const std::span<const float> outputs = sparse_ai.calculate(inputs);
+				float max_diff = 0.0f;
+				for(size_t i = 0; i < outputs.size(); i+=1){
+					max_diff = std::max(max_diff, std::abs(outputs[i] - expected[i, 0]));
+				}
+
+				evo::println(
+					"{:<24} {:>8.2f} {:>12.1f} {:>12.1f} {:>7.2f}x {:>12.1f} {:>10}",
+					name, sparsity, dense_ns, sparse_ns, dense_ns / sparse_ns,
+					double(sparse_ai.weightBytes()) / 1024.0, max_diff
+				);
+			}
+		};
+
+		run.template operator()<9, 64, 1>("{9, 64, 1}");
+		run.template operator()<42, 128, 128, 1>("{42, 128, 128, 1}");
+		run.template operator()<42, 512, 512, 7>("{42, 512, 512, 7}");
+		run.template operator()<42, 2048, 2048, 7>("{42, 2048, 2048, 7}");
+	}
+
+
+}
@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <benchmarks.h>
+
+#include <Matrix.h>
+#include <AI.h>
+#include <ThreadPool.h>
+#include <kernels/gemm.h>
+#include <kernels/activation.h>
+
+#include "./timing.h"
+
+
+
+namespace tigris::benchmarks{
+
+
+	auto gemm() -> void {
+		struct Shape{
+			std::string_view name;
+			size_t m;
+			size_t k;
+			size_t n;
+		};
+
+		static constexpr auto shapes = std::to_array<Shape>({
+			{"tic-tac-toe  {9, 64, 1} layer 0", 1, 9, 64},
+			{"tic-tac-toe  {9, 64, 1} layer 1", 1, 64, 1},
+			{"tic-tac-toe  9 boards   layer 0", 9, 9, 64},
+			{"tic-tac-toe  9 boards   layer 1", 9, 64, 1},
+			{"connect-4    {42, 64}   layer 0", 1, 42, 64},
+			{"connect-4    7 boards   layer 0", 7, 42, 64},
+			{"connect-4    7 boards   {42, 256}", 7, 42, 256},
+			{"square                  256", 256, 256, 256},
+		});
+
+		evo::printlnCyan("GEMM (implementation: {})", kernels::gemmImplementationName());
+		evo::printlnGray("{:<34} {:>12} {:>12} {:>8} {:>12}", "shape (m x k x n)", "naive ns", "kernel ns", "speedup", "err / bound");
+
+		for(const Shape& shape : shapes){
+			const Matrix lhs = Matrix::random(shape.k, shape.m);
+			const Matrix rhs = Matrix::random(shape.n, shape.k);
+
+			const double naive_ns = time_ns([&](){
+				auto output = Matrix(shape.n, shape.m);
+				kernels::gemmReference(
+					&lhs[0, 0], lhs.stride(),
+					&rhs[0, 0], rhs.stride(),
+					&output[0, 0], output.stride(),
+					shape.m, shape.n, shape.k
+				);
+				do_not_optimize(output);
+			});
+
+			const double kernel_ns = time_ns([&](){
+				const Matrix output = lhs * rhs;
+				do_not_optimize(output);
+			});
+
+
+			// check against the documented tolerance in kernels/gemm.h
+			const Matrix output = lhs * rhs;
+			float worst_error_ratio = 0.0f;
+			for(size_t y = 0; y < shape.m; y+=1){
+				for(size_t x = 0; x < shape.n; x+=1){
+					double expected = 0.0;
+					double magnitude = 0.0;
+					for(size_t i = 0; i < shape.k; i+=1){
+						expected += double(lhs[i, y]) * double(rhs[x, i]);
+						magnitude += std::abs(double(lhs[i, y]) * double(rhs[x, i]));
+					}
+
+					const double bound = double(shape.k) * double(std::numeric_limits<float>::epsilon()) * magnitude;
+					const double error = std::abs(double(output[x, y]) - expected);
+					if(bound > 0.0){ worst_error_ratio = std::max(worst_error_ratio, float(error / bound)); }
+				}
+			}
+
+			evo::print("{:<34} {:>12.1f} {:>12.1f} {:>7.2f}x ", shape.name, naive_ns, kernel_ns, naive_ns / kernel_ns);
+			if(worst_error_ratio <= 1.0f){
+				evo::printlnGreen("{:>12.4f}", worst_error_ratio);
+			}else{
+				evo::printlnRed("{:>12.4f}", worst_error_ratio);
+			}
+		}
+	}
+
+
+	auto gemmParallel() -> void {
+		struct Shape{
+			std::string_view name;
+			size_t m;
+			size_t k;
+			size_t n;
+		};
+
+		static constexpr auto shapes = std::to_array<Shape>({
+			{"connect-4    512 boards {42, 256}", 512, 42, 256},
+			{"connect-4    64 boards  {256, 256}", 64, 256, 256},
+			{"square                  256", 256, 256, 256},
+			{"square                  512", 512, 512, 512},
+		});
+
+		const bool calibrated = kernels::calibrateParallelGEMM();
+
+		evo::printlnCyan(
+			"Parallel GEMM (threads: {}, threshold: {} m*n*k{})",
+			ThreadPool::get().numThreads(),
+			kernels::parallelGEMMThreshold(),
+			calibrated ? "" : ", not calibrated"
+		);
+		evo::printlnGray("{:<34} {:>12} {:>12} {:>8} {:>12}", "shape (m x k x n)", "serial ns", "parallel ns", "speedup", "max diff");
+
+		for(const Shape& shape : shapes){
+			const Matrix lhs = Matrix::random(shape.k, shape.m);
+			const Matrix rhs = Matrix::random(shape.n, shape.k);
+			auto serial_output = Matrix(shape.n, shape.m);
+			auto parallel_output = Matrix(shape.n, shape.m);
+
+			const double serial_ns = time_ns([&](){
+				kernels::gemm(
+					&lhs[0, 0], lhs.stride(),
+					&rhs[0, 0], rhs.stride(),
+					&serial_output[0, 0], serial_output.stride(),
+					shape.m, shape.n, shape.k
+				);
+				do_not_optimize(serial_output);
+			});
+
+			const double parallel_ns = time_ns([&](){
+				Matrix::multiplyInto(parallel_output, lhs, rhs);
+				do_not_optimize(parallel_output);
+			});
+
+			float max_diff = 0.0f;
+			for(size_t y = 0; y < shape.m; y+=1){
+				for(size_t x = 0; x < shape.n; x+=1){
+					max_diff = std::max(max_diff, std::abs(serial_output[x, y] - parallel_output[x, y]));
+				}
+			}
+
+			evo::println(
+				"{:<34} {:>12.1f} {:>12.1f} {:>7.2f}x {:>12}",
+				shape.name, serial_ns, parallel_ns, serial_ns / parallel_ns, max_diff
+			);
+		}
+	}
+
+
+	auto gemmBatched() -> void {
+		struct Shape{
+			std::string_view name;
+			size_t m;
+			size_t k;
+			size_t n;
+		};
+
+		static constexpr auto shapes = std::to_array<Shape>({
+			{"tic-tac-toe  {9, 64, 1} layer 0", 1, 9, 64},
+			{"tic-tac-toe  {9, 64, 1} layer 1", 1, 64, 1},
+			{"tic-tac-toe  9 boards   layer 0", 9, 9, 64},
+			{"tic-tac-toe  9 boards   layer 1", 9, 64, 1},
+			{"connect-4    7 boards   layer 0", 7, 42, 64},
+		});
+
+		// one product per network, each with its own matrices
+		static constexpr size_t BATCH_SIZE = 1024;
+
+		evo::printlnCyan("Batched GEMM ({} independent products, ns per product)", BATCH_SIZE);
+		evo::printlnGray(
+			"{:<34} {:>12} {:>12} {:>12} {:>8} {:>10}",
+			"shape (m x k x n)", "operator*", "gemm loop", "batched", "speedup", "max diff"
+		);
+
+		for(const Shape& shape : shapes){
+			auto lhs = std::vector<Matrix>();
+			auto rhs = std::vector<Matrix>();
+			auto outputs = std::vector<Matrix>();
+			for(size_t i = 0; i < BATCH_SIZE; i+=1){
+				lhs.emplace_back(Matrix::random(shape.k, shape.m));
+				rhs.emplace_back(Matrix::random(shape.n, shape.k));
+				outputs.emplace_back(shape.n, shape.m);
+			}
+
+			const auto lhs_views = std::vector<ConstMatrixView>(lhs.begin(), lhs.end());
+			const auto rhs_views = std::vector<ConstMatrixView>(rhs.begin(), rhs.end());
+			const auto output_views = std::vector<MatrixView>(outputs.begin(), outputs.end());
+
+			const double operator_ns = time_ns([&](){
+				for(size_t i = 0; i < BATCH_SIZE; i+=1){
+					const Matrix output = lhs[i] * rhs[i];
+					do_not_optimize(output);
+				}
+			});
+
+			const double loop_ns = time_ns([&](){
+				for(size_t i = 0; i < BATCH_SIZE; i+=1){
+					Matrix::multiplyInto(outputs[i], lhs[i], rhs[i]);
+				}
+				do_not_optimize(outputs);
+			});
+
+			const double batched_ns = time_ns([&](){
+				Matrix::multiplyBatched(output_views, lhs_views, rhs_views);
+				do_not_optimize(outputs);
+			});
+
+			float max_diff = 0.0f;
+			for(size_t i = 0; i < BATCH_SIZE; i+=1){
+				const Matrix expected = lhs[i] * rhs[i];
+				for(size_t y = 0; y < shape.m; y+=1){
+					for(size_t x = 0; x < shape.n; x+=1){
+						max_diff = std::max(max_diff, std::abs(expected[x, y] - outputs[i][x, y]));
+					}
+				}
+			}
+
+			const double batch_size = double(BATCH_SIZE);
+			evo::println(
+				"{:<34} {:>12.1f} {:>12.1f} {:>12.1f} {:>7.2f}x {:>10}",
+				shape.name,
+				operator_ns / batch_size,
+				loop_ns / batch_size,
+				batched_ns / batch_size,
+				operator_ns / batched_ns,
+				max_diff
+			);
+		}
+	}
+
+
+	auto activations() -> void {
+		static constexpr size_t NUM_VALUES = 1 << 20;
+		static constexpr float RANGE = 12.0f;
+
+		// evenly spaced over [-RANGE, RANGE]
+		auto inputs = std::vector<float>(NUM_VALUES);
+		for(size_t i = 0; i < NUM_VALUES; i+=1){
+			inputs[i] = -RANGE + 2.0f * RANGE * float(i) / float(NUM_VALUES - 1);
+		}
+		auto outputs = std::vector<float>(NUM_VALUES);
+
+		evo::printlnCyan("activations ({} values in [-{}, {}])", NUM_VALUES, RANGE, RANGE);
+		evo::printlnGray("{:<14} {:>12} {:>14} {:>14}", "activation", "ns / value", "max abs error", "max rel error");
+
+		const auto run = [&](std::string_view name, kernels::Activation activation, kernels::Activation reference){
+			const double total_ns = time_ns([&](){
+				kernels::activate(activation, inputs.data(), outputs.data(), NUM_VALUES);
+				do_not_optimize(outputs[0]);
+			});
+
+			double max_abs_error = 0.0;
+			double max_rel_error = 0.0;
+			for(size_t i = 0; i < NUM_VALUES; i+=1){
+				const double expected = double(kernels::activate(reference, inputs[i]));
+				const double abs_error = std::abs(double(outputs[i]) - expected);
+				max_abs_error = std::max(max_abs_error, abs_error);
+				if(expected != 0.0){ max_rel_error = std::max(max_rel_error, abs_error / std::abs(expected)); }
+			}
+
+			evo::println(
+				"{:<14} {:>12.3f} {:>14.3g} {:>14.3g}",
+				name, total_ns / double(NUM_VALUES), max_abs_error, max_rel_error
+			);
+		};
+
+		run("std::tanh", kernels::Activation::TANH, kernels::Activation::TANH);
+		run("fastTanh", kernels::Activation::FAST_TANH, kernels::Activation::TANH);
+		run("sigmoid (exp)", kernels::Activation::SIGMOID, kernels::Activation::SIGMOID);
+		run("fastSigmoid", kernels::Activation::FAST_SIGMOID, kernels::Activation::SIGMOID);
+
+
+		///////////////////////////////////
+		// forward pass
+
+		static const auto dimensions = std::to_array<size_t>({9, 64, 1});
+
+		const auto ai = AI(dimensions);
+		auto fast_ai = ai;
+		fast_ai.setActivation(kernels::Activation::FAST_TANH);
+
+		auto ai_inputs = std::vector<float>(dimensions.front());
+		for(size_t i = 0; i < ai_inputs.size(); i+=1){
+			ai_inputs[i] = float(int(i % 3) - 1);
+		}
+
+		const double tanh_ns = time_ns([&](){ do_not_optimize(ai.calculate(ai_inputs)[0]); });
+		const double fast_tanh_ns = time_ns([&](){ do_not_optimize(fast_ai.calculate(ai_inputs)[0]); });
+
+		evo::println(
+			"AI::calculate {{9, 64, 1}}: {:.1f} ns (TANH), {:.1f} ns (FAST_TANH), {:.2f}x",
+			tanh_ns, fast_tanh_ns, tanh_ns / fast_tanh_ns
+		);
+	}
+
+
+}
@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <benchmarks.h>
+
+#include <AI.h>
+#include <Environment.h>
+#include <Population.h>
+#include <ThreadPool.h>
+
+#include "./timing.h"
+
+#include <numbers>
+#include <random>
+
+
+namespace tigris::benchmarks{
+
+
+	auto populationArena() -> void {
+		static constexpr size_t POPULATION = 2000;
+
+		evo::printlnCyan("Population arena ({} genomes, ns per generation)", POPULATION);
+		evo::printlnGray(
+			"{:<20} {:>16} {:>16} {:>8} {:>16} {:>16} {:>8}",
+			"dimensions", "copy AIs", "copy slots", "speedup", "score AIs", "score slots", "speedup"
+		);
+
+		const auto run = [&]<size_t... DIMENSIONS>(std::string_view name){
+			static const auto dimensions = std::to_array<size_t>({DIMENSIONS...});
+
+			auto environment = Environment(
+				POPULATION, dimensions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH
+			);
+			environment.initRandom(12);
+
+			auto ais = std::vector<AI>();
+			ais.reserve(POPULATION);
+			for(size_t i = 0; i < POPULATION; i+=1){
+				ais.emplace_back(environment.getAI(i));
+			}
+
+			// every genome is the child of the genome next to it (how `createNewPopulation` used to copy parents)
+			const double copy_ais_ns = time_ns([&](){
+				auto children = std::vector<AI>();
+				children.reserve(POPULATION);
+				for(size_t i = 0; i < POPULATION; i+=1){
+					children.emplace_back(ais[(i + 1) % POPULATION]);
+				}
+				do_not_optimize(children.back().numInputs());
+			});
+
+			auto children = Population(
+				POPULATION, dimensions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH
+			);
+			const double copy_slots_ns = time_ns([&](){
+				for(size_t i = 0; i < POPULATION; i+=1){
+					children.copyGenome(i, environment.population, (i + 1) % POPULATION);
+				}
+				do_not_optimize(children.genome(POPULATION - 1)[0]);
+			});
+
+			auto inputs = std::vector<float>(dimensions.front());
+			for(size_t i = 0; i < inputs.size(); i+=1){
+				inputs[i] = float(int(i % 3) - 1);
+			}
+
+			const double score_ais_ns = time_ns([&](){
+				for(const AI& ai : ais){
+					do_not_optimize(ai.calculate(inputs)[0]);
+				}
+			});
+
+			const double score_slots_ns = time_ns([&](){
+				for(size_t i = 0; i < POPULATION; i+=1){
+					do_not_optimize(environment.population.calculate(i, inputs)[0]);
+				}
+			});
+
+			evo::println(
+				"{:<20} {:>16.0f} {:>16.0f} {:>7.2f}x {:>16.0f} {:>16.0f} {:>7.2f}x",
+				name,
+				copy_ais_ns, copy_slots_ns, copy_ais_ns / copy_slots_ns,
+				score_ais_ns, score_slots_ns, score_ais_ns / score_slots_ns
+			);
+		};
+
+		run.template operator()<9, 64, 1>("{9, 64, 1}");
+		run.template operator()<42, 128, 128, 1>("{42, 128, 128, 1}");
+	}
+
+
+	// the statistical equivalence of the two samplers is checked in `Tigris/tests/mutation.cpp`
+	auto mutation() -> void {
+		static const auto dimensions = std::to_array<size_t>({42, 128, 128, 1});
+
+		evo::printlnCyan("AI::mutate {{42, 128, 128, 1}} (ns per call)");
+		evo::printlnGray("{:<8} {:>16} {:>16} {:>8}", "rate", "per weight", "skip", "speedup");
+
+		auto ai = AI(dimensions);
+		for(float mutation_rate : {0.999f, 0.99f, 0.9f, 0.5f}){
+			// how `AI::mutate` used to draw (2 `evo::random01()` calls per weight when mutated)
+			auto per_weight_layers = std::vector<Matrix>(ai.getMatrices().begin(), ai.getMatrices().end());
+			const double per_weight_ns = time_ns([&](){
+				for(Matrix& layer : per_weight_layers){
+					for(size_t y = 0; y < layer.height(); y+=1){
+						for(float& value : layer.row(y)){
+							if(mutation_rate > float(evo::random01())){ continue; }
+							value += float(evo::random01());
+						}
+					}
+				}
+				do_not_optimize(per_weight_layers[0][0, 0]);
+			});
+
+			const double skip_ns = time_ns([&](){
+				ai.mutate(mutation_rate);
+				do_not_optimize(ai.numInputs());
+			});
+
+			evo::println(
+				"{:<8} {:>16.0f} {:>16.0f} {:>7.2f}x", mutation_rate, per_weight_ns, skip_ns, per_weight_ns / skip_ns
+			);
+		}
+	}
+
+
+	auto normalMutation() -> void {
+		static constexpr size_t NUM_VALUES = 1 << 20;
+
+		///////////////////////////////////
+		// normal values
+
+		auto uniform = std::vector<float>(NUM_VALUES);
+		auto normal = std::vector<float>(NUM_VALUES);
+		const auto stream = kernels::RandomStream(3, 0, 0);
+		kernels::fillUniform01(uniform, stream);
+		kernels::fillNormal(normal, stream);
+
+		// against Box-Muller with `std::` functions on the same uniform values
+		float max_diff = 0.0f;
+		for(size_t chunk = 0; chunk < NUM_VALUES; chunk+=kernels::PHILOX_CHUNK_SIZE){
+			for(size_t i = chunk; i < chunk + kernels::PHILOX_CHUNK_SIZE / 2; i+=1){
+				const float radius = std::sqrt(-2.0f * std::log(1.0f - uniform[i]));
+				const float angle = 2.0f * std::numbers::pi_v<float> * uniform[i + kernels::PHILOX_CHUNK_SIZE / 2];
+				max_diff = std::max(max_diff, std::abs(normal[i] - radius * std::cos(angle)));
+				max_diff = std::max(
+					max_diff, std::abs(normal[i + kernels::PHILOX_CHUNK_SIZE / 2] - radius * std::sin(angle))
+				);
+			}
+		}
+
+		double sum = 0.0;
+		double squared_sum = 0.0;
+		double fourth_sum = 0.0;
+		for(float value : normal){
+			sum += double(value);
+			squared_sum += double(value) * double(value);
+			fourth_sum += double(value) * double(value) * double(value) * double(value);
+		}
+		const double mean = sum / double(NUM_VALUES);
+
+		auto generator = std::mt19937(3);
+		auto distribution = std::normal_distribution<float>();
+		const double std_ns = time_ns([&](){
+			for(float& value : normal){
+				value = distribution(generator);
+			}
+			do_not_optimize(normal[0]);
+		});
+
+		const double fill_normal_ns = time_ns([&](){
+			kernels::fillNormal(normal, stream);
+			do_not_optimize(normal[0]);
+		});
+
+		evo::printlnCyan("normal values ({} values)", NUM_VALUES);
+		evo::println(
+			"mean {:.5f} (0), variance {:.5f} (1), kurtosis {:.4f} (3), max diff from std:: {}",
+			mean, squared_sum / double(NUM_VALUES) - mean * mean, fourth_sum / double(NUM_VALUES), max_diff
+		);
+		evo::println("{:<34} {:>10.2f} ns / value", "std::normal_distribution", std_ns / double(NUM_VALUES));
+		evo::println("{:<34} {:>10.2f} ns / value", "kernels::fillNormal (Box-Muller)", fill_normal_ns / double(NUM_VALUES));
+		evo::println("{:<34} {:>10.2f}x", "speedup", std_ns / fill_normal_ns);
+
+
+		///////////////////////////////////
+		// mutation
+
+		static const auto dimensions = std::to_array<size_t>({42, 128, 128, 1});
+
+		evo::printlnCyan("AI::mutate vs AI::mutateGaussian {{42, 128, 128, 1}} (ns per call)");
+		evo::printlnGray("{:<8} {:>16} {:>16}", "rate", "uniform", "gaussian");
+
+		auto ai = AI(dimensions);
+		for(float mutation_rate : {0.99f, 0.9f, 0.0f}){
+			const double uniform_ns = time_ns([&](){
+				ai.mutate(mutation_rate, kernels::RandomStream(1, 0, 0));
+				do_not_optimize(ai.numInputs());
+			});
+
+			const double gaussian_ns = time_ns([&](){
+				ai.mutateGaussian(mutation_rate, 0.1f, kernels::RandomStream(1, 0, 0));
+				do_not_optimize(ai.numInputs());
+			});
+
+			evo::println("{:<8} {:>16.0f} {:>16.0f}", mutation_rate, uniform_ns, gaussian_ns);
+		}
+	}
+
+
+	auto populationInit() -> void {
+		static constexpr size_t POPULATION = 100'000;
+		static const auto dimensions = std::to_array<size_t>({9, 64, 1});
+
+		using Clock = std::chrono::steady_clock;
+
+		// how `Matrix::random` used to fill the layers (one `evo::random01()` call per weight)
+		const Clock::time_point per_value_start = Clock::now();
+		{
+			auto population = std::vector<std::vector<Matrix>>();
+			population.reserve(POPULATION);
+			for(size_t i = 0; i < POPULATION; i+=1){
+				std::vector<Matrix>& layers = population.emplace_back();
+
+				for(size_t layer = 0; layer < dimensions.size() - 1; layer+=1){
+					Matrix& matrix = layers.emplace_back(dimensions[layer + 1], dimensions[layer]);
+					for(size_t y = 0; y < matrix.height(); y+=1){
+						for(float& value : matrix.row(y)){
+							value = float(evo::random01());
+						}
+					}
+				}
+			}
+			do_not_optimize(population.back().back()[0, 0]);
+		}
+		const double per_value_ms = std::chrono::duration<double, std::milli>(Clock::now() - per_value_start).count();
+
+		auto environment = Environment(POPULATION, dimensions);
+
+		const Clock::time_point bulk_start = Clock::now();
+		environment.initRandom(12);
+		const double bulk_ms = std::chrono::duration<double, std::milli>(Clock::now() - bulk_start).count();
+
+		// the same seed has to give the same population
+		auto environment_copy = Environment(POPULATION, dimensions);
+		environment_copy.initRandom(12);
+		bool reproducible = true;
+		for(size_t i = 0; i < POPULATION; i+=1){
+			if(std::ranges::equal(environment.population.genome(i), environment_copy.population.genome(i)) == false){
+				reproducible = false;
+			}
+		}
+
+		evo::printlnCyan("population init ({} AIs of {{9, 64, 1}}, {} threads)", POPULATION, ThreadPool::get().numThreads());
+		evo::println("{:<34} {:>12.1f} ms", "evo::random01() per weight", per_value_ms);
+		evo::println("{:<34} {:>12.1f} ms", "Environment::initRandom (philox)", bulk_ms);
+		evo::println("{:<34} {:>12.2f}x (reproducible: {})", "speedup", per_value_ms / bulk_ms, reproducible);
+	}
+
+
+}
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include <chrono>
+
+
+namespace tigris::benchmarks{
+
+
+	// runs `func` repeatedly for about `target_seconds` and returns the average nanoseconds per call
+	template<class Func>
+	auto time_ns(Func&& func, double target_seconds = 0.2) -> double {
+		using Clock = std::chrono::steady_clock;
+
+		func(); // warm up
+
+		size_t num_iters = 1;
+		while(true){
+			const Clock::time_point start = Clock::now();
+			for(size_t i = 0; i < num_iters; i+=1){
+				func();
+			}
+			const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+			if(elapsed >= target_seconds || num_iters >= (size_t(1) << 30)){
+				return elapsed * 1e9 / double(num_iters);
+			}
+
+			num_iters *= 2;
+		}
+	}
+
+
+	template<class T>
+	auto do_not_optimize(const T& value) -> void {
+		#if defined(_MSC_VER) && !defined(__clang__)
+			static volatile const void* sink;
+			sink = &value;
+		#else
+			asm volatile("" : : "r,m"(value) : "memory");
+		#endif
+	}
+
+
+}
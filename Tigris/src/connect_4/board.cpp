@@ -71,6 +71,97 @@ namespace tigris::connect_4{
 
 
 
+	auto Board::getAIData() const -> std::vector<float> {
+		auto output = std::vector<float>(AI_DATA_SIZE);
+		this->getAIData(output);
+		return output;
+	}
+
+	auto Board::getAIData(std::span<float> output) const -> void {
+		this->getAIData(output, Space::X);
+	}
+
+	auto Board::getAIData(std::span<float> output, Space player) const -> void {
+		evo::debugAssert(output.size() == AI_DATA_SIZE, "Invalid output size");
+		evo::debugAssert(player != Space::EMPTY, "Not a player");
+
+		for(size_t row = 0; row < this->spaces[0].size(); row+=1){
+			for(size_t collumn = 0; collumn < this->spaces.size(); collumn+=1){
+				const Space space = this->get_space(Coordinate(row, collumn));
+				float& value = output[row * this->spaces.size() + collumn];
+
+				if(space == Space::EMPTY){
+					value = 0.0f;
+				}else{
+					value = space == player ? 1.0f : -1.0f;
+				}
+			}
+		}
+	}
+
+
+	auto Board::getBitplanes(Space player) const -> Bitplanes {
+		evo::debugAssert(player != Space::EMPTY, "Not a player");
+
+		auto output = Bitplanes();
+
+		for(size_t row = 0; row < this->spaces[0].size(); row+=1){
+			for(size_t collumn = 0; collumn < this->spaces.size(); collumn+=1){
+				const Space space = this->get_space(Coordinate(row, collumn));
+				if(space == Space::EMPTY){ continue; }
+
+				const size_t i = row * this->spaces.size() + collumn;
+				const size_t bit = space == player ? i : AI_DATA_SIZE + i;
+				output[bit / 64] |= uint64_t(1) << (bit % 64);
+			}
+		}
+
+		return output;
+	}
+
+	auto Board::getBitplaneAIData(std::span<float> output, Space player) const -> void {
+		evo::debugAssert(output.size() == BITPLANE_SIZE, "Invalid output size");
+
+		const Bitplanes bitplanes = this->getBitplanes(player);
+		for(size_t i = 0; i < BITPLANE_SIZE; i+=1){
+			output[i] = float((bitplanes[i / 64] >> (i % 64)) & 1);
+		}
+	}
+
+
+	auto Board::getLegalMoves() const -> std::array<bool, NUM_MOVES> {
+		auto output = std::array<bool, NUM_MOVES>();
+
+		for(size_t collumn = 0; collumn < this->spaces.size(); collumn+=1){
+			output[collumn] = this->spaces[collumn].back() == Space::EMPTY;
+		}
+
+		return output;
+	}
+
+
+
+
+	auto Board::getKey() const -> uint64_t {
+		uint64_t key = 0;
+
+		for(size_t collumn = 0; collumn < this->spaces.size(); collumn+=1){
+			uint64_t collumn_key = 0;
+			size_t height = 0;
+			for(; height < this->spaces[collumn].size(); height+=1){
+				const Space space = this->spaces[collumn][height];
+				if(space == Space::EMPTY){ break; }
+				if(space == Space::X){ collumn_key |= uint64_t(1) << height; }
+			}
+			collumn_key |= uint64_t(1) << height;
+
+			key |= collumn_key << (collumn * 7);
+		}
+
+		return key;
+	}
+
+
 	auto Board::toString() const -> std::string {
 		auto output = std::string();
 
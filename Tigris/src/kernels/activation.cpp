@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/activation.h>
+
+#include <kernels/cpu.h>
+
+#include <immintrin.h>
+
+
+namespace tigris::kernels{
+
+	using ActivationFunc = auto(*)(const float*, float*, size_t) -> void;
+
+
+	//////////////////////////////////////////////////////////////////////
+	// scalar
+
+	static auto fast_tanh_scalar(const float* input, float* output, size_t count) -> void {
+		for(size_t i = 0; i < count; i+=1){
+			output[i] = fastTanh(input[i]);
+		}
+	}
+
+	static auto fast_sigmoid_scalar(const float* input, float* output, size_t count) -> void {
+		for(size_t i = 0; i < count; i+=1){
+			output[i] = fastSigmoid(input[i]);
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX2
+
+	// same operations (in the same order) as the scalar `fastTanh()`, but the polynomials are evaluated with FMA
+	TIGRIS_TARGET_AVX2
+	static auto avx2_tanh(__m256 value) -> __m256 {
+		const __m256 x = _mm256_min_ps(
+			_mm256_max_ps(value, _mm256_set1_ps(-7.90531110763549805f)), _mm256_set1_ps(7.90531110763549805f)
+		);
+		const __m256 x2 = _mm256_mul_ps(x, x);
+
+		__m256 p = _mm256_set1_ps(-2.76076847742355e-16f);
+		p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(2.00018790482477e-13f));
+		p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-8.60467152213735e-11f));
+		p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(5.12229709037114e-08f));
+		p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(1.48572235717979e-05f));
+		p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(6.37261928875436e-04f));
+		p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(4.89352455891786e-03f));
+
+		__m256 q = _mm256_set1_ps(1.19825839466702e-06f);
+		q = _mm256_fmadd_ps(q, x2, _mm256_set1_ps(1.18534705686654e-04f));
+		q = _mm256_fmadd_ps(q, x2, _mm256_set1_ps(2.26843463243900e-03f));
+		q = _mm256_fmadd_ps(q, x2, _mm256_set1_ps(4.89352518554385e-03f));
+
+		return _mm256_div_ps(_mm256_mul_ps(x, p), q);
+	}
+
+	TIGRIS_TARGET_AVX2
+	static auto avx2_sigmoid(__m256 value) -> __m256 {
+		const __m256 half = _mm256_set1_ps(0.5f);
+		return _mm256_fmadd_ps(half, avx2_tanh(_mm256_mul_ps(half, value)), half);
+	}
+
+
+	template<__m256(*FUNC)(__m256)>
+	TIGRIS_TARGET_AVX2
+	static auto activate_avx2(const float* input, float* output, size_t count) -> void {
+		size_t i = 0;
+		for(; i + 8 <= count; i+=8){
+			_mm256_storeu_ps(&output[i], FUNC(_mm256_loadu_ps(&input[i])));
+		}
+
+		if(i < count){
+			const int remaining = int(count - i);
+			const __m256i mask = _mm256_cmpgt_epi32(
+				_mm256_set1_epi32(remaining), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+			);
+			_mm256_maskstore_ps(&output[i], mask, FUNC(_mm256_maskload_ps(&input[i], mask)));
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX-512
+
+	TIGRIS_TARGET_AVX512
+	static auto avx512_tanh(__m512 value) -> __m512 {
+		const __m512 x = _mm512_min_ps(
+			_mm512_max_ps(value, _mm512_set1_ps(-7.90531110763549805f)), _mm512_set1_ps(7.90531110763549805f)
+		);
+		const __m512 x2 = _mm512_mul_ps(x, x);
+
+		__m512 p = _mm512_set1_ps(-2.76076847742355e-16f);
+		p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(2.00018790482477e-13f));
+		p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(-8.60467152213735e-11f));
+		p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(5.12229709037114e-08f));
+		p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(1.48572235717979e-05f));
+		p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(6.37261928875436e-04f));
+		p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(4.89352455891786e-03f));
+
+		__m512 q = _mm512_set1_ps(1.19825839466702e-06f);
+		q = _mm512_fmadd_ps(q, x2, _mm512_set1_ps(1.18534705686654e-04f));
+		q = _mm512_fmadd_ps(q, x2, _mm512_set1_ps(2.26843463243900e-03f));
+		q = _mm512_fmadd_ps(q, x2, _mm512_set1_ps(4.89352518554385e-03f));
+
+		return _mm512_div_ps(_mm512_mul_ps(x, p), q);
+	}
+
+	TIGRIS_TARGET_AVX512
+	static auto avx512_sigmoid(__m512 value) -> __m512 {
+		const __m512 half = _mm512_set1_ps(0.5f);
+		return _mm512_fmadd_ps(half, avx512_tanh(_mm512_mul_ps(half, value)), half);
+	}
+
+
+	template<__m512(*FUNC)(__m512)>
+	TIGRIS_TARGET_AVX512
+	static auto activate_avx512(const float* input, float* output, size_t count) -> void {
+		for(size_t i = 0; i < count; i+=16){
+			const __mmask16 mask = count - i >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << (count - i)) - 1);
+			_mm512_mask_storeu_ps(&output[i], mask, FUNC(_mm512_maskz_loadu_ps(mask, &input[i])));
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// dispatch
+
+	struct ActivationImplementation{
+		ActivationFunc fast_tanh;
+		ActivationFunc fast_sigmoid;
+	};
+
+	static auto select_implementation() -> const ActivationImplementation& {
+		static const ActivationImplementation implementation = []() -> ActivationImplementation {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512f){
+				return ActivationImplementation(&activate_avx512<&avx512_tanh>, &activate_avx512<&avx512_sigmoid>);
+			}
+			if(cpu_features.avx2){
+				return ActivationImplementation(&activate_avx2<&avx2_tanh>, &activate_avx2<&avx2_sigmoid>);
+			}
+			return ActivationImplementation(&fast_tanh_scalar, &fast_sigmoid_scalar);
+		}();
+
+		return implementation;
+	}
+
+
+	auto fastTanh(const float* input, float* output, size_t count) -> void {
+		select_implementation().fast_tanh(input, output, count);
+	}
+
+	auto fastSigmoid(const float* input, float* output, size_t count) -> void {
+		select_implementation().fast_sigmoid(input, output, count);
+	}
+
+
+}
@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/bitplane.h>
+
+#include <kernels/cpu.h>
+
+#include <immintrin.h>
+
+
+namespace tigris::kernels{
+
+	// y[j] = sum of w[i][j] for every set bit `i` (without the activation)
+	using BitplaneFunc = auto(*)(std::span<const uint64_t>, const float*, size_t, float*, size_t) -> void;
+
+	// The set bits are visited with `remaining &= remaining - 1` (clears the lowest set bit) in each kernel instead of
+	// 	through a helper taking a lambda, as lambdas do not get the target attributes of the kernel.
+
+
+	//////////////////////////////////////////////////////////////////////
+	// scalar
+
+	static auto bitplane_scalar(
+		std::span<const uint64_t> bits, const float* w, size_t w_stride, float* y, size_t n
+	) -> void {
+		std::fill_n(y, n, 0.0f);
+
+		for(size_t word = 0; word < bits.size(); word+=1){
+			for(uint64_t remaining = bits[word]; remaining != 0; remaining &= remaining - 1){
+				const float* row = &w[(word * 64 + size_t(std::countr_zero(remaining))) * w_stride];
+				for(size_t j = 0; j < n; j+=1){
+					y[j] += row[j];
+				}
+			}
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX2
+
+	// 4 vectors (32 outputs) at a time
+	TIGRIS_TARGET_AVX2
+	static auto bitplane_avx2(
+		std::span<const uint64_t> bits, const float* w, size_t w_stride, float* y, size_t n
+	) -> void {
+		size_t j = 0;
+		for(; j + 32 <= n; j+=32){
+			__m256 acc[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+
+			for(size_t word = 0; word < bits.size(); word+=1){
+				for(uint64_t remaining = bits[word]; remaining != 0; remaining &= remaining - 1){
+					const float* row = &w[(word * 64 + size_t(std::countr_zero(remaining))) * w_stride];
+					for(size_t v = 0; v < 4; v+=1){
+						acc[v] = _mm256_add_ps(acc[v], _mm256_loadu_ps(&row[j + v * 8]));
+					}
+				}
+			}
+
+			for(size_t v = 0; v < 4; v+=1){
+				_mm256_storeu_ps(&y[j + v * 8], acc[v]);
+			}
+		}
+
+		for(; j + 8 <= n; j+=8){
+			__m256 acc = _mm256_setzero_ps();
+			for(size_t word = 0; word < bits.size(); word+=1){
+				for(uint64_t remaining = bits[word]; remaining != 0; remaining &= remaining - 1){
+					const float* row = &w[(word * 64 + size_t(std::countr_zero(remaining))) * w_stride];
+					acc = _mm256_add_ps(acc, _mm256_loadu_ps(&row[j]));
+				}
+			}
+			_mm256_storeu_ps(&y[j], acc);
+		}
+
+		for(; j < n; j+=1){
+			float sum = 0.0f;
+			for(size_t word = 0; word < bits.size(); word+=1){
+				for(uint64_t remaining = bits[word]; remaining != 0; remaining &= remaining - 1){
+					const float* row = &w[(word * 64 + size_t(std::countr_zero(remaining))) * w_stride];
+					sum += row[j];
+				}
+			}
+			y[j] = sum;
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX-512
+
+	// mask of the first `cols_remaining` lanes of a vector (all of them if there are more)
+	static auto avx512_column_mask(size_t cols_remaining) -> __mmask16 {
+		if(cols_remaining >= 16){ return __mmask16(0xFFFF); }
+		return __mmask16((1u << cols_remaining) - 1);
+	}
+
+	// 4 vectors (64 outputs) at a time, the last ones masked
+	TIGRIS_TARGET_AVX512
+	static auto bitplane_avx512(
+		std::span<const uint64_t> bits, const float* w, size_t w_stride, float* y, size_t n
+	) -> void {
+		for(size_t j = 0; j < n; j+=64){
+			const size_t cols = std::min<size_t>(64, n - j);
+
+			__mmask16 masks[4];
+			for(size_t v = 0; v < 4; v+=1){
+				masks[v] = avx512_column_mask(cols > v * 16 ? cols - v * 16 : 0);
+			}
+
+			__m512 acc[4] = {_mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps()};
+
+			for(size_t word = 0; word < bits.size(); word+=1){
+				for(uint64_t remaining = bits[word]; remaining != 0; remaining &= remaining - 1){
+					const float* row = &w[(word * 64 + size_t(std::countr_zero(remaining))) * w_stride];
+					for(size_t v = 0; v < 4; v+=1){
+						acc[v] = _mm512_add_ps(acc[v], _mm512_maskz_loadu_ps(masks[v], &row[j + v * 16]));
+					}
+				}
+			}
+
+			for(size_t v = 0; v < 4; v+=1){
+				_mm512_mask_storeu_ps(&y[j + v * 16], masks[v], acc[v]);
+			}
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// dispatch
+
+	struct BitplaneImplementation{
+		BitplaneFunc bitplane;
+		std::string_view name;
+	};
+
+	static auto select_implementation() -> const BitplaneImplementation& {
+		static const BitplaneImplementation implementation = []() -> BitplaneImplementation {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512f){ return BitplaneImplementation(&bitplane_avx512, "avx512"); }
+			if(cpu_features.avx2){ return BitplaneImplementation(&bitplane_avx2, "avx2"); }
+			return BitplaneImplementation(&bitplane_scalar, "scalar");
+		}();
+
+		return implementation;
+	}
+
+
+	auto bitplaneGemv(
+		std::span<const uint64_t> bits,
+		const float* w, size_t w_stride,
+		float* y,
+		size_t n,
+		Activation activation
+	) -> void {
+		select_implementation().bitplane(bits, w, w_stride, y, n);
+		activate(activation, y, y, n);
+	}
+
+
+	auto bitplaneImplementationName() -> std::string_view {
+		return select_implementation().name;
+	}
+
+
+}
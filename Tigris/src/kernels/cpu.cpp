@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/cpu.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#include <intrin.h>
+#else
+	#include <cpuid.h>
+	#include <immintrin.h>
+#endif
+
+
+namespace tigris::kernels{
+
+
+	struct CPUIDRegisters{
+		uint32_t eax = 0;
+		uint32_t ebx = 0;
+		uint32_t ecx = 0;
+		uint32_t edx = 0;
+	};
+
+	static auto cpuid(uint32_t leaf, uint32_t subleaf) -> CPUIDRegisters {
+		auto output = CPUIDRegisters();
+
+		#if defined(_MSC_VER) && !defined(__clang__)
+			int registers[4];
+			__cpuidex(registers, int(leaf), int(subleaf));
+			output.eax = uint32_t(registers[0]);
+			output.ebx = uint32_t(registers[1]);
+			output.ecx = uint32_t(registers[2]);
+			output.edx = uint32_t(registers[3]);
+		#else
+			__cpuid_count(leaf, subleaf, output.eax, output.ebx, output.ecx, output.edx);
+		#endif
+
+		return output;
+	}
+
+
+	TIGRIS_TARGET("xsave")
+	static auto xgetbv() -> uint64_t {
+		return _xgetbv(0);
+	}
+
+
+	static auto detect_cpu_features() -> CPUFeatures {
+		auto output = CPUFeatures();
+
+		const uint32_t max_leaf = cpuid(0, 0).eax;
+		if(max_leaf < 7){ return output; }
+
+		const CPUIDRegisters leaf_1 = cpuid(1, 0);
+		const CPUIDRegisters leaf_7 = cpuid(7, 0);
+
+		const bool has_osxsave = (leaf_1.ecx & (1u << 27)) != 0;
+		if(has_osxsave == false){ return output; }
+
+		// check that the OS saves the registers on a context switch
+		const uint64_t xcr0 = xgetbv();
+		const bool os_saves_ymm = (xcr0 & 0b110) == 0b110;
+		const bool os_saves_zmm = (xcr0 & 0b1110'0110) == 0b1110'0110;
+
+		const bool has_fma        = (leaf_1.ecx & (1u << 12)) != 0;
+		const bool has_f16c       = (leaf_1.ecx & (1u << 29)) != 0;
+		const bool has_avx2       = (leaf_7.ebx & (1u << 5)) != 0;
+		const bool has_avx512f    = (leaf_7.ebx & (1u << 16)) != 0;
+		const bool has_avx512dq   = (leaf_7.ebx & (1u << 17)) != 0;
+		const bool has_avx512bw   = (leaf_7.ebx & (1u << 30)) != 0;
+		const bool has_avx512vl   = (leaf_7.ebx & (1u << 31)) != 0;
+		const bool has_avx512vnni = (leaf_7.ecx & (1u << 11)) != 0;
+
+		output.avx2 = os_saves_ymm && has_avx2 && has_fma && has_f16c;
+		output.avx512f = output.avx2 && os_saves_zmm && has_avx512f && has_avx512dq && has_avx512bw && has_avx512vl;
+		output.avx512vnni = output.avx512f && has_avx512vnni;
+
+		return output;
+	}
+
+
+	auto getCPUFeatures() -> const CPUFeatures& {
+		static const CPUFeatures cpu_features = detect_cpu_features();
+		return cpu_features;
+	}
+
+	
+}
@@ -0,0 +1,866 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/gemm.h>
+
+#include <kernels/cpu.h>
+
+#include <immintrin.h>
+
+
+namespace tigris::kernels{
+
+	// cache blocking
+	// 	a KC x NC panel of `b` stays in L2 while MC rows of `a` stream through it
+	static constexpr size_t KC = 256;
+	static constexpr size_t MC = 96;
+	static constexpr size_t NC = 1024;
+
+
+	// `B` is the element type of `b` / `w` (float, BF16, or FP16).
+	// 	Reduced precision values are widened to fp32 as they are loaded and all accumulation is done in fp32.
+	template<class B>
+	using GEMMFunc = auto(*)(const float*, size_t, const B*, size_t, float*, size_t, size_t, size_t, size_t) -> void;
+
+	template<class B>
+	using GEMVFunc = auto(*)(const float*, const B*, size_t, float*, size_t, size_t, Activation) -> void;
+
+	// columns of `y` computed at once by the GEMV kernels
+	static constexpr size_t GEMV_NR = 64;
+
+
+	// Walks the cache blocks and calls `micro_kernel(a, b, c, rows, cols, kc, accumulate)` for each register tile
+	template<size_t MR, size_t NR, class B, class MicroKernel>
+	static auto gemm_blocked(
+		const float* a, size_t a_stride,
+		const B* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k,
+		MicroKernel&& micro_kernel
+	) -> void {
+		for(size_t jc = 0; jc < n; jc+=NC){
+			const size_t nc = std::min(NC, n - jc);
+
+			for(size_t pc = 0; pc < k; pc+=KC){
+				const size_t kc = std::min(KC, k - pc);
+				const bool accumulate = pc != 0;
+
+				for(size_t ic = 0; ic < m; ic+=MC){
+					const size_t mc = std::min(MC, m - ic);
+
+					for(size_t jr = 0; jr < nc; jr+=NR){
+						const size_t cols = std::min(NR, nc - jr);
+
+						for(size_t ir = 0; ir < mc; ir+=MR){
+							const size_t rows = std::min(MR, mc - ir);
+
+							micro_kernel(
+								&a[(ic + ir) * a_stride + pc],
+								&b[pc * b_stride + jc + jr],
+								&c[(ic + ir) * c_stride + jc + jr],
+								rows, cols, kc, accumulate
+							);
+						}
+					}
+				}
+			}
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// scalar
+
+	template<class B>
+	static auto scalar_dot(const float* a, const B* b, size_t k) -> float {
+		// 4 independent sums to break the dependency chain
+		auto sums = std::array<float, 4>{};
+
+		size_t i = 0;
+		for(; i + 4 <= k; i+=4){
+			sums[0] += a[i + 0] * float(b[i + 0]);
+			sums[1] += a[i + 1] * float(b[i + 1]);
+			sums[2] += a[i + 2] * float(b[i + 2]);
+			sums[3] += a[i + 3] * float(b[i + 3]);
+		}
+		for(; i < k; i+=1){
+			sums[0] += a[i] * float(b[i]);
+		}
+
+		return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	}
+
+	// dot products of 4 independent problems (`a[e] . b[e]`)
+	static auto scalar_dot_4(const float* const* a, const float* const* b, size_t k) -> std::array<float, 4> {
+		return std::array<float, 4>{
+			scalar_dot(a[0], b[0], k), scalar_dot(a[1], b[1], k), scalar_dot(a[2], b[2], k), scalar_dot(a[3], b[3], k)
+		};
+	}
+
+
+	// i-k-j order so the innermost loop is contiguous over `b` and `c` (which lets the compiler vectorize it with
+	// 	whatever the baseline instruction set is)
+	template<class B>
+	static auto gemm_scalar(
+		const float* a, size_t a_stride,
+		const B* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		if(n == 1 && b_stride == 1){
+			for(size_t y = 0; y < m; y+=1){
+				c[y * c_stride] = scalar_dot(&a[y * a_stride], b, k);
+			}
+			return;
+		}
+
+		for(size_t y = 0; y < m; y+=1){
+			std::memset(&c[y * c_stride], 0, n * sizeof(float));
+		}
+
+		for(size_t jc = 0; jc < n; jc+=NC){
+			const size_t nc = std::min(NC, n - jc);
+
+			for(size_t pc = 0; pc < k; pc+=KC){
+				const size_t kc = std::min(KC, k - pc);
+
+				for(size_t y = 0; y < m; y+=1){
+					float* c_row = &c[y * c_stride + jc];
+
+					for(size_t p = pc; p < pc + kc; p+=1){
+						const float a_value = a[y * a_stride + p];
+						const B* b_row = &b[p * b_stride + jc];
+
+						for(size_t x = 0; x < nc; x+=1){
+							c_row[x] += a_value * float(b_row[x]);
+						}
+					}
+				}
+			}
+		}
+	}
+
+
+	template<class B>
+	static auto gemv_scalar(
+		const float* x,
+		const B* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void {
+		if(n == 1 && w_stride == 1){
+			y[0] = activate(activation, scalar_dot(x, w, k));
+			return;
+		}
+
+		for(size_t j = 0; j < n; j+=GEMV_NR){
+			const size_t cols = std::min(GEMV_NR, n - j);
+
+			auto acc = std::array<float, GEMV_NR>{};
+			for(size_t p = 0; p < k; p+=1){
+				const float x_value = x[p];
+				const B* w_row = &w[p * w_stride + j];
+
+				for(size_t col = 0; col < cols; col+=1){
+					acc[col] += x_value * float(w_row[col]);
+				}
+			}
+
+			activate(activation, acc.data(), &y[j], cols);
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX2
+
+	TIGRIS_TARGET_AVX2
+	static auto avx2_column_mask(size_t cols_remaining) -> __m256i {
+		const int remaining = int(std::min<size_t>(cols_remaining, 8));
+		return _mm256_cmpgt_epi32(_mm256_set1_epi32(remaining), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+	}
+
+
+	// 8 16 bit values widened to fp32
+	template<class B>
+	TIGRIS_TARGET_AVX2
+	static auto avx2_widen(__m128i bits) -> __m256 {
+		if constexpr(std::is_same_v<B, BF16>){
+			return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(bits), 16));
+
+		}else{
+			static_assert(std::is_same_v<B, FP16>, "Unknown weight type");
+			return _mm256_cvtph_ps(bits);
+		}
+	}
+
+
+	// 8 values of `b` widened to fp32
+	template<class B>
+	TIGRIS_TARGET_AVX2
+	static auto avx2_load(const B* ptr) -> __m256 {
+		if constexpr(std::is_same_v<B, float>){
+			return _mm256_loadu_ps(ptr);
+		}else{
+			return avx2_widen<B>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+		}
+	}
+
+	// first `count` values of `b` widened to fp32 (the rest are 0)
+	template<class B>
+	TIGRIS_TARGET_AVX2
+	static auto avx2_load_partial(const B* ptr, size_t count) -> __m256 {
+		if constexpr(std::is_same_v<B, float>){
+			return _mm256_maskload_ps(ptr, avx2_column_mask(count));
+
+		}else{
+			// AVX2 has no masked 16 bit loads, so the pairs of values are loaded as masked 32 bit elements (which never
+			// 	touch the memory past `count`) and an odd last value is blended in
+			const int num_values = int(std::min<size_t>(count, 8));
+
+			const __m128i pair_mask = _mm_cmpgt_epi32(_mm_set1_epi32(num_values / 2), _mm_setr_epi32(0, 1, 2, 3));
+			__m128i bits = _mm_maskload_epi32(reinterpret_cast<const int*>(ptr), pair_mask);
+
+			if(num_values % 2 == 1){
+				const __m128i last_mask = _mm_cmpeq_epi16(
+					_mm_set1_epi16(short(num_values - 1)), _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7)
+				);
+				bits = _mm_blendv_epi8(bits, _mm_set1_epi16(short(ptr[num_values - 1].bits)), last_mask);
+			}
+
+			return avx2_widen<B>(bits);
+		}
+	}
+
+
+	// 6 x 16 register tile (12 accumulators, 2 loads of `b`, 1 broadcast of `a`)
+	template<size_t ROWS, bool MASKED, class B>
+	TIGRIS_TARGET_AVX2
+	static auto avx2_micro_kernel(
+		const float* a, size_t a_stride,
+		const B* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t cols, size_t kc, bool accumulate
+	) -> void {
+		const __m256i mask_0 = MASKED ? avx2_column_mask(cols) : _mm256_set1_epi32(-1);
+		const __m256i mask_1 = MASKED ? avx2_column_mask(cols > 8 ? cols - 8 : 0) : _mm256_set1_epi32(-1);
+
+		__m256 acc[ROWS][2];
+		for(size_t r = 0; r < ROWS; r+=1){
+			acc[r][0] = _mm256_setzero_ps();
+			acc[r][1] = _mm256_setzero_ps();
+		}
+
+		for(size_t p = 0; p < kc; p+=1){
+			const B* b_row = &b[p * b_stride];
+
+			__m256 b_0;
+			__m256 b_1;
+			if constexpr(MASKED){
+				b_0 = avx2_load_partial(b_row, cols);
+				b_1 = avx2_load_partial(b_row + 8, cols > 8 ? cols - 8 : 0);
+			}else{
+				b_0 = avx2_load(b_row);
+				b_1 = avx2_load(b_row + 8);
+			}
+
+			for(size_t r = 0; r < ROWS; r+=1){
+				const __m256 a_value = _mm256_broadcast_ss(&a[r * a_stride + p]);
+				acc[r][0] = _mm256_fmadd_ps(a_value, b_0, acc[r][0]);
+				acc[r][1] = _mm256_fmadd_ps(a_value, b_1, acc[r][1]);
+			}
+		}
+
+		for(size_t r = 0; r < ROWS; r+=1){
+			float* c_row = &c[r * c_stride];
+
+			if constexpr(MASKED){
+				if(accumulate){
+					acc[r][0] = _mm256_add_ps(acc[r][0], _mm256_maskload_ps(c_row, mask_0));
+					acc[r][1] = _mm256_add_ps(acc[r][1], _mm256_maskload_ps(c_row + 8, mask_1));
+				}
+				_mm256_maskstore_ps(c_row, mask_0, acc[r][0]);
+				_mm256_maskstore_ps(c_row + 8, mask_1, acc[r][1]);
+			}else{
+				if(accumulate){
+					acc[r][0] = _mm256_add_ps(acc[r][0], _mm256_loadu_ps(c_row));
+					acc[r][1] = _mm256_add_ps(acc[r][1], _mm256_loadu_ps(c_row + 8));
+				}
+				_mm256_storeu_ps(c_row, acc[r][0]);
+				_mm256_storeu_ps(c_row + 8, acc[r][1]);
+			}
+		}
+	}
+
+
+	template<class B>
+	TIGRIS_TARGET_AVX2
+	static auto avx2_dot(const float* a, const B* b, size_t k) -> float {
+		__m256 acc_0 = _mm256_setzero_ps();
+		__m256 acc_1 = _mm256_setzero_ps();
+
+		size_t i = 0;
+		for(; i + 16 <= k; i+=16){
+			acc_0 = _mm256_fmadd_ps(_mm256_loadu_ps(&a[i]), avx2_load(&b[i]), acc_0);
+			acc_1 = _mm256_fmadd_ps(_mm256_loadu_ps(&a[i + 8]), avx2_load(&b[i + 8]), acc_1);
+		}
+		for(; i < k; i+=8){
+			const __m256i mask = avx2_column_mask(k - i);
+			acc_0 = _mm256_fmadd_ps(_mm256_maskload_ps(&a[i], mask), avx2_load_partial(&b[i], k - i), acc_0);
+		}
+
+		const __m256 acc = _mm256_add_ps(acc_0, acc_1);
+		__m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+		return _mm_cvtss_f32(sum);
+	}
+
+	// horizontal sums of 4 vectors at once ({sum(v[0]), sum(v[1]), sum(v[2]), sum(v[3])})
+	TIGRIS_TARGET_AVX2
+	static auto avx2_reduce_4(const __m256* v) -> __m128 {
+		const __m256 sums = _mm256_hadd_ps(_mm256_hadd_ps(v[0], v[1]), _mm256_hadd_ps(v[2], v[3]));
+		return _mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1));
+	}
+
+	// dot products of 4 independent problems (`a[e] . b[e]`), with their reductions done together
+	TIGRIS_TARGET_AVX2
+	static auto avx2_dot_4(const float* const* a, const float* const* b, size_t k) -> std::array<float, 4> {
+		__m256 acc[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+
+		size_t i = 0;
+		for(; i + 8 <= k; i+=8){
+			for(size_t e = 0; e < 4; e+=1){
+				acc[e] = _mm256_fmadd_ps(_mm256_loadu_ps(&a[e][i]), _mm256_loadu_ps(&b[e][i]), acc[e]);
+			}
+		}
+		if(i < k){
+			const __m256i mask = avx2_column_mask(k - i);
+			for(size_t e = 0; e < 4; e+=1){
+				acc[e] = _mm256_fmadd_ps(_mm256_maskload_ps(&a[e][i], mask), _mm256_maskload_ps(&b[e][i], mask), acc[e]);
+			}
+		}
+
+		auto output = std::array<float, 4>();
+		_mm_storeu_ps(output.data(), avx2_reduce_4(acc));
+		return output;
+	}
+
+
+	template<class B>
+	TIGRIS_TARGET_AVX2
+	static auto gemm_avx2(
+		const float* a, size_t a_stride,
+		const B* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		// a single contiguous column of `b` is a set of dot products
+		if(n == 1 && b_stride == 1){
+			for(size_t y = 0; y < m; y+=1){
+				c[y * c_stride] = avx2_dot(&a[y * a_stride], b, k);
+			}
+			return;
+		}
+
+		static constexpr size_t MR = 6;
+		static constexpr size_t NR = 16;
+
+		gemm_blocked<MR, NR>(a, a_stride, b, b_stride, c, c_stride, m, n, k,
+			[&](const float* a_tile, const B* b_tile, float* c_tile, size_t rows, size_t cols, size_t kc, bool accumulate){
+				const auto dispatch_rows = [&]<bool MASKED>(){
+					switch(rows){
+						break; case 1: avx2_micro_kernel<1, MASKED>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+						break; case 2: avx2_micro_kernel<2, MASKED>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+						break; case 3: avx2_micro_kernel<3, MASKED>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+						break; case 4: avx2_micro_kernel<4, MASKED>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+						break; case 5: avx2_micro_kernel<5, MASKED>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+						break; case 6: avx2_micro_kernel<6, MASKED>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+						break; default: evo::debugFatalBreak("Invalid number of rows");
+					}
+				};
+
+				if(cols == NR){
+					dispatch_rows.template operator()<false>();
+				}else{
+					dispatch_rows.template operator()<true>();
+				}
+			}
+		);
+	}
+
+
+	// 1 x 64 tile (8 accumulators)
+	template<class B>
+	TIGRIS_TARGET_AVX2
+	static auto gemv_avx2(
+		const float* x,
+		const B* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void {
+		if(n == 1 && w_stride == 1){
+			y[0] = activate(activation, avx2_dot(x, w, k));
+			return;
+		}
+
+		static constexpr size_t NUM_VECTORS = GEMV_NR / 8;
+
+		for(size_t j = 0; j < n; j+=GEMV_NR){
+			const size_t cols = std::min(GEMV_NR, n - j);
+
+			__m256 acc[NUM_VECTORS];
+			for(size_t v = 0; v < NUM_VECTORS; v+=1){
+				acc[v] = _mm256_setzero_ps();
+			}
+
+			if(cols == GEMV_NR){
+				for(size_t p = 0; p < k; p+=1){
+					const __m256 x_value = _mm256_broadcast_ss(&x[p]);
+					const B* w_row = &w[p * w_stride + j];
+
+					for(size_t v = 0; v < NUM_VECTORS; v+=1){
+						acc[v] = _mm256_fmadd_ps(x_value, avx2_load(&w_row[v * 8]), acc[v]);
+					}
+				}
+			}else{
+				for(size_t p = 0; p < k; p+=1){
+					const __m256 x_value = _mm256_broadcast_ss(&x[p]);
+					const B* w_row = &w[p * w_stride + j];
+
+					for(size_t v = 0; v * 8 < cols; v+=1){
+						acc[v] = _mm256_fmadd_ps(x_value, avx2_load_partial(&w_row[v * 8], cols - v * 8), acc[v]);
+					}
+				}
+			}
+
+			alignas(32) float values[GEMV_NR];
+			for(size_t v = 0; v < NUM_VECTORS; v+=1){
+				_mm256_store_ps(&values[v * 8], acc[v]);
+			}
+
+			activate(activation, values, &y[j], cols);
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX-512
+
+	TIGRIS_TARGET_AVX512
+	static auto avx512_column_mask(size_t cols_remaining) -> __mmask16 {
+		if(cols_remaining >= 16){ return __mmask16(0xFFFF); }
+		return __mmask16((1u << cols_remaining) - 1);
+	}
+
+
+	// values of `b` selected by `mask` widened to fp32 (the rest are 0)
+	// 	The AVX512-BF16 dot product instructions are not used as they would need `a` to be rounded to bf16 as well.
+	template<class B>
+	TIGRIS_TARGET_AVX512
+	static auto avx512_load(const B* ptr, __mmask16 mask) -> __m512 {
+		if constexpr(std::is_same_v<B, float>){
+			return _mm512_maskz_loadu_ps(mask, ptr);
+
+		}else if constexpr(std::is_same_v<B, BF16>){
+			const __m256i bits = _mm256_maskz_loadu_epi16(mask, ptr);
+			return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(bits), 16));
+
+		}else{
+			static_assert(std::is_same_v<B, FP16>, "Unknown weight type");
+			return _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mask, ptr));
+		}
+	}
+
+
+	// 6 x 32 register tile (12 accumulators, 2 loads of `b`, 1 broadcast of `a`)
+	template<size_t ROWS, class B>
+	TIGRIS_TARGET_AVX512
+	static auto avx512_micro_kernel(
+		const float* a, size_t a_stride,
+		const B* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t cols, size_t kc, bool accumulate
+	) -> void {
+		const __mmask16 mask_0 = avx512_column_mask(cols);
+		const __mmask16 mask_1 = avx512_column_mask(cols > 16 ? cols - 16 : 0);
+
+		__m512 acc[ROWS][2];
+		for(size_t r = 0; r < ROWS; r+=1){
+			acc[r][0] = _mm512_setzero_ps();
+			acc[r][1] = _mm512_setzero_ps();
+		}
+
+		for(size_t p = 0; p < kc; p+=1){
+			const B* b_row = &b[p * b_stride];
+			const __m512 b_0 = avx512_load(b_row, mask_0);
+			const __m512 b_1 = avx512_load(b_row + 16, mask_1);
+
+			for(size_t r = 0; r < ROWS; r+=1){
+				const __m512 a_value = _mm512_set1_ps(a[r * a_stride + p]);
+				acc[r][0] = _mm512_fmadd_ps(a_value, b_0, acc[r][0]);
+				acc[r][1] = _mm512_fmadd_ps(a_value, b_1, acc[r][1]);
+			}
+		}
+
+		for(size_t r = 0; r < ROWS; r+=1){
+			float* c_row = &c[r * c_stride];
+
+			if(accumulate){
+				acc[r][0] = _mm512_add_ps(acc[r][0], _mm512_maskz_loadu_ps(mask_0, c_row));
+				acc[r][1] = _mm512_add_ps(acc[r][1], _mm512_maskz_loadu_ps(mask_1, c_row + 16));
+			}
+			_mm512_mask_storeu_ps(c_row, mask_0, acc[r][0]);
+			_mm512_mask_storeu_ps(c_row + 16, mask_1, acc[r][1]);
+		}
+	}
+
+
+	template<class B>
+	TIGRIS_TARGET_AVX512
+	static auto avx512_dot(const float* a, const B* b, size_t k) -> float {
+		__m512 acc = _mm512_setzero_ps();
+
+		for(size_t i = 0; i < k; i+=16){
+			const __mmask16 mask = avx512_column_mask(k - i);
+			acc = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, &a[i]), avx512_load(&b[i], mask), acc);
+		}
+
+		return _mm512_reduce_add_ps(acc);
+	}
+
+	// dot products of 4 independent problems (`a[e] . b[e]`), with their reductions done together
+	TIGRIS_TARGET_AVX512
+	static auto avx512_dot_4(const float* const* a, const float* const* b, size_t k) -> std::array<float, 4> {
+		__m512 acc[4] = {_mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps()};
+
+		for(size_t i = 0; i < k; i+=16){
+			const __mmask16 mask = avx512_column_mask(k - i);
+			for(size_t e = 0; e < 4; e+=1){
+				acc[e] = _mm512_fmadd_ps(
+					_mm512_maskz_loadu_ps(mask, &a[e][i]), _mm512_maskz_loadu_ps(mask, &b[e][i]), acc[e]
+				);
+			}
+		}
+
+		__m256 halves[4];
+		for(size_t e = 0; e < 4; e+=1){
+			halves[e] = _mm256_add_ps(_mm512_castps512_ps256(acc[e]), _mm512_extractf32x8_ps(acc[e], 1));
+		}
+
+		auto output = std::array<float, 4>();
+		_mm_storeu_ps(output.data(), avx2_reduce_4(halves));
+		return output;
+	}
+
+
+	template<class B>
+	TIGRIS_TARGET_AVX512
+	static auto gemm_avx512(
+		const float* a, size_t a_stride,
+		const B* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		if(n == 1 && b_stride == 1){
+			for(size_t y = 0; y < m; y+=1){
+				c[y * c_stride] = avx512_dot(&a[y * a_stride], b, k);
+			}
+			return;
+		}
+
+		static constexpr size_t MR = 6;
+		static constexpr size_t NR = 32;
+
+		gemm_blocked<MR, NR>(a, a_stride, b, b_stride, c, c_stride, m, n, k,
+			[&](const float* a_tile, const B* b_tile, float* c_tile, size_t rows, size_t cols, size_t kc, bool accumulate){
+				switch(rows){
+					break; case 1: avx512_micro_kernel<1>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+					break; case 2: avx512_micro_kernel<2>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+					break; case 3: avx512_micro_kernel<3>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+					break; case 4: avx512_micro_kernel<4>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+					break; case 5: avx512_micro_kernel<5>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+					break; case 6: avx512_micro_kernel<6>(a_tile, a_stride, b_tile, b_stride, c_tile, c_stride, cols, kc, accumulate);
+					break; default: evo::debugFatalBreak("Invalid number of rows");
+				}
+			}
+		);
+	}
+
+
+	// 1 x 64 tile (4 accumulators)
+	template<class B>
+	TIGRIS_TARGET_AVX512
+	static auto gemv_avx512(
+		const float* x,
+		const B* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void {
+		if(n == 1 && w_stride == 1){
+			y[0] = activate(activation, avx512_dot(x, w, k));
+			return;
+		}
+
+		static constexpr size_t NUM_VECTORS = GEMV_NR / 16;
+
+		for(size_t j = 0; j < n; j+=GEMV_NR){
+			const size_t cols = std::min(GEMV_NR, n - j);
+
+			__mmask16 masks[NUM_VECTORS];
+			__m512 acc[NUM_VECTORS];
+			for(size_t v = 0; v < NUM_VECTORS; v+=1){
+				masks[v] = avx512_column_mask(cols > v * 16 ? cols - v * 16 : 0);
+				acc[v] = _mm512_setzero_ps();
+			}
+
+			for(size_t p = 0; p < k; p+=1){
+				const __m512 x_value = _mm512_set1_ps(x[p]);
+				const B* w_row = &w[p * w_stride + j];
+
+				for(size_t v = 0; v < NUM_VECTORS; v+=1){
+					acc[v] = _mm512_fmadd_ps(x_value, avx512_load(&w_row[v * 16], masks[v]), acc[v]);
+				}
+			}
+
+			alignas(64) float values[GEMV_NR];
+			for(size_t v = 0; v < NUM_VECTORS; v+=1){
+				_mm512_store_ps(&values[v * 16], acc[v]);
+			}
+
+			activate(activation, values, &y[j], cols);
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// dispatch
+
+	template<class B>
+	struct GEMMImplementation{
+		GEMMFunc<B> gemm;
+		GEMVFunc<B> gemv;
+		std::string_view name;
+	};
+
+	using Dot4Func = auto(*)(const float* const*, const float* const*, size_t) -> std::array<float, 4>;
+
+	template<class B>
+	static auto select_implementation() -> const GEMMImplementation<B>& {
+		static const GEMMImplementation<B> implementation = []() -> GEMMImplementation<B> {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512f){ return GEMMImplementation<B>(&gemm_avx512<B>, &gemv_avx512<B>, "avx512"); }
+			if(cpu_features.avx2){ return GEMMImplementation<B>(&gemm_avx2<B>, &gemv_avx2<B>, "avx2"); }
+			return GEMMImplementation<B>(&gemm_scalar<B>, &gemv_scalar<B>, "scalar");
+		}();
+
+		return implementation;
+	}
+
+	static auto select_dot_4() -> Dot4Func {
+		static const Dot4Func dot_4 = []() -> Dot4Func {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512f){ return &avx512_dot_4; }
+			if(cpu_features.avx2){ return &avx2_dot_4; }
+			return &scalar_dot_4;
+		}();
+
+		return dot_4;
+	}
+
+
+	template<class B>
+	static auto gemm_impl(
+		const float* a, size_t a_stride,
+		const B* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		if(m == 0 || n == 0){ return; }
+
+		if(k == 0){
+			for(size_t y = 0; y < m; y+=1){
+				std::memset(&c[y * c_stride], 0, n * sizeof(float));
+			}
+			return;
+		}
+
+		select_implementation<B>().gemm(a, a_stride, b, b_stride, c, c_stride, m, n, k);
+	}
+
+
+	template<class B>
+	static auto gemv_impl(
+		const float* x,
+		const B* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void {
+		if(n == 0){ return; }
+
+		if(k == 0){
+			for(size_t j = 0; j < n; j+=1){
+				y[j] = activate(activation, 0.0f);
+			}
+			return;
+		}
+
+		select_implementation<B>().gemv(x, w, w_stride, y, n, k, activation);
+	}
+
+
+
+	auto gemm(
+		const float* a, size_t a_stride,
+		const float* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		gemm_impl(a, a_stride, b, b_stride, c, c_stride, m, n, k);
+	}
+
+	auto gemm(
+		const float* a, size_t a_stride,
+		const BF16* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		gemm_impl(a, a_stride, b, b_stride, c, c_stride, m, n, k);
+	}
+
+	auto gemm(
+		const float* a, size_t a_stride,
+		const FP16* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		gemm_impl(a, a_stride, b, b_stride, c, c_stride, m, n, k);
+	}
+
+
+	auto gemv(
+		const float* x,
+		const float* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void {
+		gemv_impl(x, w, w_stride, y, n, k, activation);
+	}
+
+	auto gemv(
+		const float* x,
+		const BF16* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void {
+		gemv_impl(x, w, w_stride, y, n, k, activation);
+	}
+
+	auto gemv(
+		const float* x,
+		const FP16* w, size_t w_stride,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void {
+		gemv_impl(x, w, w_stride, y, n, k, activation);
+	}
+
+
+	auto gemmBatched(std::span<const GEMMBatchEntry> batch, size_t m, size_t n, size_t k) -> void {
+		if(m == 0 || n == 0 || k == 0){
+			for(const GEMMBatchEntry& entry : batch){
+				gemm_impl(entry.a, entry.a_stride, entry.b, entry.b_stride, entry.c, entry.c_stride, m, n, k);
+			}
+			return;
+		}
+
+		const GEMMImplementation<float>& implementation = select_implementation<float>();
+
+		// column vector products only use one lane of the GEMM kernels, so their dot products (every row of every
+		// 	product, in order) are done 4 at a time instead
+		const bool packed_columns = std::ranges::all_of(batch, [](const GEMMBatchEntry& entry){
+			return entry.b_stride == 1;
+		});
+		if(n == 1 && packed_columns){
+			const Dot4Func dot_4 = select_dot_4();
+
+			// dot products waiting for a group of 4
+			const float* a_rows[4];
+			const float* b_columns[4];
+			float* c_values[4];
+			size_t num_pending = 0;
+
+			for(const GEMMBatchEntry& entry : batch){
+				for(size_t row = 0; row < m; row+=1){
+					a_rows[num_pending] = &entry.a[row * entry.a_stride];
+					b_columns[num_pending] = entry.b;
+					c_values[num_pending] = &entry.c[row * entry.c_stride];
+					num_pending += 1;
+
+					if(num_pending == 4){
+						const std::array<float, 4> values = dot_4(a_rows, b_columns, k);
+						for(size_t d = 0; d < 4; d+=1){
+							*c_values[d] = values[d];
+						}
+						num_pending = 0;
+					}
+				}
+			}
+
+			for(size_t d = 0; d < num_pending; d+=1){
+				implementation.gemm(a_rows[d], k, b_columns[d], 1, c_values[d], 1, 1, 1, k);
+			}
+			return;
+		}
+
+		for(const GEMMBatchEntry& entry : batch){
+			implementation.gemm(entry.a, entry.a_stride, entry.b, entry.b_stride, entry.c, entry.c_stride, m, n, k);
+		}
+	}
+
+
+	auto gemmReference(
+		const float* a, size_t a_stride,
+		const float* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		for(size_t x = 0; x < n; x+=1){
+			for(size_t y = 0; y < m; y+=1){
+				float value = 0.0f;
+
+				for(size_t i = 0; i < k; i+=1){
+					value += a[y * a_stride + i] * b[i * b_stride + x];
+				}
+
+				c[y * c_stride + x] = value;
+			}
+		}
+	}
+
+
+	auto gemmImplementationName() -> std::string_view {
+		return select_implementation<float>().name;
+	}
+
+
+}
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/gemm.h>
+
+#include <ThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+
+
+namespace tigris::kernels{
+
+	// Size of the tiles of `c` given to each task.
+	// 	TILE_N is a multiple of every SIMD width (and of the `tigris::Matrix` stride padding) so only the last tile
+	// 	of a row has a partial register tile
+	static constexpr size_t TILE_M = 96;
+	static constexpr size_t TILE_N = 256;
+
+
+	// false (without calculating anything) if the thread pool can not be used right now
+	static auto gemm_tiled(
+		const float* a, size_t a_stride,
+		const float* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> bool {
+		// skinny outputs (a few boards, but a wide layer) are split over the columns instead
+		const size_t tile_m = TILE_M;
+		const size_t tile_n = m < TILE_M ? std::max<size_t>(32, TILE_N / ThreadPool::get().numThreads() / 32 * 32) : TILE_N;
+
+		const size_t num_tiles_m = (m + tile_m - 1) / tile_m;
+		const size_t num_tiles_n = (n + tile_n - 1) / tile_n;
+
+		return ThreadPool::get().tryParallelFor(num_tiles_m * num_tiles_n, [&](size_t tile){
+			const size_t tile_y = (tile / num_tiles_n) * tile_m;
+			const size_t tile_x = (tile % num_tiles_n) * tile_n;
+
+			gemm(
+				&a[tile_y * a_stride], a_stride,
+				&b[tile_x], b_stride,
+				&c[tile_y * c_stride + tile_x], c_stride,
+				std::min(tile_m, m - tile_y), std::min(tile_n, n - tile_x), k
+			);
+		});
+	}
+
+
+	static auto parallel_gemm_threshold = std::atomic<size_t>(DEFAULT_PARALLEL_GEMM_THRESHOLD);
+
+
+	// nullopt if the thread pool was in use by another thread during the measurement
+	static auto measure_parallel_gemm_threshold() -> std::optional<size_t> {
+		if(ThreadPool::get().numThreads() == 1){ return std::numeric_limits<size_t>::max(); }
+
+		using Clock = std::chrono::steady_clock;
+
+		// best of a few runs to ignore scheduling noise
+		const auto time_seconds = [](auto&& func) -> std::optional<double> {
+			double best = std::numeric_limits<double>::max();
+			for(size_t i = 0; i < 5; i+=1){
+				const Clock::time_point start = Clock::now();
+				if(func() == false){ return std::nullopt; }
+				best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+			}
+			return best;
+		};
+
+		for(size_t size = 32; size <= 512; size*=2){
+			auto a = std::vector<float>(size * size, 1.0f);
+			auto b = std::vector<float>(size * size, 1.0f);
+			auto c = std::vector<float>(size * size);
+
+			const std::optional<double> serial_seconds = time_seconds([&](){
+				gemm(a.data(), size, b.data(), size, c.data(), size, size, size, size);
+				return true;
+			});
+			const std::optional<double> parallel_seconds = time_seconds([&](){
+				return gemm_tiled(a.data(), size, b.data(), size, c.data(), size, size, size, size);
+			});
+
+			if(parallel_seconds.has_value() == false){ return std::nullopt; }
+			if(*parallel_seconds < *serial_seconds * 0.9){ return size * size * size; }
+		}
+
+		return std::numeric_limits<size_t>::max();
+	}
+
+
+	auto parallelGEMMThreshold() -> size_t {
+		return parallel_gemm_threshold.load(std::memory_order_relaxed);
+	}
+
+	auto calibrateParallelGEMM() -> bool {
+		const std::optional<size_t> threshold = measure_parallel_gemm_threshold();
+		if(threshold.has_value() == false){ return false; }
+
+		parallel_gemm_threshold.store(*threshold, std::memory_order_relaxed);
+		return true;
+	}
+
+
+	auto gemmParallel(
+		const float* a, size_t a_stride,
+		const float* b, size_t b_stride,
+		float* c, size_t c_stride,
+		size_t m, size_t n, size_t k
+	) -> void {
+		if(ThreadPool::isInsideTask() || m * n * k < parallelGEMMThreshold()){
+			gemm(a, a_stride, b, b_stride, c, c_stride, m, n, k);
+			return;
+		}
+
+		// another thread is using the thread pool
+		if(gemm_tiled(a, a_stride, b, b_stride, c, c_stride, m, n, k) == false){
+			gemm(a, a_stride, b, b_stride, c, c_stride, m, n, k);
+		}
+	}
+
+
+	auto gemmBatchedParallel(std::span<const GEMMBatchEntry> batch, size_t m, size_t n, size_t k) -> void {
+		if(ThreadPool::isInsideTask() || batch.size() * m * n * k < parallelGEMMThreshold()){
+			gemmBatched(batch, m, n, k);
+			return;
+		}
+
+		// a few chunks per thread so uneven progress between the threads evens out
+		const size_t num_chunks = std::min(batch.size(), ThreadPool::get().numThreads() * 4);
+		const size_t chunk_size = (batch.size() + num_chunks - 1) / num_chunks;
+
+		ThreadPool::get().parallelFor(num_chunks, [&](size_t chunk){
+			const size_t first = chunk * chunk_size;
+			if(first >= batch.size()){ return; }
+
+			gemmBatched(batch.subspan(first, std::min(chunk_size, batch.size() - first)), m, n, k);
+		});
+	}
+
+
+}
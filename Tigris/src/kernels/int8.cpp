@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/int8.h>
+
+#include <kernels/cpu.h>
+
+#include <immintrin.h>
+
+
+namespace tigris::kernels{
+
+	static constexpr size_t BLOCK_BYTES = INT8_BLOCK_COLUMNS * INT8_GROUP_SIZE;
+
+
+	// rounds half away from zero (without a call into libm, so the loops using it can be vectorized)
+	static auto round_to_int8(float value) -> int8_t {
+		const float clamped = std::clamp(value, -127.0f, 127.0f);
+		return int8_t(int32_t(clamped + (clamped >= 0.0f ? 0.5f : -0.5f)));
+	}
+
+
+	auto quantizeInt8(const float* input, int8_t* output, size_t count) -> float {
+		float max_abs = 0.0f;
+		for(size_t i = 0; i < count; i+=1){
+			max_abs = std::max(max_abs, std::abs(input[i]));
+		}
+
+		if(max_abs == 0.0f){
+			std::memset(output, 0, count);
+			return 1.0f;
+		}
+
+		const float scale = max_abs / 127.0f;
+		const float inverse_scale = 127.0f / max_abs;
+		for(size_t i = 0; i < count; i+=1){
+			output[i] = round_to_int8(input[i] * inverse_scale);
+		}
+
+		return scale;
+	}
+
+
+	auto packInt8Weights(
+		const float* w, size_t w_stride,
+		int8_t* packed, float* scales, int32_t* column_sums,
+		size_t n, size_t k
+	) -> void {
+		const size_t padded_columns = int8PaddedColumns(n);
+		const size_t padded_rows = int8PaddedRows(k);
+		const size_t num_groups = padded_rows / INT8_GROUP_SIZE;
+
+		std::memset(packed, 0, padded_rows * padded_columns);
+
+		for(size_t j = 0; j < padded_columns; j+=1){
+			scales[j] = 0.0f;
+			column_sums[j] = 0;
+			if(j >= n){ continue; }
+
+			float max_abs = 0.0f;
+			for(size_t p = 0; p < k; p+=1){
+				max_abs = std::max(max_abs, std::abs(w[p * w_stride + j]));
+			}
+			if(max_abs == 0.0f){ continue; }
+
+			scales[j] = max_abs / 127.0f;
+			const float inverse_scale = 127.0f / max_abs;
+
+			const size_t block = j / INT8_BLOCK_COLUMNS;
+			const size_t column = j % INT8_BLOCK_COLUMNS;
+
+			for(size_t p = 0; p < k; p+=1){
+				const int8_t value = round_to_int8(w[p * w_stride + j] * inverse_scale);
+
+				const size_t group = p / INT8_GROUP_SIZE;
+				const size_t offset = (block * num_groups + group) * INT8_BLOCK_COLUMNS + column;
+				packed[offset * INT8_GROUP_SIZE + p % INT8_GROUP_SIZE] = value;
+				column_sums[j] += value;
+			}
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// int32 dot products of one block of 16 columns
+
+	static auto block_scalar(
+		const int8_t* x, const int8_t* w, const int32_t*, int32_t* acc, size_t num_groups
+	) -> void {
+		for(size_t column = 0; column < INT8_BLOCK_COLUMNS; column+=1){
+			acc[column] = 0;
+		}
+
+		for(size_t group = 0; group < num_groups; group+=1){
+			const int8_t* x_group = &x[group * INT8_GROUP_SIZE];
+			const int8_t* w_group = &w[group * BLOCK_BYTES];
+
+			for(size_t column = 0; column < INT8_BLOCK_COLUMNS; column+=1){
+				for(size_t i = 0; i < INT8_GROUP_SIZE; i+=1){
+					acc[column] += int32_t(x_group[i]) * int32_t(w_group[column * INT8_GROUP_SIZE + i]);
+				}
+			}
+		}
+	}
+
+
+	// `maddubs` multiplies unsigned by signed bytes, so the sign of `x` is moved onto `w`. Both are in [-127, 127],
+	// 	so the pairs summed into 16 bits are at most 2 * 127 * 127 and never saturate.
+	TIGRIS_TARGET_AVX2
+	static auto block_avx2(
+		const int8_t* x, const int8_t* w, const int32_t*, int32_t* acc, size_t num_groups
+	) -> void {
+		const __m256i ones = _mm256_set1_epi16(1);
+
+		__m256i acc_0 = _mm256_setzero_si256();
+		__m256i acc_1 = _mm256_setzero_si256();
+
+		for(size_t group = 0; group < num_groups; group+=1){
+			int32_t x_word;
+			std::memcpy(&x_word, &x[group * INT8_GROUP_SIZE], sizeof(int32_t));
+
+			const __m256i x_values = _mm256_set1_epi32(x_word);
+			const __m256i x_abs = _mm256_abs_epi8(x_values);
+
+			const __m256i w_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&w[group * BLOCK_BYTES]));
+			const __m256i w_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&w[group * BLOCK_BYTES + 32]));
+
+			const __m256i products_0 = _mm256_maddubs_epi16(x_abs, _mm256_sign_epi8(w_0, x_values));
+			const __m256i products_1 = _mm256_maddubs_epi16(x_abs, _mm256_sign_epi8(w_1, x_values));
+
+			acc_0 = _mm256_add_epi32(acc_0, _mm256_madd_epi16(products_0, ones));
+			acc_1 = _mm256_add_epi32(acc_1, _mm256_madd_epi16(products_1, ones));
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&acc[0]), acc_0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&acc[8]), acc_1);
+	}
+
+
+	// `vpdpbusd` multiplies unsigned by signed bytes, so `x` is offset by 128 and `128 * sum(w)` is taken off again
+	TIGRIS_TARGET_AVX512_VNNI
+	static auto block_avx512_vnni(
+		const int8_t* x, const int8_t* w, const int32_t* column_sums, int32_t* acc, size_t num_groups
+	) -> void {
+		const __m512i offset = _mm512_set1_epi8(char(0x80));
+
+		__m512i acc_0 = _mm512_setzero_si512();
+		__m512i acc_1 = _mm512_setzero_si512();
+
+		size_t group = 0;
+		for(; group + 2 <= num_groups; group+=2){
+			int32_t x_words[2];
+			std::memcpy(x_words, &x[group * INT8_GROUP_SIZE], sizeof(x_words));
+
+			const __m512i x_0 = _mm512_xor_si512(_mm512_set1_epi32(x_words[0]), offset);
+			const __m512i x_1 = _mm512_xor_si512(_mm512_set1_epi32(x_words[1]), offset);
+
+			acc_0 = _mm512_dpbusd_epi32(acc_0, x_0, _mm512_loadu_si512(&w[group * BLOCK_BYTES]));
+			acc_1 = _mm512_dpbusd_epi32(acc_1, x_1, _mm512_loadu_si512(&w[(group + 1) * BLOCK_BYTES]));
+		}
+		for(; group < num_groups; group+=1){
+			int32_t x_word;
+			std::memcpy(&x_word, &x[group * INT8_GROUP_SIZE], sizeof(int32_t));
+
+			const __m512i x_values = _mm512_xor_si512(_mm512_set1_epi32(x_word), offset);
+			acc_0 = _mm512_dpbusd_epi32(acc_0, x_values, _mm512_loadu_si512(&w[group * BLOCK_BYTES]));
+		}
+
+		const __m512i correction = _mm512_slli_epi32(_mm512_loadu_si512(column_sums), 7);
+		_mm512_storeu_si512(acc, _mm512_sub_epi32(_mm512_add_epi32(acc_0, acc_1), correction));
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// dispatch
+
+	using BlockFunc = auto(*)(const int8_t*, const int8_t*, const int32_t*, int32_t*, size_t) -> void;
+
+	struct Int8Implementation{
+		BlockFunc block;
+		std::string_view name;
+	};
+
+	static auto select_implementation() -> const Int8Implementation& {
+		static const Int8Implementation implementation = []() -> Int8Implementation {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512vnni){ return Int8Implementation(&block_avx512_vnni, "avx512-vnni"); }
+			if(cpu_features.avx2){ return Int8Implementation(&block_avx2, "avx2"); }
+			return Int8Implementation(&block_scalar, "scalar");
+		}();
+
+		return implementation;
+	}
+
+
+	auto gemvInt8(
+		const int8_t* x, float x_scale,
+		const int8_t* w, const float* w_scales, const int32_t* w_column_sums,
+		float* y,
+		size_t n, size_t k,
+		Activation activation
+	) -> void {
+		const size_t padded_columns = int8PaddedColumns(n);
+		const size_t num_groups = int8PaddedRows(k) / INT8_GROUP_SIZE;
+		const BlockFunc block_func = select_implementation().block;
+
+		for(size_t j = 0; j < padded_columns; j+=INT8_BLOCK_COLUMNS){
+			alignas(64) int32_t acc[INT8_BLOCK_COLUMNS];
+			block_func(x, &w[j * num_groups * INT8_GROUP_SIZE], &w_column_sums[j], acc, num_groups);
+
+			alignas(64) float values[INT8_BLOCK_COLUMNS];
+			for(size_t column = 0; column < INT8_BLOCK_COLUMNS; column+=1){
+				values[column] = float(acc[column]) * (x_scale * w_scales[j + column]);
+			}
+
+			activate(activation, values, &y[j], std::min(INT8_BLOCK_COLUMNS, n - j));
+		}
+	}
+
+
+	auto int8ImplementationName() -> std::string_view {
+		return select_implementation().name;
+	}
+
+
+}
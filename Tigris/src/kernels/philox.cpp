@@ -0,0 +1,444 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/philox.h>
+
+#include <kernels/cpu.h>
+
+#include <immintrin.h>
+#include <numbers>
+
+
+namespace tigris::kernels{
+
+	// writes chunk `chunk` of `stream` into `output` (`PHILOX_CHUNK_SIZE` values)
+	using ChunkFunc = auto(*)(float*, const RandomStream&, uint32_t) -> void;
+
+	static constexpr size_t CHUNK_COUNTERS = PHILOX_CHUNK_SIZE / 4;
+
+
+	static auto to_key(const RandomStream& stream) -> std::array<uint32_t, 2> {
+		return std::array<uint32_t, 2>{uint32_t(stream.seed), uint32_t(stream.seed >> 32)};
+	}
+
+	// 24 random bits so every value is exactly representable and < 1
+	static auto to_uniform01(uint32_t bits) -> float {
+		return float(bits >> 8) * 0x1p-24f;
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// scalar
+
+	static auto chunk_scalar(float* output, const RandomStream& stream, uint32_t chunk) -> void {
+		const std::array<uint32_t, 2> key = to_key(stream);
+
+		for(size_t lane = 0; lane < CHUNK_COUNTERS; lane+=1){
+			const std::array<uint32_t, 4> words = philox4x32(
+				std::array<uint32_t, 4>{
+					chunk * uint32_t(CHUNK_COUNTERS) + uint32_t(lane),
+					stream.sub_id,
+					uint32_t(stream.id),
+					uint32_t(stream.id >> 32),
+				},
+				key
+			);
+
+			for(size_t word = 0; word < 4; word+=1){
+				output[word * CHUNK_COUNTERS + lane] = to_uniform01(words[word]);
+			}
+		}
+	}
+
+
+
+	// Box-Muller on a chunk (in place): the pair (u[i], u[i + 32]) becomes (r * cos(a), r * sin(a)) with
+	// 	r = sqrt(-2 * log(1 - u[i])) and a = 2 * pi * u[i + 32]
+	static auto box_muller_scalar(float* values) -> void {
+		for(size_t i = 0; i < PHILOX_CHUNK_SIZE / 2; i+=1){
+			const float radius = std::sqrt(-2.0f * std::log(1.0f - values[i]));
+			const float angle = 2.0f * std::numbers::pi_v<float> * values[i + PHILOX_CHUNK_SIZE / 2];
+
+			values[i] = radius * std::cos(angle);
+			values[i + PHILOX_CHUNK_SIZE / 2] = radius * std::sin(angle);
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// Box-Muller constants for the SIMD versions
+
+	// log(x) = t + t^3 * P(t) - t^2 / 2 + e * log(2) (Cephes `logf`), with x = 2^e * (1 + t), sqrt(1/2) <= 1 + t < sqrt(2)
+	static constexpr auto LOG_POLYNOMIAL = std::to_array<float>({
+		7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f, -1.2420140846e-1f, 1.4249322787e-1f,
+		-1.6668057665e-1f, 2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f,
+	});
+	static constexpr float LOG_2_HIGH = 0.693359375f;
+	static constexpr float LOG_2_LOW = -2.12194440e-4f;
+	static constexpr float SQRT_HALF = 0.707106781186547524f;
+
+	// sin(a) and cos(a) for |a| <= pi / 4 (Cephes `sinf` / `cosf`). The angle is first reduced by quarter turns.
+	static constexpr auto SIN_POLYNOMIAL = std::to_array<float>({-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f});
+	static constexpr auto COS_POLYNOMIAL = std::to_array<float>({2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f});
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX2
+
+	// high and low 32 bits of `a * multiplier` for each lane
+	TIGRIS_TARGET_AVX2
+	static auto avx2_mulhilo(__m256i a, __m256i multiplier, __m256i& hi, __m256i& lo) -> void {
+		const __m256i even = _mm256_mul_epu32(a, multiplier);
+		const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), multiplier);
+
+		lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b1010'1010);
+		hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0b1010'1010);
+	}
+
+	TIGRIS_TARGET_AVX2
+	static auto avx2_to_uniform01(__m256i bits) -> __m256 {
+		return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(bits, 8)), _mm256_set1_ps(0x1p-24f));
+	}
+
+	// 8 counters at a time (structure of arrays: `c[i]` is word `i` of each counter)
+	TIGRIS_TARGET_AVX2
+	static auto chunk_avx2(float* output, const RandomStream& stream, uint32_t chunk) -> void {
+		const __m256i multiplier_0 = _mm256_set1_epi32(int(0xD251'1F53));
+		const __m256i multiplier_1 = _mm256_set1_epi32(int(0xCD9E'8D57));
+
+		for(size_t half = 0; half < CHUNK_COUNTERS; half+=8){
+			const int first_counter = int(chunk * uint32_t(CHUNK_COUNTERS) + uint32_t(half));
+
+			__m256i c[4] = {
+				_mm256_add_epi32(_mm256_set1_epi32(first_counter), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)),
+				_mm256_set1_epi32(int(stream.sub_id)),
+				_mm256_set1_epi32(int(uint32_t(stream.id))),
+				_mm256_set1_epi32(int(uint32_t(stream.id >> 32))),
+			};
+
+			std::array<uint32_t, 2> key = to_key(stream);
+
+			for(size_t round = 0; round < 10; round+=1){
+				__m256i hi_0, lo_0, hi_1, lo_1;
+				avx2_mulhilo(c[0], multiplier_0, hi_0, lo_0);
+				avx2_mulhilo(c[2], multiplier_1, hi_1, lo_1);
+
+				c[0] = _mm256_xor_si256(_mm256_xor_si256(hi_1, c[1]), _mm256_set1_epi32(int(key[0])));
+				c[1] = lo_1;
+				c[2] = _mm256_xor_si256(_mm256_xor_si256(hi_0, c[3]), _mm256_set1_epi32(int(key[1])));
+				c[3] = lo_0;
+
+				key[0] += 0x9E37'79B9;
+				key[1] += 0xBB67'AE85;
+			}
+
+			for(size_t word = 0; word < 4; word+=1){
+				_mm256_storeu_ps(&output[word * CHUNK_COUNTERS + half], avx2_to_uniform01(c[word]));
+			}
+		}
+	}
+
+
+
+	// log(x) for x in (0, 1]
+	TIGRIS_TARGET_AVX2
+	static auto avx2_log(__m256 x) -> __m256 {
+		const __m256i bits = _mm256_castps_si256(x);
+
+		// x = 2^exponent * mantissa, mantissa in [0.5, 1)
+		__m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+		const __m256 mantissa = _mm256_castsi256_ps(
+			_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007F'FFFF)), _mm256_set1_epi32(0x3F00'0000))
+		);
+
+		// move the mantissa to [sqrt(1/2), sqrt(2))
+		const __m256 is_small = _mm256_cmp_ps(mantissa, _mm256_set1_ps(SQRT_HALF), _CMP_LT_OQ);
+		exponent = _mm256_sub_ps(exponent, _mm256_and_ps(is_small, _mm256_set1_ps(1.0f)));
+		const __m256 t = _mm256_add_ps(
+			_mm256_sub_ps(mantissa, _mm256_set1_ps(1.0f)), _mm256_and_ps(is_small, mantissa)
+		);
+
+		const __m256 t2 = _mm256_mul_ps(t, t);
+		__m256 polynomial = _mm256_set1_ps(LOG_POLYNOMIAL[0]);
+		for(size_t i = 1; i < LOG_POLYNOMIAL.size(); i+=1){
+			polynomial = _mm256_fmadd_ps(polynomial, t, _mm256_set1_ps(LOG_POLYNOMIAL[i]));
+		}
+
+		__m256 y = _mm256_mul_ps(_mm256_mul_ps(t, t2), polynomial);
+		y = _mm256_fmadd_ps(exponent, _mm256_set1_ps(LOG_2_LOW), y);
+		y = _mm256_fmadd_ps(t2, _mm256_set1_ps(-0.5f), y);
+		return _mm256_fmadd_ps(exponent, _mm256_set1_ps(LOG_2_HIGH), _mm256_add_ps(t, y));
+	}
+
+	TIGRIS_TARGET_AVX2
+	static auto box_muller_avx2(float* values) -> void {
+		for(size_t i = 0; i < PHILOX_CHUNK_SIZE / 2; i+=8){
+			const __m256 u_radius = _mm256_loadu_ps(&values[i]);
+			const __m256 u_angle = _mm256_loadu_ps(&values[i + PHILOX_CHUNK_SIZE / 2]);
+
+			const __m256 radius = _mm256_sqrt_ps(
+				_mm256_mul_ps(_mm256_set1_ps(-2.0f), avx2_log(_mm256_sub_ps(_mm256_set1_ps(1.0f), u_radius)))
+			);
+
+			// angle = 2 * pi * (quarter / 4 + t), |t| <= 1/8
+			const __m256 quarter = _mm256_round_ps(
+				_mm256_mul_ps(u_angle, _mm256_set1_ps(4.0f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC
+			);
+			const __m256 a = _mm256_mul_ps(
+				_mm256_fnmadd_ps(quarter, _mm256_set1_ps(0.25f), u_angle), _mm256_set1_ps(2.0f * std::numbers::pi_v<float>)
+			);
+			const __m256 a2 = _mm256_mul_ps(a, a);
+
+			__m256 sin_a = _mm256_set1_ps(SIN_POLYNOMIAL[0]);
+			__m256 cos_a = _mm256_set1_ps(COS_POLYNOMIAL[0]);
+			for(size_t p = 1; p < SIN_POLYNOMIAL.size(); p+=1){
+				sin_a = _mm256_fmadd_ps(sin_a, a2, _mm256_set1_ps(SIN_POLYNOMIAL[p]));
+				cos_a = _mm256_fmadd_ps(cos_a, a2, _mm256_set1_ps(COS_POLYNOMIAL[p]));
+			}
+			sin_a = _mm256_fmadd_ps(_mm256_mul_ps(sin_a, a2), a, a);
+			cos_a = _mm256_fmadd_ps(_mm256_mul_ps(cos_a, a2), a2, _mm256_fnmadd_ps(a2, _mm256_set1_ps(0.5f), _mm256_set1_ps(1.0f)));
+
+			// rotate by the quarter turns
+			const __m256i quarter_int = _mm256_cvtps_epi32(quarter);
+			const __m256 swap = _mm256_castsi256_ps(
+				_mm256_cmpeq_epi32(_mm256_and_si256(quarter_int, _mm256_set1_epi32(1)), _mm256_set1_epi32(1))
+			);
+			const __m256 cos_sign = _mm256_castsi256_ps(_mm256_slli_epi32(
+				_mm256_and_si256(_mm256_add_epi32(quarter_int, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30
+			));
+			const __m256 sin_sign = _mm256_castsi256_ps(
+				_mm256_slli_epi32(_mm256_and_si256(quarter_int, _mm256_set1_epi32(2)), 30)
+			);
+			const __m256 cos_angle = _mm256_xor_ps(_mm256_blendv_ps(cos_a, sin_a, swap), cos_sign);
+			const __m256 sin_angle = _mm256_xor_ps(_mm256_blendv_ps(sin_a, cos_a, swap), sin_sign);
+
+			_mm256_storeu_ps(&values[i], _mm256_mul_ps(radius, cos_angle));
+			_mm256_storeu_ps(&values[i + PHILOX_CHUNK_SIZE / 2], _mm256_mul_ps(radius, sin_angle));
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX-512
+
+	TIGRIS_TARGET_AVX512
+	static auto avx512_mulhilo(__m512i a, __m512i multiplier, __m512i& hi, __m512i& lo) -> void {
+		const __m512i even = _mm512_mul_epu32(a, multiplier);
+		const __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), multiplier);
+
+		lo = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+		hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+	}
+
+	TIGRIS_TARGET_AVX512
+	static auto avx512_to_uniform01(__m512i bits) -> __m512 {
+		return _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(bits, 8)), _mm512_set1_ps(0x1p-24f));
+	}
+
+	// all 16 counters of the chunk at once
+	TIGRIS_TARGET_AVX512
+	static auto chunk_avx512(float* output, const RandomStream& stream, uint32_t chunk) -> void {
+		const __m512i multiplier_0 = _mm512_set1_epi32(int(0xD251'1F53));
+		const __m512i multiplier_1 = _mm512_set1_epi32(int(0xCD9E'8D57));
+
+		const int first_counter = int(chunk * uint32_t(CHUNK_COUNTERS));
+
+		__m512i c[4] = {
+			_mm512_add_epi32(
+				_mm512_set1_epi32(first_counter),
+				_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+			),
+			_mm512_set1_epi32(int(stream.sub_id)),
+			_mm512_set1_epi32(int(uint32_t(stream.id))),
+			_mm512_set1_epi32(int(uint32_t(stream.id >> 32))),
+		};
+
+		std::array<uint32_t, 2> key = to_key(stream);
+
+		for(size_t round = 0; round < 10; round+=1){
+			__m512i hi_0, lo_0, hi_1, lo_1;
+			avx512_mulhilo(c[0], multiplier_0, hi_0, lo_0);
+			avx512_mulhilo(c[2], multiplier_1, hi_1, lo_1);
+
+			c[0] = _mm512_ternarylogic_epi32(hi_1, c[1], _mm512_set1_epi32(int(key[0])), 0x96); // a ^ b ^ c
+			c[1] = lo_1;
+			c[2] = _mm512_ternarylogic_epi32(hi_0, c[3], _mm512_set1_epi32(int(key[1])), 0x96);
+			c[3] = lo_0;
+
+			key[0] += 0x9E37'79B9;
+			key[1] += 0xBB67'AE85;
+		}
+
+		for(size_t word = 0; word < 4; word+=1){
+			_mm512_storeu_ps(&output[word * CHUNK_COUNTERS], avx512_to_uniform01(c[word]));
+		}
+	}
+
+
+
+	// log(x) for x in (0, 1]
+	TIGRIS_TARGET_AVX512
+	static auto avx512_log(__m512 x) -> __m512 {
+		const __m512i bits = _mm512_castps_si512(x);
+
+		// x = 2^exponent * mantissa, mantissa in [0.5, 1)
+		__m512 exponent = _mm512_cvtepi32_ps(_mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(126)));
+		const __m512 mantissa = _mm512_castsi512_ps(
+			_mm512_ternarylogic_epi32(bits, _mm512_set1_epi32(0x007F'FFFF), _mm512_set1_epi32(0x3F00'0000), 0xEA)
+		); // (a & b) | c
+
+		// move the mantissa to [sqrt(1/2), sqrt(2))
+		const __mmask16 is_small = _mm512_cmp_ps_mask(mantissa, _mm512_set1_ps(SQRT_HALF), _CMP_LT_OQ);
+		exponent = _mm512_mask_sub_ps(exponent, is_small, exponent, _mm512_set1_ps(1.0f));
+		__m512 t = _mm512_sub_ps(mantissa, _mm512_set1_ps(1.0f));
+		t = _mm512_mask_add_ps(t, is_small, t, mantissa);
+
+		const __m512 t2 = _mm512_mul_ps(t, t);
+		__m512 polynomial = _mm512_set1_ps(LOG_POLYNOMIAL[0]);
+		for(size_t i = 1; i < LOG_POLYNOMIAL.size(); i+=1){
+			polynomial = _mm512_fmadd_ps(polynomial, t, _mm512_set1_ps(LOG_POLYNOMIAL[i]));
+		}
+
+		__m512 y = _mm512_mul_ps(_mm512_mul_ps(t, t2), polynomial);
+		y = _mm512_fmadd_ps(exponent, _mm512_set1_ps(LOG_2_LOW), y);
+		y = _mm512_fmadd_ps(t2, _mm512_set1_ps(-0.5f), y);
+		return _mm512_fmadd_ps(exponent, _mm512_set1_ps(LOG_2_HIGH), _mm512_add_ps(t, y));
+	}
+
+	TIGRIS_TARGET_AVX512
+	static auto box_muller_avx512(float* values) -> void {
+		for(size_t i = 0; i < PHILOX_CHUNK_SIZE / 2; i+=16){
+			const __m512 u_radius = _mm512_loadu_ps(&values[i]);
+			const __m512 u_angle = _mm512_loadu_ps(&values[i + PHILOX_CHUNK_SIZE / 2]);
+
+			const __m512 radius = _mm512_sqrt_ps(
+				_mm512_mul_ps(_mm512_set1_ps(-2.0f), avx512_log(_mm512_sub_ps(_mm512_set1_ps(1.0f), u_radius)))
+			);
+
+			// angle = 2 * pi * (quarter / 4 + t), |t| <= 1/8
+			const __m512 quarter = _mm512_roundscale_ps(
+				_mm512_mul_ps(u_angle, _mm512_set1_ps(4.0f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC
+			);
+			const __m512 a = _mm512_mul_ps(
+				_mm512_fnmadd_ps(quarter, _mm512_set1_ps(0.25f), u_angle), _mm512_set1_ps(2.0f * std::numbers::pi_v<float>)
+			);
+			const __m512 a2 = _mm512_mul_ps(a, a);
+
+			__m512 sin_a = _mm512_set1_ps(SIN_POLYNOMIAL[0]);
+			__m512 cos_a = _mm512_set1_ps(COS_POLYNOMIAL[0]);
+			for(size_t p = 1; p < SIN_POLYNOMIAL.size(); p+=1){
+				sin_a = _mm512_fmadd_ps(sin_a, a2, _mm512_set1_ps(SIN_POLYNOMIAL[p]));
+				cos_a = _mm512_fmadd_ps(cos_a, a2, _mm512_set1_ps(COS_POLYNOMIAL[p]));
+			}
+			sin_a = _mm512_fmadd_ps(_mm512_mul_ps(sin_a, a2), a, a);
+			cos_a = _mm512_fmadd_ps(_mm512_mul_ps(cos_a, a2), a2, _mm512_fnmadd_ps(a2, _mm512_set1_ps(0.5f), _mm512_set1_ps(1.0f)));
+
+			// rotate by the quarter turns
+			const __m512i quarter_int = _mm512_cvtps_epi32(quarter);
+			const __mmask16 swap = _mm512_test_epi32_mask(quarter_int, _mm512_set1_epi32(1));
+			const __m512i cos_sign = _mm512_slli_epi32(
+				_mm512_and_si512(_mm512_add_epi32(quarter_int, _mm512_set1_epi32(1)), _mm512_set1_epi32(2)), 30
+			);
+			const __m512i sin_sign = _mm512_slli_epi32(_mm512_and_si512(quarter_int, _mm512_set1_epi32(2)), 30);
+			const __m512 cos_angle = _mm512_castsi512_ps(
+				_mm512_xor_si512(_mm512_castps_si512(_mm512_mask_blend_ps(swap, cos_a, sin_a)), cos_sign)
+			);
+			const __m512 sin_angle = _mm512_castsi512_ps(
+				_mm512_xor_si512(_mm512_castps_si512(_mm512_mask_blend_ps(swap, sin_a, cos_a)), sin_sign)
+			);
+
+			_mm512_storeu_ps(&values[i], _mm512_mul_ps(radius, cos_angle));
+			_mm512_storeu_ps(&values[i + PHILOX_CHUNK_SIZE / 2], _mm512_mul_ps(radius, sin_angle));
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// dispatch
+
+	static auto select_chunk_func() -> ChunkFunc {
+		static const ChunkFunc chunk_func = []() -> ChunkFunc {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512f){ return &chunk_avx512; }
+			if(cpu_features.avx2){ return &chunk_avx2; }
+			return &chunk_scalar;
+		}();
+
+		return chunk_func;
+	}
+
+	// transforms a chunk of uniform values into normal values (in place)
+	using TransformFunc = auto(*)(float*) -> void;
+
+	static auto select_box_muller_func() -> TransformFunc {
+		static const TransformFunc box_muller_func = []() -> TransformFunc {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512f){ return &box_muller_avx512; }
+			if(cpu_features.avx2){ return &box_muller_avx2; }
+			return &box_muller_scalar;
+		}();
+
+		return box_muller_func;
+	}
+
+
+	// writes the chunks of `stream` starting at `first_chunk` into `output`, each one passed through `transform`
+	// 	(if it is not null)
+	static auto fill_chunks(
+		std::span<float> output, const RandomStream& stream, size_t first_chunk, TransformFunc transform
+	) -> void {
+		evo::debugAssert(
+			first_chunk + output.size() / PHILOX_CHUNK_SIZE < (size_t(1) << 32) / CHUNK_COUNTERS,
+			"Too many values for one stream"
+		);
+
+		const ChunkFunc chunk_func = select_chunk_func();
+
+		const size_t num_full_chunks = output.size() / PHILOX_CHUNK_SIZE;
+		for(size_t chunk = 0; chunk < num_full_chunks; chunk+=1){
+			chunk_func(&output[chunk * PHILOX_CHUNK_SIZE], stream, uint32_t(first_chunk + chunk));
+			if(transform != nullptr){ transform(&output[chunk * PHILOX_CHUNK_SIZE]); }
+		}
+
+		const size_t remaining = output.size() - num_full_chunks * PHILOX_CHUNK_SIZE;
+		if(remaining > 0){
+			alignas(64) float last_chunk[PHILOX_CHUNK_SIZE];
+			chunk_func(last_chunk, stream, uint32_t(first_chunk + num_full_chunks));
+			if(transform != nullptr){ transform(last_chunk); }
+			std::memcpy(&output[num_full_chunks * PHILOX_CHUNK_SIZE], last_chunk, remaining * sizeof(float));
+		}
+	}
+
+
+	auto fillUniform01(std::span<float> output, const RandomStream& stream) -> void {
+		fill_chunks(output, stream, 0, nullptr);
+	}
+
+	auto fillUniform01(std::span<float> output, const RandomStream& stream, size_t first_chunk) -> void {
+		fill_chunks(output, stream, first_chunk, nullptr);
+	}
+
+
+	auto fillNormal(std::span<float> output, const RandomStream& stream) -> void {
+		fill_chunks(output, stream, 0, select_box_muller_func());
+	}
+
+	auto fillNormal(std::span<float> output, const RandomStream& stream, size_t first_chunk) -> void {
+		fill_chunks(output, stream, first_chunk, select_box_muller_func());
+	}
+
+
+}
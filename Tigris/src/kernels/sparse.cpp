@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/sparse.h>
+
+#include <kernels/cpu.h>
+
+#include <immintrin.h>
+
+
+namespace tigris::kernels{
+
+	// y[j] = row j of the sparse matrix . x (without the activation)
+	using SpMVFunc = auto(*)(const float*, const uint32_t*, const uint32_t*, const float*, float*, size_t) -> void;
+
+	// rows with fewer nonzeros than this are done without SIMD
+	static constexpr uint32_t SHORT_ROW = 8;
+
+
+	//////////////////////////////////////////////////////////////////////
+	// scalar
+
+	// inlined into the SIMD kernels so it is not run as legacy SSE code with the upper halves of the vector registers
+	// 	still dirty (which is very slow on some CPUs)
+	TIGRIS_FORCE_INLINE static auto scalar_row(
+		const float* x, const uint32_t* column_indices, const float* values, uint32_t row_start, uint32_t row_end
+	) -> float {
+		// 2 independent sums to break the dependency chain
+		float sums[2] = {0.0f, 0.0f};
+
+		uint32_t i = row_start;
+		for(; i + 2 <= row_end; i+=2){
+			sums[0] += values[i + 0] * x[column_indices[i + 0]];
+			sums[1] += values[i + 1] * x[column_indices[i + 1]];
+		}
+		if(i < row_end){
+			sums[0] += values[i] * x[column_indices[i]];
+		}
+
+		return sums[0] + sums[1];
+	}
+
+	static auto spmv_scalar(
+		const float* x,
+		const uint32_t* row_offsets, const uint32_t* column_indices, const float* values,
+		float* y,
+		size_t n
+	) -> void {
+		for(size_t j = 0; j < n; j+=1){
+			y[j] = scalar_row(x, column_indices, values, row_offsets[j], row_offsets[j + 1]);
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX2
+
+	TIGRIS_TARGET_AVX2
+	static auto spmv_avx2(
+		const float* x,
+		const uint32_t* row_offsets, const uint32_t* column_indices, const float* values,
+		float* y,
+		size_t n
+	) -> void {
+		const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+		for(size_t j = 0; j < n; j+=1){
+			const uint32_t row_end = row_offsets[j + 1];
+			uint32_t i = row_offsets[j];
+
+			if(row_end - i < SHORT_ROW){
+				y[j] = scalar_row(x, column_indices, values, i, row_end);
+				continue;
+			}
+
+			__m256 acc = _mm256_setzero_ps();
+			for(; i + 8 <= row_end; i+=8){
+				const __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&column_indices[i]));
+				acc = _mm256_fmadd_ps(_mm256_loadu_ps(&values[i]), _mm256_i32gather_ps(x, indices, 4), acc);
+			}
+			if(i < row_end){
+				const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(int(row_end - i)), lanes);
+				const __m256i indices = _mm256_maskload_epi32(reinterpret_cast<const int*>(&column_indices[i]), mask);
+				const __m256 gathered = _mm256_mask_i32gather_ps(
+					_mm256_setzero_ps(), x, indices, _mm256_castsi256_ps(mask), 4
+				);
+				acc = _mm256_fmadd_ps(_mm256_maskload_ps(&values[i], mask), gathered, acc);
+			}
+
+			__m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+			sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+			sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+			y[j] = _mm_cvtss_f32(sum);
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX-512
+
+	TIGRIS_TARGET_AVX512
+	static auto spmv_avx512(
+		const float* x,
+		const uint32_t* row_offsets, const uint32_t* column_indices, const float* values,
+		float* y,
+		size_t n
+	) -> void {
+		for(size_t j = 0; j < n; j+=1){
+			const uint32_t row_start = row_offsets[j];
+			const uint32_t row_end = row_offsets[j + 1];
+
+			// short rows (most rows of small layers once they are pruned) are not worth a gather and a reduction
+			if(row_end - row_start < SHORT_ROW){
+				y[j] = scalar_row(x, column_indices, values, row_start, row_end);
+				continue;
+			}
+
+			__m512 acc = _mm512_setzero_ps();
+			for(uint32_t i = row_start; i < row_end; i+=16){
+				const __mmask16 mask = row_end - i >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << (row_end - i)) - 1);
+
+				const __m512i indices = _mm512_maskz_loadu_epi32(mask, &column_indices[i]);
+				const __m512 gathered = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, indices, x, 4);
+				acc = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, &values[i]), gathered, acc);
+			}
+
+			y[j] = _mm512_reduce_add_ps(acc);
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// dispatch
+
+	struct SpMVImplementation{
+		SpMVFunc spmv;
+		std::string_view name;
+	};
+
+	static auto select_implementation() -> const SpMVImplementation& {
+		static const SpMVImplementation implementation = []() -> SpMVImplementation {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512f){ return SpMVImplementation(&spmv_avx512, "avx512"); }
+			if(cpu_features.avx2){ return SpMVImplementation(&spmv_avx2, "avx2"); }
+			return SpMVImplementation(&spmv_scalar, "scalar");
+		}();
+
+		return implementation;
+	}
+
+
+	auto spmv(
+		const float* x,
+		const uint32_t* row_offsets, const uint32_t* column_indices, const float* values,
+		float* y,
+		size_t n,
+		Activation activation
+	) -> void {
+		select_implementation().spmv(x, row_offsets, column_indices, values, y, n);
+		activate(activation, y, y, n);
+	}
+
+
+	auto spmvImplementationName() -> std::string_view {
+		return select_implementation().name;
+	}
+
+
+}
@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <kernels/stacked.h>
+
+#include <kernels/cpu.h>
+
+#include <immintrin.h>
+
+
+namespace tigris::kernels{
+
+	// `SHARED`: `x` has one value per input (broadcast to every lane) instead of one vector per input.
+	// 	`x_stride` is the distance (in floats) between two inputs of the batch in both cases.
+	using StackedFunc = auto(*)(const float*, size_t, const float*, float*, size_t, size_t, size_t) -> void;
+
+
+	//////////////////////////////////////////////////////////////////////
+	// scalar
+
+	template<bool SHARED>
+	static auto stacked_scalar(
+		const float* x, size_t x_stride, const float* w, float* y, size_t num_inputs, size_t n, size_t k
+	) -> void {
+		for(size_t b = 0; b < num_inputs; b+=1){
+			for(size_t j = 0; j < n; j+=1){
+				auto acc = std::array<float, STACK_LANES>{};
+
+				for(size_t p = 0; p < k; p+=1){
+					const float* w_lanes = &w[(j * k + p) * STACK_LANES];
+
+					for(size_t lane = 0; lane < STACK_LANES; lane+=1){
+						const float x_value = SHARED ? x[b * x_stride + p] : x[b * x_stride + p * STACK_LANES + lane];
+						acc[lane] += x_value * w_lanes[lane];
+					}
+				}
+
+				std::ranges::copy(acc, &y[(b * n + j) * STACK_LANES]);
+			}
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX2
+
+	// ROWS inputs x OUTPUTS outputs, each lane vector split into 2 halves
+	template<size_t ROWS, size_t OUTPUTS, bool SHARED>
+	TIGRIS_TARGET_AVX2
+	static auto avx2_tile(const float* x, size_t x_stride, const float* w, float* y, size_t n, size_t k) -> void {
+		__m256 acc[ROWS][OUTPUTS][2];
+		for(size_t r = 0; r < ROWS; r+=1){
+			for(size_t o = 0; o < OUTPUTS; o+=1){
+				acc[r][o][0] = _mm256_setzero_ps();
+				acc[r][o][1] = _mm256_setzero_ps();
+			}
+		}
+
+		for(size_t p = 0; p < k; p+=1){
+			__m256 weights[OUTPUTS][2];
+			for(size_t o = 0; o < OUTPUTS; o+=1){
+				weights[o][0] = _mm256_loadu_ps(&w[(o * k + p) * STACK_LANES]);
+				weights[o][1] = _mm256_loadu_ps(&w[(o * k + p) * STACK_LANES + 8]);
+			}
+
+			for(size_t r = 0; r < ROWS; r+=1){
+				__m256 x_values[2];
+				if constexpr(SHARED){
+					x_values[0] = _mm256_set1_ps(x[r * x_stride + p]);
+					x_values[1] = x_values[0];
+				}else{
+					x_values[0] = _mm256_loadu_ps(&x[r * x_stride + p * STACK_LANES]);
+					x_values[1] = _mm256_loadu_ps(&x[r * x_stride + p * STACK_LANES + 8]);
+				}
+
+				for(size_t o = 0; o < OUTPUTS; o+=1){
+					acc[r][o][0] = _mm256_fmadd_ps(x_values[0], weights[o][0], acc[r][o][0]);
+					acc[r][o][1] = _mm256_fmadd_ps(x_values[1], weights[o][1], acc[r][o][1]);
+				}
+			}
+		}
+
+		for(size_t r = 0; r < ROWS; r+=1){
+			for(size_t o = 0; o < OUTPUTS; o+=1){
+				_mm256_storeu_ps(&y[(r * n + o) * STACK_LANES], acc[r][o][0]);
+				_mm256_storeu_ps(&y[(r * n + o) * STACK_LANES + 8], acc[r][o][1]);
+			}
+		}
+	}
+
+	// 2 x 2 tiles (8 accumulators)
+	template<bool SHARED>
+	TIGRIS_TARGET_AVX2
+	static auto stacked_avx2(
+		const float* x, size_t x_stride, const float* w, float* y, size_t num_inputs, size_t n, size_t k
+	) -> void {
+		for(size_t b = 0; b < num_inputs; b+=2){
+			const float* x_tile = &x[b * x_stride];
+
+			for(size_t j = 0; j < n; j+=2){
+				const float* w_tile = &w[j * k * STACK_LANES];
+				float* y_tile = &y[(b * n + j) * STACK_LANES];
+
+				const bool full_rows = num_inputs - b >= 2;
+				const bool full_outputs = n - j >= 2;
+
+				if(full_rows && full_outputs){
+					avx2_tile<2, 2, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+				}else if(full_rows){
+					avx2_tile<2, 1, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+				}else if(full_outputs){
+					avx2_tile<1, 2, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+				}else{
+					avx2_tile<1, 1, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+				}
+			}
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX-512
+
+	// ROWS inputs x OUTPUTS outputs
+	template<size_t ROWS, size_t OUTPUTS, bool SHARED>
+	TIGRIS_TARGET_AVX512
+	static auto avx512_tile(const float* x, size_t x_stride, const float* w, float* y, size_t n, size_t k) -> void {
+		__m512 acc[ROWS][OUTPUTS];
+		for(size_t r = 0; r < ROWS; r+=1){
+			for(size_t o = 0; o < OUTPUTS; o+=1){
+				acc[r][o] = _mm512_setzero_ps();
+			}
+		}
+
+		for(size_t p = 0; p < k; p+=1){
+			__m512 weights[OUTPUTS];
+			for(size_t o = 0; o < OUTPUTS; o+=1){
+				weights[o] = _mm512_loadu_ps(&w[(o * k + p) * STACK_LANES]);
+			}
+
+			for(size_t r = 0; r < ROWS; r+=1){
+				const __m512 x_value = SHARED
+					? _mm512_set1_ps(x[r * x_stride + p])
+					: _mm512_loadu_ps(&x[r * x_stride + p * STACK_LANES]);
+
+				for(size_t o = 0; o < OUTPUTS; o+=1){
+					acc[r][o] = _mm512_fmadd_ps(x_value, weights[o], acc[r][o]);
+				}
+			}
+		}
+
+		for(size_t r = 0; r < ROWS; r+=1){
+			for(size_t o = 0; o < OUTPUTS; o+=1){
+				_mm512_storeu_ps(&y[(r * n + o) * STACK_LANES], acc[r][o]);
+			}
+		}
+	}
+
+	// 4 x 2 tiles (8 accumulators, enough independent FMAs to hide their latency)
+	template<bool SHARED>
+	TIGRIS_TARGET_AVX512
+	static auto stacked_avx512(
+		const float* x, size_t x_stride, const float* w, float* y, size_t num_inputs, size_t n, size_t k
+	) -> void {
+		for(size_t b = 0; b < num_inputs; b+=4){
+			const size_t rows = std::min<size_t>(4, num_inputs - b);
+			const float* x_tile = &x[b * x_stride];
+
+			for(size_t j = 0; j < n; j+=2){
+				const float* w_tile = &w[j * k * STACK_LANES];
+				float* y_tile = &y[(b * n + j) * STACK_LANES];
+
+				if(n - j >= 2){
+					switch(rows){
+						break; case 1: avx512_tile<1, 2, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+						break; case 2: avx512_tile<2, 2, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+						break; case 3: avx512_tile<3, 2, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+						break; case 4: avx512_tile<4, 2, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+					}
+				}else{
+					switch(rows){
+						break; case 1: avx512_tile<1, 1, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+						break; case 2: avx512_tile<2, 1, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+						break; case 3: avx512_tile<3, 1, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+						break; case 4: avx512_tile<4, 1, SHARED>(x_tile, x_stride, w_tile, y_tile, n, k);
+					}
+				}
+			}
+		}
+	}
+
+
+
+	//////////////////////////////////////////////////////////////////////
+	// dispatch
+
+	struct StackedImplementation{
+		StackedFunc shared;
+		StackedFunc lanes;
+		std::string_view name;
+	};
+
+	static auto select_implementation() -> const StackedImplementation& {
+		static const StackedImplementation implementation = []() -> StackedImplementation {
+			const CPUFeatures& cpu_features = getCPUFeatures();
+
+			if(cpu_features.avx512f){
+				return StackedImplementation(&stacked_avx512<true>, &stacked_avx512<false>, "avx512");
+			}
+			if(cpu_features.avx2){
+				return StackedImplementation(&stacked_avx2<true>, &stacked_avx2<false>, "avx2");
+			}
+			return StackedImplementation(&stacked_scalar<true>, &stacked_scalar<false>, "scalar");
+		}();
+
+		return implementation;
+	}
+
+
+	auto stackedGemvShared(
+		const float* x, size_t x_stride,
+		const float* w,
+		float* y,
+		size_t num_inputs, size_t n, size_t k,
+		Activation activation
+	) -> void {
+		select_implementation().shared(x, x_stride, w, y, num_inputs, n, k);
+		activate(activation, y, y, num_inputs * n * STACK_LANES);
+	}
+
+	auto stackedGemv(
+		const float* x,
+		const float* w,
+		float* y,
+		size_t num_inputs, size_t n, size_t k,
+		Activation activation
+	) -> void {
+		select_implementation().lanes(x, k * STACK_LANES, w, y, num_inputs, n, k);
+		activate(activation, y, y, num_inputs * n * STACK_LANES);
+	}
+
+
+	auto stackedImplementationName() -> std::string_view {
+		return select_implementation().name;
+	}
+
+
+}
@@ -70,7 +70,10 @@ auto connect_4_test() -> void {
 
 
 
-using TicTacToePlayer = std::function<tigris::tic_tac_toe::Board(evo::ArrayProxy<tigris::tic_tac_toe::Board>)>;
+// gets the current board and every board after a possible move, and returns the board after its move
+using TicTacToePlayer = std::function<
+	tigris::tic_tac_toe::Board(const tigris::tic_tac_toe::Board&, evo::ArrayProxy<tigris::tic_tac_toe::Board>)
+>;
 
 
 
@@ -89,10 +92,10 @@ auto play_tic_tac_toe(TicTacToePlayer x_player, TicTacToePlayer o_player) -> tig
 
 
 		if(is_x_turn){
-			board = x_player(possible_moves);
+			board = x_player(board, possible_moves);
 
 		}else{
-			board = o_player(possible_moves);
+			board = o_player(board, possible_moves);
 		}
 
 		is_x_turn = !is_x_turn;
@@ -103,30 +106,117 @@ auto play_tic_tac_toe(TicTacToePlayer x_player, TicTacToePlayer o_player) -> tig
 
 
 
-auto ai_play_tic_tac_toe(const tigris::AI& x_player, const tigris::AI& o_player)
+// Scores every possible move with a single forward pass (`calculateBatch`), one row of the result per move.
+// 	Works with both `tigris::AI` and `tigris::StaticAI`
+template<class AIType>
+auto score_tic_tac_toe_moves(const AIType& ai, evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves)
+-> tigris::ConstMatrixView {
+	static constexpr size_t AI_DATA_SIZE = tigris::tic_tac_toe::Board::AI_DATA_SIZE;
+
+	// there are never more than 9 possible moves, so the boards are encoded on the stack
+	auto ai_data = std::array<float, AI_DATA_SIZE * 9>();
+	for(size_t i = 0; i < possible_moves.size(); i+=1){
+		possible_moves[i].getAIData(std::span<float>(&ai_data[i * AI_DATA_SIZE], AI_DATA_SIZE));
+	}
+
+	return ai.calculateBatch(tigris::ConstMatrixView(ai_data.data(), AI_DATA_SIZE, possible_moves.size()));
+}
+
+
+
+// works with both `tigris::AI` and `tigris::StaticAI`
+template<class AIType>
+auto ai_play_tic_tac_toe(const AIType& x_player, const AIType& o_player)
 -> tigris::tic_tac_toe::Board::GameStatus {
 	return play_tic_tac_toe(
-		[&](evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves){
-			auto results = std::vector<float>(possible_moves.size());
+		[&](const tigris::tic_tac_toe::Board&, evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves){
+			const tigris::ConstMatrixView results = score_tic_tac_toe_moves(x_player, possible_moves);
+
+			size_t best_move = 0;
+			for(size_t i = 1; i < possible_moves.size(); i+=1){
+				if(results[0, i] > results[0, best_move]){ best_move = i; }
+			}
+
+			return possible_moves[best_move];
+		},
+		[&](const tigris::tic_tac_toe::Board&, evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves){
+			const tigris::ConstMatrixView results = score_tic_tac_toe_moves(o_player, possible_moves);
+
+			size_t best_move = 0;
+			for(size_t i = 1; i < possible_moves.size(); i+=1){
+				if(results[0, i] < results[0, best_move]){ best_move = i; }
+			}
+
+			return possible_moves[best_move];
+		}
+	);
+}
+
+
+
+
+
+// Same as `ai_play_tic_tac_toe()` with the evaluations of each player memoized in its cache (see
+// 	`tigris::EvaluationCache`). Only the moves that are not in the cache are calculated, in one batch
+template<class AIType>
+auto ai_play_tic_tac_toe(
+	const AIType& x_player, tigris::EvaluationCache& x_cache, const AIType& o_player, tigris::EvaluationCache& o_cache
+) -> tigris::tic_tac_toe::Board::GameStatus {
+	static constexpr size_t AI_DATA_SIZE = tigris::tic_tac_toe::Board::AI_DATA_SIZE;
+
+	const auto score_moves = [](
+		const AIType& ai, tigris::EvaluationCache& cache, evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves
+	) -> std::array<float, 9> {
+		auto scores = std::array<float, 9>();
+
+		auto ai_data = std::array<float, AI_DATA_SIZE * 9>();
+		auto missed_moves = std::array<size_t, 9>();
+		size_t num_missed = 0;
+
+		for(size_t i = 0; i < possible_moves.size(); i+=1){
+			const std::optional<float> cached = cache.find(possible_moves[i].getKey());
+			if(cached.has_value()){
+				scores[i] = *cached;
+			}else{
+				possible_moves[i].getAIData(std::span<float>(&ai_data[num_missed * AI_DATA_SIZE], AI_DATA_SIZE));
+				missed_moves[num_missed] = i;
+				num_missed += 1;
+			}
+		}
+
+		if(num_missed > 0){
+			const tigris::ConstMatrixView results = ai.calculateBatch(
+				tigris::ConstMatrixView(ai_data.data(), AI_DATA_SIZE, num_missed)
+			);
+			for(size_t i = 0; i < num_missed; i+=1){
+				scores[missed_moves[i]] = results[0, i];
+				cache.insert(possible_moves[missed_moves[i]].getKey(), results[0, i]);
+			}
+		}
+
+		return scores;
+	};
+
+	return play_tic_tac_toe(
+		[&](const tigris::tic_tac_toe::Board&, evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves){
+			const std::array<float, 9> scores = score_moves(x_player, x_cache, possible_moves);
 
-			for(size_t i = 0; i < possible_moves.size(); i+=1){
-				tigris::Matrix result = x_player.calculate(possible_moves[i].getAIData());
-				evo::debugAssert(result.width() == 1 && result.height() == 1);
-				results[i] = result[0, 0];
+			size_t best_move = 0;
+			for(size_t i = 1; i < possible_moves.size(); i+=1){
+				if(scores[i] > scores[best_move]){ best_move = i; }
 			}
 
-			return possible_moves[std::distance(results.begin(), std::max_element(results.begin(), results.end()))];
+			return possible_moves[best_move];
 		},
-		[&](evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves){
-			auto results = std::vector<float>(possible_moves.size());
+		[&](const tigris::tic_tac_toe::Board&, evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves){
+			const std::array<float, 9> scores = score_moves(o_player, o_cache, possible_moves);
 
-			for(size_t i = 0; i < possible_moves.size(); i+=1){
-				tigris::Matrix result = o_player.calculate(possible_moves[i].getAIData());
-				evo::debugAssert(result.width() == 1 && result.height() == 1);
-				results[i] = result[0, 0];
+			size_t best_move = 0;
+			for(size_t i = 1; i < possible_moves.size(); i+=1){
+				if(scores[i] < scores[best_move]){ best_move = i; }
 			}
 
-			return possible_moves[std::distance(results.begin(), std::min_element(results.begin(), results.end()))];
+			return possible_moves[best_move];
 		}
 	);
 }
@@ -138,13 +228,24 @@ auto ai_play_tic_tac_toe(const tigris::AI& x_player, const tigris::AI& o_player)
 auto run_tic_tac_toe_training() -> void {
 	static constexpr size_t POPULATION = 200;
 	static constexpr size_t NUM_ITERS_PER_EPOCH = 10;
-	static constexpr float MUTATION_RATE = 0.01f;
+	static constexpr float MUTATION_RATE = 0.02f;
+	static constexpr float MUTATION_SIGMA = 0.2f;
 	static constexpr float NUM_NEW_RANDOM = 0;
 	static constexpr size_t NUM_RUNS_AGAINST_RANDOM = 50;
 
+	// every position of tic-tac-toe fits (there are 5,478 reachable ones)
+	static constexpr bool USE_EVALUATION_CACHE = true;
+	static constexpr size_t EVALUATION_CACHE_SIZE = 8192;
 
-	auto environment = tigris::Environment(POPULATION, {9, 64, 1});
+
+	using TicTacToeAI = tigris::StaticAI<9, 64, 1>;
+
+	auto environment = tigris::Environment(
+		POPULATION, {9, 64, 1}, tigris::kernels::WeightPrecision::FP32, tigris::kernels::Activation::FAST_TANH
+	);
 	environment.initRandom();
+	environment.mutationSigma = MUTATION_SIGMA;
+	if(USE_EVALUATION_CACHE){ environment.enableEvaluationCache(EVALUATION_CACHE_SIZE); }
 
 	size_t last_num_losses = 0;
 	size_t num_epochs = 0;
@@ -158,12 +259,28 @@ auto run_tic_tac_toe_training() -> void {
 		for(size_t i = 0; i < NUM_ITERS_PER_EPOCH; i+=1){
 			environment.beginGame();
 
+			// the games only do inference, so they run on the compile-time sized copies
+			auto static_population = std::vector<TicTacToeAI>();
+			static_population.reserve(environment.population.size());
+			for(size_t genome_i = 0; genome_i < environment.population.size(); genome_i+=1){
+				static_population.emplace_back(environment.population[genome_i]);
+			}
+
+			const auto play_game = [&](size_t x_player_i, size_t o_player_i) -> tigris::tic_tac_toe::Board::GameStatus {
+				if(USE_EVALUATION_CACHE){
+					return ai_play_tic_tac_toe(
+						static_population[x_player_i], environment.evaluationCaches[x_player_i],
+						static_population[o_player_i], environment.evaluationCaches[o_player_i]
+					);
+				}else{
+					return ai_play_tic_tac_toe(static_population[x_player_i], static_population[o_player_i]);
+				}
+			};
+
 			for(size_t x_player_i = 0; x_player_i < environment.population.size() - 1; x_player_i+=1){
 				for(size_t o_player_i = x_player_i + 1; o_player_i < environment.population.size(); o_player_i+=1){
 					{
-						const tigris::tic_tac_toe::Board::GameStatus game_result = ai_play_tic_tac_toe(
-							environment.population[x_player_i], environment.population[o_player_i]
-						);
+						const tigris::tic_tac_toe::Board::GameStatus game_result = play_game(x_player_i, o_player_i);
 
 						switch(game_result){
 							case tigris::tic_tac_toe::Board::GameStatus::IN_PROGRESS: {
@@ -186,9 +303,7 @@ auto run_tic_tac_toe_training() -> void {
 					}
 					
 					{
-						const tigris::tic_tac_toe::Board::GameStatus game_result = ai_play_tic_tac_toe(
-							environment.population[o_player_i], environment.population[x_player_i]
-						);
+						const tigris::tic_tac_toe::Board::GameStatus game_result = play_game(o_player_i, x_player_i);
 
 						switch(game_result){
 							case tigris::tic_tac_toe::Board::GameStatus::IN_PROGRESS: {
@@ -225,9 +340,25 @@ auto run_tic_tac_toe_training() -> void {
 
 		using TicTacToeStatus = tigris::tic_tac_toe::Board::GameStatus;
 
-		const tigris::AI& best_ai = environment.population[
-			std::distance(environment.scores.begin(), std::ranges::max_element(environment.scores))
-		];
+		const auto best_ai = TicTacToeAI(
+			environment.population[
+				std::distance(environment.scores.begin(), std::ranges::max_element(environment.scores))
+			]
+		);
+
+		// the best AI plays from its move table (the same moves as `ai_play_tic_tac_toe`, one load per move)
+		const auto best_moves = tigris::tic_tac_toe::MoveTable::fromAI(best_ai);
+
+		const auto random_player = [](
+			const tigris::tic_tac_toe::Board&, evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves
+		) -> tigris::tic_tac_toe::Board {
+			// return possible_moves[evo::random(possible_moves.size()-1)];
+			if(possible_moves.size() == 1){
+				return possible_moves[0];
+			}else{
+				return possible_moves[std::rand() % (possible_moves.size() - 1)];
+			}
+		};
 
 
 		std::srand(12);
@@ -238,27 +369,10 @@ auto run_tic_tac_toe_training() -> void {
 		for(size_t i = 0; i < NUM_RUNS_AGAINST_RANDOM; i+=1){
 			{
 				const TicTacToeStatus game_result = play_tic_tac_toe(
-					[&](evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves){
-						auto results = std::vector<float>(possible_moves.size());
-
-						for(size_t i = 0; i < possible_moves.size(); i+=1){
-							tigris::Matrix result = best_ai.calculate(possible_moves[i].getAIData());
-							evo::debugAssert(result.width() == 1 && result.height() == 1);
-							results[i] = result[0, 0];
-						}
-
-						return possible_moves[
-							std::distance(results.begin(), std::max_element(results.begin(), results.end()))
-						];
+					[&](const tigris::tic_tac_toe::Board& board, evo::ArrayProxy<tigris::tic_tac_toe::Board>){
+						return best_moves.play(board, tigris::tic_tac_toe::Board::Space::X);
 					},
-					[&](evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves) -> tigris::tic_tac_toe::Board {
-						// return possible_moves[evo::random(possible_moves.size()-1)];
-						if(possible_moves.size() == 1){
-							return possible_moves[0];
-						}else{
-							return possible_moves[std::rand() % (possible_moves.size() - 1)];
-						}
-					}
+					random_player
 				);
 
 				switch(game_result){
@@ -271,26 +385,9 @@ auto run_tic_tac_toe_training() -> void {
 			
 			{
 				const TicTacToeStatus game_result = play_tic_tac_toe(
-					[&](evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves) -> tigris::tic_tac_toe::Board {
-						// return possible_moves[evo::random(possible_moves.size()-1)];
-						if(possible_moves.size() == 1){
-							return possible_moves[0];
-						}else{
-							return possible_moves[std::rand() % (possible_moves.size() - 1)];
-						}
-					},
-					[&](evo::ArrayProxy<tigris::tic_tac_toe::Board> possible_moves){
-						auto results = std::vector<float>(possible_moves.size());
-
-						for(size_t i = 0; i < possible_moves.size(); i+=1){
-							tigris::Matrix result = best_ai.calculate(possible_moves[i].getAIData());
-							evo::debugAssert(result.width() == 1 && result.height() == 1);
-							results[i] = result[0, 0];
-						}
-
-						return possible_moves[
-							std::distance(results.begin(), std::min_element(results.begin(), results.end()))
-						];
+					random_player,
+					[&](const tigris::tic_tac_toe::Board& board, evo::ArrayProxy<tigris::tic_tac_toe::Board>){
+						return best_moves.play(board, tigris::tic_tac_toe::Board::Space::O);
 					}
 				);
 
@@ -309,6 +406,9 @@ auto run_tic_tac_toe_training() -> void {
 
 		evo::printGray("epoch {:<5} ", num_epochs);
 		evo::printWhite("{:2}/{:2}/{:2} ", num_wins, num_draws, num_losses);
+		if(USE_EVALUATION_CACHE){
+			evo::printGray("(cache hits: {:5.1f}%) ", environment.takeEvaluationCacheStats().hitRate() * 100.0f);
+		}
 
 		if(last_num_losses == 0){
 			evo::println();
@@ -357,6 +457,21 @@ auto main(int argc, const char* argv[]) -> int {
 		}
 	#endif
 
+	// nothing else is using the thread pool yet
+	tigris::kernels::calibrateParallelGEMM();
+
+
+	// `tigris benchmark <name>...` runs benchmarks (see `tigris::benchmarks::run()`)
+	if(args.size() >= 2 && args[1] == "benchmark"){
+		for(size_t i = 2; i < args.size(); i+=1){
+			if(tigris::benchmarks::run(args[i]) == false){
+				evo::log::error("Unknown benchmark \"{}\"", args[i]);
+				return 1;
+			}
+		}
+		return 0;
+	}
+
 
 	// /run_tic_tac_toe_training();
 
@@ -74,15 +74,70 @@ namespace tigris::tic_tac_toe{
 
 
 	auto Board::getAIData() const -> std::vector<float> {
-		auto output = std::vector<float>();
+		auto output = std::vector<float>(AI_DATA_SIZE);
+		this->getAIData(output);
+		return output;
+	}
+
+	auto Board::getAIData(std::span<float> output) const -> void {
+		this->getAIData(output, Space::X);
+	}
+
+	auto Board::getAIData(std::span<float> output, Space player) const -> void {
+		evo::debugAssert(output.size() == AI_DATA_SIZE, "Invalid output size");
+		evo::debugAssert(player != Space::EMPTY, "Not a player");
 
+		size_t i = 0;
 		for(const std::array<Space, 3>& row : this->spaces){
 			for(Space space : row){
-				switch(space){
-					break; case Space::EMPTY: output.emplace_back(0.0f);
-					break; case Space::X:     output.emplace_back(1.0f);
-					break; case Space::O:     output.emplace_back(-1.0f);
+				if(space == Space::EMPTY){
+					output[i] = 0.0f;
+				}else{
+					output[i] = space == player ? 1.0f : -1.0f;
 				}
+				i += 1;
+			}
+		}
+	}
+
+
+	auto Board::getBitplanes(Space player) const -> Bitplanes {
+		evo::debugAssert(player != Space::EMPTY, "Not a player");
+
+		auto output = Bitplanes();
+
+		size_t i = 0;
+		for(const std::array<Space, 3>& row : this->spaces){
+			for(Space space : row){
+				if(space != Space::EMPTY){
+					const size_t bit = space == player ? i : 9 + i;
+					output[bit / 64] |= uint64_t(1) << (bit % 64);
+				}
+				i += 1;
+			}
+		}
+
+		return output;
+	}
+
+	auto Board::getBitplaneAIData(std::span<float> output, Space player) const -> void {
+		evo::debugAssert(output.size() == BITPLANE_SIZE, "Invalid output size");
+
+		const Bitplanes bitplanes = this->getBitplanes(player);
+		for(size_t i = 0; i < BITPLANE_SIZE; i+=1){
+			output[i] = float((bitplanes[i / 64] >> (i % 64)) & 1);
+		}
+	}
+
+
+	auto Board::getLegalMoves() const -> std::array<bool, NUM_MOVES> {
+		auto output = std::array<bool, NUM_MOVES>();
+
+		size_t i = 0;
+		for(const std::array<Space, 3>& row : this->spaces){
+			for(Space space : row){
+				output[i] = space == Space::EMPTY;
+				i += 1;
 			}
 		}
 
@@ -91,6 +146,29 @@ namespace tigris::tic_tac_toe{
 
 
 
+	auto Board::getKey() const -> uint64_t {
+		uint64_t key = 0;
+		for(const std::array<Space, 3>& row : this->spaces){
+			for(Space space : row){
+				key = key * 3 + uint64_t(space);
+			}
+		}
+		return key;
+	}
+
+
+	auto Board::fromKey(uint64_t key) -> Board {
+		evo::debugAssert(key < 19683, "Invalid key");
+
+		auto board = Board();
+		for(size_t i = 9; i > 0; i-=1){
+			board.spaces[(i - 1) / 3][(i - 1) % 3] = Space(key % 3);
+			key /= 3;
+		}
+		return board;
+	}
+
+
 	auto Board::toString() const -> std::string {
 		auto output = std::string();
 
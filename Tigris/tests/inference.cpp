@@ -0,0 +1,481 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "./tests.h"
+
+#include "AI.h"
+#include "CompiledAI.h"
+#include "QuantizedAI.h"
+#include "SparseAI.h"
+#include "StackedAI.h"
+#include "StaticAI.h"
+#include "kernels/gemm.h"
+#include "tic_tac_toe/policy_player.h"
+
+#include <filesystem>
+#include <unistd.h>
+
+
+namespace tigris::tests{
+
+	// The outputs are all in [-1, 1] and the weights are scaled so the layers do not saturate.
+	// 	Only the order of the sums differs between the paths, so they agree much closer than this.
+	static constexpr float TOLERANCE = 1e-5f;
+
+	static constexpr auto ACTIVATIONS = std::to_array<kernels::Activation>({
+		kernels::Activation::TANH,
+		kernels::Activation::SIGMOID,
+		kernels::Activation::FAST_TANH,
+		kernels::Activation::FAST_SIGMOID,
+	});
+
+
+	// weights in [-1, 1) / sqrt(inputs of the layer)
+	static auto random_ai(evo::ArrayProxy<size_t> dimentions, kernels::Activation activation, std::mt19937& rng) -> AI {
+		auto matrices = std::vector<Matrix>();
+		for(size_t i = 0; i < dimentions.size() - 1; i+=1){
+			const float scale = 1.0f / std::sqrt(float(dimentions[i]));
+			matrices.emplace_back(
+				dimentions[i + 1], dimentions[i], randomValues(dimentions[i + 1] * dimentions[i], rng, -scale, scale)
+			);
+		}
+
+		auto layers = std::vector<ConstMatrixView>();
+		for(const Matrix& matrix : matrices){
+			layers.emplace_back(matrix.view());
+		}
+
+		return AI(AIView(layers, activation));
+	}
+
+	// naive forward pass of `ai` (reduced precision weights are widened)
+	static auto reference_calculate(const AI& ai, std::span<const float> inputs) -> std::vector<float> {
+		const AI fp32_ai = ai.withPrecision(kernels::WeightPrecision::FP32);
+
+		auto values = std::vector<float>(inputs.begin(), inputs.end());
+		for(const Matrix& layer : fp32_ai.getMatrices()){
+			auto outputs = std::vector<float>(layer.width());
+			kernels::gemmReference(
+				values.data(), values.size(),
+				layer.data().data(), layer.stride(),
+				outputs.data(), outputs.size(),
+				1, layer.width(), layer.height()
+			);
+
+			for(float& value : outputs){
+				value = kernels::activate(ai.getActivation(), value);
+			}
+			values = std::move(outputs);
+		}
+
+		return values;
+	}
+
+	static auto to_vector(std::span<const float> values) -> std::vector<float> {
+		return std::vector<float>(values.begin(), values.end());
+	}
+
+
+	static auto test_ai(std::mt19937& rng) -> void {
+		const auto all_dimentions = std::to_array<std::vector<size_t>>({
+			{9, 64, 1}, {42, 128, 128, 7}, {84, 512, 3}, {5, 3, 17, 2},
+		});
+
+		for(const std::vector<size_t>& dimentions : all_dimentions){
+			for(kernels::Activation activation : ACTIVATIONS){
+				const AI ai = random_ai(dimentions, activation, rng);
+				const std::vector<float> inputs = randomValues(ai.numInputs(), rng);
+				const std::vector<float> expected = reference_calculate(ai, inputs);
+
+				const float ai_difference = maxDifference(ai.calculate(inputs), expected);
+				check(ai_difference < TOLERANCE, "AI: differs from the naive forward pass by {}", ai_difference);
+
+				const float view_difference = maxDifference(ai.view().calculate(inputs), expected);
+				check(view_difference < TOLERANCE, "AIView: differs from the naive forward pass by {}", view_difference);
+
+				for(kernels::WeightPrecision precision : {kernels::WeightPrecision::BF16, kernels::WeightPrecision::FP16}){
+					const AI half_ai = ai.withPrecision(precision);
+					const float half_difference = maxDifference(half_ai.calculate(inputs), reference_calculate(half_ai, inputs));
+					check(
+						half_difference < TOLERANCE,
+						"AI (precision {}): differs from the naive forward pass by {}", size_t(precision), half_difference
+					);
+				}
+			}
+		}
+	}
+
+
+	static auto test_calculate_batch(std::mt19937& rng) -> void {
+		const AI ai = random_ai({42, 128, 128, 7}, kernels::Activation::FAST_TANH, rng);
+
+		const size_t batch_size = 13;
+		const auto inputs = Matrix(ai.numInputs(), batch_size, randomValues(ai.numInputs() * batch_size, rng));
+
+		const ConstMatrixView outputs = ai.calculateBatch(inputs.view());
+		float difference = 0.0f;
+		for(size_t b = 0; b < batch_size; b+=1){
+			difference = std::max(difference, maxDifference(outputs.row(b), ai.calculate(inputs.row(b))));
+		}
+		check(difference < TOLERANCE, "AI::calculateBatch: differs from AI::calculate by {}", difference);
+
+		const ConstMatrixView view_outputs = ai.view().calculateBatch(inputs.view());
+		float view_difference = 0.0f;
+		for(size_t b = 0; b < batch_size; b+=1){
+			view_difference = std::max(view_difference, maxDifference(view_outputs.row(b), ai.calculate(inputs.row(b))));
+		}
+		check(view_difference < TOLERANCE, "AIView::calculateBatch: differs from AI::calculate by {}", view_difference);
+	}
+
+
+	// Random networks prefer occupied spaces all the time, so every move of their games has to be kept legal
+	static auto test_policy_player(std::mt19937& rng) -> void {
+		using Board = tic_tac_toe::Board;
+
+		size_t num_occupied_picks = 0; // picked an occupied space
+		size_t num_masked_picks = 0; // the highest logit was on an occupied space
+		size_t num_mask_errors = 0;
+
+		for(size_t game = 0; game < 100; game+=1){
+			const auto players = std::to_array<AI>({
+				random_ai({Board::AI_DATA_SIZE, 16, Board::NUM_MOVES}, kernels::Activation::FAST_TANH, rng),
+				random_ai({Board::AI_DATA_SIZE, 16, Board::NUM_MOVES}, kernels::Activation::FAST_TANH, rng),
+			});
+
+			auto board = Board();
+			bool is_x_turn = true;
+			while(board.getGameStatus() == Board::GameStatus::IN_PROGRESS){
+				const AI& player = players[is_x_turn ? 0 : 1];
+				const Board::Space space = is_x_turn ? Board::Space::X : Board::Space::O;
+
+				auto ai_data = std::array<float, Board::AI_DATA_SIZE>();
+				board.getAIData(ai_data, space);
+				const std::vector<float> logits = to_vector(player.calculate(ai_data));
+				const std::array<bool, Board::NUM_MOVES> legal_moves = board.getLegalMoves();
+
+				const size_t move = tic_tac_toe::pickPolicyMove(player, board, space);
+				if(legal_moves[move] == false){ num_occupied_picks += 1; }
+
+				if(legal_moves[std::distance(logits.begin(), std::ranges::max_element(logits))] == false){
+					num_masked_picks += 1;
+				}
+
+				std::vector<float> masked_logits = logits;
+				maskIllegalMoves(masked_logits, legal_moves);
+				for(size_t i = 0; i < Board::NUM_MOVES; i+=1){
+					const float expected = legal_moves[i] ? logits[i] : -std::numeric_limits<float>::infinity();
+					if(masked_logits[i] != expected){ num_mask_errors += 1; }
+				}
+				if(std::distance(masked_logits.begin(), std::ranges::max_element(masked_logits)) != ptrdiff_t(move)){
+					num_mask_errors += 1;
+				}
+
+				if(legal_moves[move] == false){ break; }
+				if(is_x_turn){
+					board.placeX(Board::Coordinate(move / 3, move % 3));
+				}else{
+					board.placeO(Board::Coordinate(move / 3, move % 3));
+				}
+				is_x_turn = !is_x_turn;
+			}
+
+			check(
+				tic_tac_toe::playPolicyGame(players[0], players[1]) == board.getGameStatus(),
+				"tic_tac_toe::playPolicyGame: game {} ended differently than the moves of pickPolicyMove", game
+			);
+		}
+
+		check(num_occupied_picks == 0, "tic_tac_toe::pickPolicyMove: picked {} occupied spaces", num_occupied_picks);
+		check(num_masked_picks > 0, "tic_tac_toe::pickPolicyMove: the networks never preferred an occupied space");
+		check(
+			num_mask_errors == 0,
+			"maskIllegalMoves: {} logits were not masked to -infinity exactly on the occupied spaces", num_mask_errors
+		);
+	}
+
+
+	static auto test_accumulator(std::mt19937& rng) -> void {
+		const AI ai = random_ai({42, 128, 128, 7}, kernels::Activation::TANH, rng);
+		const std::vector<float> inputs = randomValues(ai.numInputs(), rng);
+
+		auto accumulator = AI::Accumulator();
+		ai.initAccumulator(inputs, accumulator);
+
+		const std::vector<float> expected = to_vector(ai.calculate(inputs));
+		const float difference = maxDifference(ai.calculate(accumulator), expected);
+		check(difference < TOLERANCE, "AI::calculate(Accumulator): differs from AI::calculate by {}", difference);
+
+		const auto input_indices = std::to_array<size_t>({0, 5, 41, 17});
+		const float delta = 0.75f;
+		const ConstMatrixView batch_outputs = ai.calculateBatch(accumulator, input_indices, delta);
+
+		for(size_t i = 0; i < input_indices.size(); i+=1){
+			std::vector<float> changed_inputs = inputs;
+			changed_inputs[input_indices[i]] += delta;
+			const std::vector<float> changed_expected = to_vector(ai.calculate(changed_inputs));
+
+			const float changed_difference = maxDifference(ai.calculate(accumulator, input_indices[i], delta), changed_expected);
+			check(
+				changed_difference < TOLERANCE,
+				"AI::calculate(Accumulator, index, delta): differs from AI::calculate by {}", changed_difference
+			);
+
+			const float batch_difference = maxDifference(batch_outputs.row(i), changed_expected);
+			check(
+				batch_difference < TOLERANCE,
+				"AI::calculateBatch(Accumulator, indices, delta): differs from AI::calculate by {}", batch_difference
+			);
+		}
+
+		// `calculate(Accumulator, index, delta)` does not change the accumulator, `updateAccumulator` does
+		ai.updateAccumulator(accumulator, 3, -0.5f);
+		std::vector<float> updated_inputs = inputs;
+		updated_inputs[3] -= 0.5f;
+		const float updated_difference = maxDifference(ai.calculate(accumulator), ai.calculate(updated_inputs));
+		check(
+			updated_difference < TOLERANCE, "AI::updateAccumulator: differs from AI::calculate by {}", updated_difference
+		);
+	}
+
+
+	static auto test_bitplanes(std::mt19937& rng) -> void {
+		const AI ai = random_ai({84, 128, 7}, kernels::Activation::TANH, rng);
+
+		const auto input_bits = std::to_array<uint64_t>({rng() | (uint64_t(rng()) << 32), rng() & 0xF'FFFF});
+		auto inputs = std::vector<float>(ai.numInputs());
+		for(size_t i = 0; i < inputs.size(); i+=1){
+			inputs[i] = float((input_bits[i / 64] >> (i % 64)) & 1);
+		}
+		const std::vector<float> expected = to_vector(ai.calculate(inputs));
+
+		const float difference = maxDifference(ai.calculate(input_bits), expected);
+		check(difference < TOLERANCE, "AI::calculate(bitplanes): differs from AI::calculate by {}", difference);
+
+		auto accumulator = AI::Accumulator();
+		ai.initAccumulator(input_bits, accumulator);
+		const float accumulator_difference = maxDifference(ai.calculate(accumulator), expected);
+		check(
+			accumulator_difference < TOLERANCE,
+			"AI::initAccumulator(bitplanes): differs from AI::calculate by {}", accumulator_difference
+		);
+	}
+
+
+	template<size_t... DIMENSIONS>
+	static auto test_static_ai(std::mt19937& rng) -> void {
+		using Static = StaticAI<DIMENSIONS...>;
+
+		const AI ai = random_ai({DIMENSIONS...}, kernels::Activation::FAST_TANH, rng);
+		const auto static_ai = Static(ai);
+
+		auto inputs = std::array<float, Static::NUM_INPUTS>();
+		std::ranges::copy(randomValues(inputs.size(), rng), inputs.begin());
+		const std::vector<float> expected = to_vector(ai.calculate(inputs));
+
+		const float difference = maxDifference(static_ai.calculate(inputs), expected);
+		check(difference < TOLERANCE, "StaticAI: differs from AI::calculate by {}", difference);
+
+		const float view_difference = maxDifference(Static(ai.view()).calculate(inputs), expected);
+		check(view_difference < TOLERANCE, "StaticAI (from an AIView): differs from AI::calculate by {}", view_difference);
+
+		const float half_difference = maxDifference(
+			Static(ai.withPrecision(kernels::WeightPrecision::BF16)).calculate(inputs),
+			ai.withPrecision(kernels::WeightPrecision::BF16).calculate(inputs)
+		);
+		check(half_difference < TOLERANCE, "StaticAI (from a bf16 AI): differs from AI::calculate by {}", half_difference);
+
+		const typename Static::Accumulator accumulator = static_ai.makeAccumulator(inputs);
+		std::array<float, Static::NUM_INPUTS> changed_inputs = inputs;
+		changed_inputs[1] += 1.0f;
+		const float accumulator_difference = maxDifference(
+			static_ai.calculate(accumulator, 1, 1.0f), ai.calculate(changed_inputs)
+		);
+		check(
+			accumulator_difference < TOLERANCE,
+			"StaticAI::calculate(Accumulator, index, delta): differs from AI::calculate by {}", accumulator_difference
+		);
+
+		const size_t batch_size = 5;
+		const auto batch_inputs = Matrix(Static::NUM_INPUTS, batch_size, randomValues(Static::NUM_INPUTS * batch_size, rng));
+		const ConstMatrixView batch_outputs = static_ai.calculateBatch(batch_inputs.view());
+		float batch_difference = 0.0f;
+		for(size_t b = 0; b < batch_size; b+=1){
+			batch_difference = std::max(
+				batch_difference, maxDifference(batch_outputs.row(b), ai.calculate(batch_inputs.row(b)))
+			);
+		}
+		check(batch_difference < TOLERANCE, "StaticAI::calculateBatch: differs from AI::calculate by {}", batch_difference);
+	}
+
+
+	static auto test_sparse_ai(std::mt19937& rng) -> void {
+		const AI ai = random_ai({42, 128, 128, 7}, kernels::Activation::TANH, rng);
+		const std::vector<float> inputs = randomValues(ai.numInputs(), rng);
+
+		const float dense_difference = maxDifference(SparseAI(ai, 0.0f).calculate(inputs), ai.calculate(inputs));
+		check(dense_difference < TOLERANCE, "SparseAI (sparsity 0): differs from AI::calculate by {}", dense_difference);
+
+		// same as a dense AI with the dropped weights set to 0
+		const auto sparse_ai = SparseAI(ai, 0.75f);
+
+		auto pruned_matrices = std::vector<Matrix>();
+		for(const SparseMatrix& layer : sparse_ai.getLayers()){
+			pruned_matrices.emplace_back(layer.toMatrix());
+		}
+		auto pruned_layers = std::vector<ConstMatrixView>();
+		for(const Matrix& matrix : pruned_matrices){
+			pruned_layers.emplace_back(matrix.view());
+		}
+		const auto pruned_ai = AI(AIView(pruned_layers, ai.getActivation()));
+
+		const float sparse_difference = maxDifference(sparse_ai.calculate(inputs), reference_calculate(pruned_ai, inputs));
+		check(
+			sparse_difference < TOLERANCE,
+			"SparseAI (sparsity 0.75): differs from the forward pass of the pruned weights by {}", sparse_difference
+		);
+
+		size_t num_weights = 0;
+		for(const Matrix& matrix : ai.getMatrices()){
+			num_weights += matrix.width() * matrix.height();
+		}
+		check(
+			sparse_ai.numNonZeros() <= num_weights / 4 + ai.getMatrices().size(),
+			"SparseAI (sparsity 0.75): kept {} of {} weights", sparse_ai.numNonZeros(), num_weights
+		);
+	}
+
+
+	static auto test_stacked_ai(std::mt19937& rng) -> void {
+		// not a multiple of `kernels::STACK_LANES`, so the last stack is partly empty
+		const size_t num_genomes = 37;
+
+		auto ais = std::vector<AI>();
+		for(size_t i = 0; i < num_genomes; i+=1){
+			ais.emplace_back(random_ai({42, 64, 7}, kernels::Activation::FAST_TANH, rng));
+		}
+		const auto stacked_ai = StackedAI(ais);
+
+		const size_t num_inputs = 5;
+		const auto inputs = Matrix(42, num_inputs, randomValues(42 * num_inputs, rng));
+		const ConstMatrixView outputs = stacked_ai.calculate(inputs.view());
+
+		float difference = 0.0f;
+		for(size_t genome = 0; genome < num_genomes; genome+=1){
+			for(size_t b = 0; b < num_inputs; b+=1){
+				const std::span<const float> expected = ais[genome].calculate(inputs.row(b));
+				for(size_t o = 0; o < expected.size(); o+=1){
+					difference = std::max(difference, std::abs(outputs[genome, b * expected.size() + o] - expected[o]));
+				}
+			}
+		}
+		check(difference < TOLERANCE, "StackedAI: differs from AI::calculate by {}", difference);
+	}
+
+
+	static auto test_compiled_ai(std::mt19937& rng) -> void {
+		auto options = CodegenOptions();
+		options.cacheDirectory = std::filesystem::temp_directory_path() / std::format("tigris_tests_{}", getpid());
+
+		const auto all_dimentions = std::to_array<std::vector<size_t>>({{9, 64, 1}, {42, 128, 128, 7}, {5, 3, 17, 2}});
+		for(const std::vector<size_t>& dimentions : all_dimentions){
+			const AI ai = random_ai(dimentions, kernels::Activation::FAST_TANH, rng);
+			const auto compiled_ai = CompiledAI(ai, options);
+
+			if(compiled_ai.isCompiled() == false){
+				evo::printlnGray("\tCompiledAI could not compile (falls back to AI), only the fallback is checked");
+			}
+
+			const std::vector<float> inputs = randomValues(ai.numInputs(), rng);
+			const float difference = maxDifference(compiled_ai.calculate(inputs), ai.calculate(inputs));
+			check(difference < TOLERANCE, "CompiledAI: differs from AI::calculate by {}", difference);
+		}
+
+
+		// a cache directory other users can write to (or a symlink to one) is not used
+		const auto shared_directory = std::filesystem::path(std::format("{}_shared", options.cacheDirectory.string()));
+		const auto linked_directory = std::filesystem::path(std::format("{}_link", options.cacheDirectory.string()));
+		std::filesystem::create_directory(shared_directory);
+		std::filesystem::permissions(shared_directory, std::filesystem::perms::all);
+		std::filesystem::create_directory_symlink(options.cacheDirectory, linked_directory);
+
+		const auto unsafe_directories = std::to_array<std::pair<std::filesystem::path, std::vector<size_t>>>({
+			{shared_directory, {3, 5, 2}},
+			{linked_directory, {3, 6, 2}},
+		});
+		for(const auto& [directory, dimentions] : unsafe_directories){
+			auto unsafe_options = options;
+			unsafe_options.cacheDirectory = directory;
+
+			const AI ai = random_ai(dimentions, kernels::Activation::FAST_TANH, rng);
+			const auto compiled_ai = CompiledAI(ai, unsafe_options);
+			check(compiled_ai.isCompiled() == false, "CompiledAI: used the unsafe cache directory `{}`", directory.string());
+
+			const std::vector<float> inputs = randomValues(ai.numInputs(), rng);
+			const float difference = maxDifference(compiled_ai.calculate(inputs), ai.calculate(inputs));
+			check(
+				difference < TOLERANCE, "CompiledAI (unsafe cache directory): differs from AI::calculate by {}", difference
+			);
+		}
+
+		// per user by default
+		const char* cache_home = std::getenv("XDG_CACHE_HOME");
+		const auto old_cache_home = std::string(cache_home != nullptr ? cache_home : "");
+		setenv("XDG_CACHE_HOME", "/tigris_tests_cache", 1);
+		check(
+			defaultCodegenCacheDirectory() == "/tigris_tests_cache/tigris",
+			"defaultCodegenCacheDirectory: `{}` is not in $XDG_CACHE_HOME", defaultCodegenCacheDirectory().string()
+		);
+		if(cache_home != nullptr){
+			setenv("XDG_CACHE_HOME", old_cache_home.c_str(), 1);
+		}else{
+			unsetenv("XDG_CACHE_HOME");
+		}
+
+		std::error_code error_code;
+		std::filesystem::remove_all(options.cacheDirectory, error_code);
+		std::filesystem::remove_all(shared_directory, error_code);
+		std::filesystem::remove(linked_directory, error_code);
+	}
+
+
+	static auto test_quantized_ai(std::mt19937& rng) -> void {
+		// int8 is only close to the fp32 result (the error of each layer is about its scale / 127)
+		static constexpr float QUANTIZED_TOLERANCE = 0.05f;
+
+		const AI ai = random_ai({42, 128, 128, 7}, kernels::Activation::TANH, rng);
+		const auto quantized_ai = QuantizedAI(ai);
+
+		float difference = 0.0f;
+		for(size_t i = 0; i < 20; i+=1){
+			const std::vector<float> inputs = randomValues(ai.numInputs(), rng);
+			difference = std::max(difference, maxDifference(quantized_ai.calculate(inputs), ai.calculate(inputs)));
+		}
+		check(difference < QUANTIZED_TOLERANCE, "QuantizedAI: differs from AI::calculate by {}", difference);
+	}
+
+
+	auto inferenceTests() -> void {
+		auto rng = std::mt19937(5489);
+
+		test_ai(rng);
+		test_calculate_batch(rng);
+		test_policy_player(rng);
+		test_accumulator(rng);
+		test_bitplanes(rng);
+		test_static_ai<9, 64, 1>(rng);
+		test_static_ai<42, 128, 128, 7>(rng);
+		test_sparse_ai(rng);
+		test_stacked_ai(rng);
+		test_compiled_ai(rng);
+		test_quantized_ai(rng);
+	}
+
+
+}
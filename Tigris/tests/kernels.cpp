@@ -0,0 +1,527 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "./tests.h"
+
+#include "kernels/gemm.h"
+#include "kernels/int8.h"
+#include "kernels/philox.h"
+#include "HalfMatrix.h"
+
+#include <cfloat>
+#include <numbers>
+
+
+namespace tigris::tests{
+
+	struct GEMMShape{
+		size_t m;
+		size_t n;
+		size_t k;
+	};
+
+	// edge cases around the SIMD widths and the register tiles, and the layer sizes used by Tigris
+	static constexpr auto GEMM_SHAPES = std::to_array<GEMMShape>({
+		{1, 1, 1}, {1, 7, 3}, {3, 17, 5}, {4, 16, 16}, {5, 1, 200}, {8, 64, 64}, {13, 33, 129}, {17, 48, 9},
+		{64, 100, 42}, {2, 257, 84},
+	});
+
+	static constexpr auto ACTIVATIONS = std::to_array<kernels::Activation>({
+		kernels::Activation::NONE,
+		kernels::Activation::TANH,
+		kernels::Activation::SIGMOID,
+		kernels::Activation::FAST_TANH,
+		kernels::Activation::FAST_SIGMOID,
+	});
+
+
+	template<class Half>
+	static auto to_half(std::span<const float> values) -> std::vector<Half> {
+		auto output = std::vector<Half>(values.size());
+		std::ranges::transform(values, output.begin(), [](float value){ return Half(value); });
+		return output;
+	}
+
+	template<class Half>
+	static auto widened(std::span<const Half> values) -> std::vector<float> {
+		auto output = std::vector<float>(values.size());
+		std::ranges::transform(values, output.begin(), [](Half value){ return float(value); });
+		return output;
+	}
+
+
+	// Checks `c` against `gemmReference` with the tolerance of `kernels/gemm.h` (for both of them, as the reference
+	// 	rounds too), and that the padding of the rows of `c` was not written.
+	static auto check_gemm_result(
+		std::string_view name,
+		const float* a, size_t a_stride,
+		const float* b, size_t b_stride,
+		const float* c, size_t c_stride,
+		const GEMMShape& shape
+	) -> void {
+		auto reference = std::vector<float>(shape.m * shape.n);
+		kernels::gemmReference(a, a_stride, b, b_stride, reference.data(), shape.n, shape.m, shape.n, shape.k);
+
+		size_t num_wrong = 0;
+		size_t num_padding_written = 0;
+		for(size_t y = 0; y < shape.m; y+=1){
+			for(size_t x = 0; x < shape.n; x+=1){
+				float magnitude = 0.0f;
+				for(size_t i = 0; i < shape.k; i+=1){
+					magnitude += std::abs(a[y * a_stride + i]) * std::abs(b[i * b_stride + x]);
+				}
+
+				const float tolerance = 2.0f * float(shape.k) * FLT_EPSILON * magnitude;
+				if(std::abs(c[y * c_stride + x] - reference[y * shape.n + x]) > tolerance){ num_wrong += 1; }
+			}
+
+			for(size_t x = shape.n; x < c_stride; x+=1){
+				if(std::isnan(c[y * c_stride + x]) == false){ num_padding_written += 1; }
+			}
+		}
+
+		check(
+			num_wrong == 0,
+			"{} (m: {}, n: {}, k: {}): {} values outside of the tolerance",
+			name, shape.m, shape.n, shape.k, num_wrong
+		);
+		check(
+			num_padding_written == 0,
+			"{} (m: {}, n: {}, k: {}): wrote {} values past the end of the rows",
+			name, shape.m, shape.n, shape.k, num_padding_written
+		);
+	}
+
+
+	static auto test_gemm(std::mt19937& rng) -> void {
+		for(const GEMMShape& shape : GEMM_SHAPES){
+			// strides that are not a multiple of the SIMD width
+			const size_t a_stride = shape.k + 3;
+			const size_t b_stride = shape.n + 5;
+			const size_t c_stride = shape.n + 2;
+
+			const std::vector<float> a = randomValues(shape.m * a_stride, rng);
+			const std::vector<float> b = randomValues(shape.k * b_stride, rng);
+			auto c = std::vector<float>(shape.m * c_stride);
+
+			std::ranges::fill(c, std::numeric_limits<float>::quiet_NaN());
+			kernels::gemm(a.data(), a_stride, b.data(), b_stride, c.data(), c_stride, shape.m, shape.n, shape.k);
+			check_gemm_result("gemm", a.data(), a_stride, b.data(), b_stride, c.data(), c_stride, shape);
+
+			std::ranges::fill(c, std::numeric_limits<float>::quiet_NaN());
+			const std::vector<kernels::BF16> b_bf16 = to_half<kernels::BF16>(b);
+			const std::vector<float> b_bf16_widened = widened<kernels::BF16>(b_bf16);
+			kernels::gemm(a.data(), a_stride, b_bf16.data(), b_stride, c.data(), c_stride, shape.m, shape.n, shape.k);
+			check_gemm_result(
+				"gemm (bf16)", a.data(), a_stride, b_bf16_widened.data(), b_stride, c.data(), c_stride, shape
+			);
+
+			std::ranges::fill(c, std::numeric_limits<float>::quiet_NaN());
+			const std::vector<kernels::FP16> b_fp16 = to_half<kernels::FP16>(b);
+			const std::vector<float> b_fp16_widened = widened<kernels::FP16>(b_fp16);
+			kernels::gemm(a.data(), a_stride, b_fp16.data(), b_stride, c.data(), c_stride, shape.m, shape.n, shape.k);
+			check_gemm_result(
+				"gemm (fp16)", a.data(), a_stride, b_fp16_widened.data(), b_stride, c.data(), c_stride, shape
+			);
+		}
+	}
+
+
+	static auto test_gemm_parallel(std::mt19937& rng) -> void {
+		// above and below `DEFAULT_PARALLEL_GEMM_THRESHOLD`
+		for(const GEMMShape& shape : {GEMMShape(200, 150, 300), GEMMShape(130, 129, 128), GEMMShape(8, 64, 64)}){
+			const std::vector<float> a = randomValues(shape.m * shape.k, rng);
+			const std::vector<float> b = randomValues(shape.k * shape.n, rng);
+			auto c = std::vector<float>(shape.m * shape.n);
+
+			kernels::gemmParallel(a.data(), shape.k, b.data(), shape.n, c.data(), shape.n, shape.m, shape.n, shape.k);
+			check_gemm_result("gemmParallel", a.data(), shape.k, b.data(), shape.n, c.data(), shape.n, shape);
+		}
+	}
+
+
+	static auto test_gemm_batched(std::mt19937& rng) -> void {
+		// `n == 1` is interleaved 4 at a time, so also use batch sizes that are not a multiple of 4
+		for(const GEMMShape& shape : {GEMMShape(1, 1, 42), GEMMShape(3, 1, 9), GEMMShape(2, 5, 17), GEMMShape(1, 64, 64)}){
+			for(size_t batch_size : {1, 3, 4, 37}){
+				auto a = std::vector<std::vector<float>>();
+				auto b = std::vector<std::vector<float>>();
+				auto c = std::vector<std::vector<float>>();
+				auto batch = std::vector<kernels::GEMMBatchEntry>();
+
+				for(size_t i = 0; i < batch_size; i+=1){
+					a.emplace_back(randomValues(shape.m * shape.k, rng));
+					b.emplace_back(randomValues(shape.k * shape.n, rng));
+					c.emplace_back(shape.m * shape.n);
+				}
+				for(size_t i = 0; i < batch_size; i+=1){
+					batch.emplace_back(a[i].data(), shape.k, b[i].data(), shape.n, c[i].data(), shape.n);
+				}
+
+				kernels::gemmBatched(batch, shape.m, shape.n, shape.k);
+				for(size_t i = 0; i < batch_size; i+=1){
+					check_gemm_result("gemmBatched", a[i].data(), shape.k, b[i].data(), shape.n, c[i].data(), shape.n, shape);
+				}
+
+				for(std::vector<float>& output : c){
+					std::ranges::fill(output, 0.0f);
+				}
+
+				kernels::gemmBatchedParallel(batch, shape.m, shape.n, shape.k);
+				for(size_t i = 0; i < batch_size; i+=1){
+					check_gemm_result(
+						"gemmBatchedParallel", a[i].data(), shape.k, b[i].data(), shape.n, c[i].data(), shape.n, shape
+					);
+				}
+			}
+		}
+	}
+
+
+	// `w` is the fp32 value of the weights that `gemv_func` uses
+	template<class GEMVFunc>
+	static auto check_gemv(
+		std::string_view name, std::mt19937& rng, std::span<const float> w, size_t w_stride, size_t n, size_t k,
+		GEMVFunc&& gemv_func
+	) -> void {
+		const std::vector<float> x = randomValues(k, rng);
+
+		for(kernels::Activation activation : ACTIVATIONS){
+			auto y = std::vector<float>(n);
+			gemv_func(x.data(), y.data(), activation);
+
+			size_t num_wrong = 0;
+			for(size_t j = 0; j < n; j+=1){
+				float sum = 0.0f;
+				float magnitude = 0.0f;
+				for(size_t p = 0; p < k; p+=1){
+					sum += x[p] * w[p * w_stride + j];
+					magnitude += std::abs(x[p]) * std::abs(w[p * w_stride + j]);
+				}
+
+				// the activations are all 1-Lipschitz, and the fast ones are within 1e-6 of each other
+				const float tolerance = 2.0f * float(k) * FLT_EPSILON * magnitude + 2e-6f;
+				if(std::abs(y[j] - kernels::activate(activation, sum)) > tolerance){ num_wrong += 1; }
+			}
+
+			check(
+				num_wrong == 0,
+				"{} (n: {}, k: {}, activation: {}): {} values outside of the tolerance",
+				name, n, k, size_t(activation), num_wrong
+			);
+		}
+	}
+
+	static auto test_gemv(std::mt19937& rng) -> void {
+		for(size_t n : {1, 7, 15, 16, 64, 65, 130, 257}){
+			for(size_t k : {1, 9, 42, 128}){
+				const size_t w_stride = n + 3;
+				const std::vector<float> w = randomValues(k * w_stride, rng);
+
+				check_gemv("gemv", rng, w, w_stride, n, k, [&](const float* x, float* y, kernels::Activation activation){
+					kernels::gemv(x, w.data(), w_stride, y, n, k, activation);
+				});
+
+				const std::vector<kernels::BF16> w_bf16 = to_half<kernels::BF16>(w);
+				check_gemv(
+					"gemv (bf16)", rng, widened<kernels::BF16>(w_bf16), w_stride, n, k,
+					[&](const float* x, float* y, kernels::Activation activation){
+						kernels::gemv(x, w_bf16.data(), w_stride, y, n, k, activation);
+					}
+				);
+
+				const std::vector<kernels::FP16> w_fp16 = to_half<kernels::FP16>(w);
+				check_gemv(
+					"gemv (fp16)", rng, widened<kernels::FP16>(w_fp16), w_stride, n, k,
+					[&](const float* x, float* y, kernels::Activation activation){
+						kernels::gemv(x, w_fp16.data(), w_stride, y, n, k, activation);
+					}
+				);
+			}
+		}
+	}
+
+
+	static auto test_fast_activations() -> void {
+		auto inputs = std::vector<float>();
+		for(float value = -20.0f; value <= 20.0f; value += 1.0f / 1024.0f){
+			inputs.emplace_back(value);
+		}
+		auto outputs = std::vector<float>(inputs.size());
+
+		kernels::fastTanh(inputs.data(), outputs.data(), inputs.size());
+		float max_error = 0.0f;
+		for(size_t i = 0; i < inputs.size(); i+=1){
+			max_error = std::max(max_error, std::abs(outputs[i] - std::tanh(inputs[i])));
+			max_error = std::max(max_error, std::abs(kernels::fastTanh(inputs[i]) - std::tanh(inputs[i])));
+		}
+		check(max_error < 1e-6f, "fastTanh: max error {} (should be below 1e-6)", max_error);
+
+		kernels::fastSigmoid(inputs.data(), outputs.data(), inputs.size());
+		max_error = 0.0f;
+		for(size_t i = 0; i < inputs.size(); i+=1){
+			max_error = std::max(max_error, std::abs(outputs[i] - sigmoid(inputs[i])));
+			max_error = std::max(max_error, std::abs(kernels::fastSigmoid(inputs[i]) - sigmoid(inputs[i])));
+		}
+		check(max_error < 1e-6f, "fastSigmoid: max error {} (should be below 1e-6)", max_error);
+	}
+
+
+	// every value that is not NaN survives a round trip, and NaN stays NaN
+	template<class Half>
+	static auto test_half_round_trip(std::string_view name) -> void {
+		size_t num_wrong = 0;
+		for(uint32_t bits = 0; bits <= 0xFFFF; bits+=1){
+			auto half = Half();
+			half.bits = uint16_t(bits);
+
+			const float value = float(half);
+			if(std::isnan(value)){
+				if(std::isnan(float(Half(value))) == false){ num_wrong += 1; }
+			}else if(Half(value).bits != half.bits){
+				num_wrong += 1;
+			}
+		}
+		check(num_wrong == 0, "{}: {} values did not survive a round trip", name, num_wrong);
+	}
+
+	static auto test_half(std::mt19937& rng) -> void {
+		test_half_round_trip<kernels::BF16>("BF16");
+		test_half_round_trip<kernels::FP16>("FP16");
+
+		// round to nearest, ties to even
+		check(float(kernels::BF16(1.0f + 0x1p-8f)) == 1.0f, "BF16: tie should round to even (down)");
+		check(float(kernels::BF16(1.0f + 0x3p-8f)) == 1.0f + 0x1p-6f, "BF16: tie should round to even (up)");
+		check(float(kernels::FP16(1.0f + 0x1p-11f)) == 1.0f, "FP16: tie should round to even (down)");
+		check(float(kernels::FP16(1.0f + 0x3p-11f)) == 1.0f + 0x1p-9f, "FP16: tie should round to even (up)");
+
+		check(float(kernels::FP16(65519.0f)) == 65504.0f, "FP16: 65519 should round to 65504");
+		check(std::isinf(float(kernels::FP16(65520.0f))), "FP16: 65520 should overflow to inf");
+		check(float(kernels::FP16(0x1p-24f)) == 0x1p-24f, "FP16: smallest subnormal");
+		check(float(kernels::FP16(0x1p-25f)) == 0.0f, "FP16: half of the smallest subnormal should round to 0");
+
+		// relative error of the normal range
+		size_t num_bf16_wrong = 0;
+		size_t num_fp16_wrong = 0;
+		for(float value : randomValues(10'000, rng, -1000.0f, 1000.0f)){
+			if(std::abs(float(kernels::BF16(value)) - value) > std::abs(value) * 0x1p-8f){ num_bf16_wrong += 1; }
+
+			if(std::abs(value) >= 0x1p-14f && std::abs(float(kernels::FP16(value)) - value) > std::abs(value) * 0x1p-11f){
+				num_fp16_wrong += 1;
+			}
+		}
+		check(num_bf16_wrong == 0, "BF16: {} values rounded further than half an ulp", num_bf16_wrong);
+		check(num_fp16_wrong == 0, "FP16: {} values rounded further than half an ulp", num_fp16_wrong);
+
+		const std::vector<float> values = randomValues(37 * 11, rng);
+		const auto matrix = Matrix(37, 11, values);
+		const Matrix bf16_matrix = HalfMatrix<kernels::BF16>(matrix).toMatrix();
+		const Matrix fp16_matrix = HalfMatrix<kernels::FP16>(matrix).toMatrix();
+
+		size_t num_matrix_wrong = 0;
+		for(size_t y = 0; y < matrix.height(); y+=1){
+			for(size_t x = 0; x < matrix.width(); x+=1){
+				if(bf16_matrix[x, y] != float(kernels::BF16(matrix[x, y]))){ num_matrix_wrong += 1; }
+				if(fp16_matrix[x, y] != float(kernels::FP16(matrix[x, y]))){ num_matrix_wrong += 1; }
+			}
+		}
+		check(num_matrix_wrong == 0, "HalfMatrix: {} values were not rounded like a single value", num_matrix_wrong);
+	}
+
+
+	static auto test_int8(std::mt19937& rng) -> void {
+		// quantizeInt8
+
+		const std::vector<float> values = randomValues(1000, rng, -3.0f, 3.0f);
+		auto quantized = std::vector<int8_t>(values.size());
+		const float scale = kernels::quantizeInt8(values.data(), quantized.data(), values.size());
+
+		const float max_abs = std::ranges::max(values, {}, [](float value){ return std::abs(value); });
+		check(scale == std::abs(max_abs) / 127.0f, "quantizeInt8: scale should be max(|input|) / 127");
+
+		size_t num_wrong = 0;
+		for(size_t i = 0; i < values.size(); i+=1){
+			if(quantized[i] == -128){ num_wrong += 1; }
+			if(std::abs(float(quantized[i]) * scale - values[i]) > scale * 0.5f * (1.0f + 1e-5f)){ num_wrong += 1; }
+		}
+		check(num_wrong == 0, "quantizeInt8: {} values did not round trip within half a step", num_wrong);
+
+
+		// packInt8Weights + gemvInt8
+
+		const size_t n = 37;
+		const size_t k = 42;
+		const size_t padded_n = kernels::int8PaddedColumns(n);
+		const size_t padded_k = kernels::int8PaddedRows(k);
+		const size_t k_groups = padded_k / kernels::INT8_GROUP_SIZE;
+
+		const std::vector<float> w = randomValues(k * n, rng);
+		auto packed = std::vector<int8_t>(padded_k * padded_n);
+		auto scales = std::vector<float>(padded_n);
+		auto column_sums = std::vector<int32_t>(padded_n);
+		kernels::packInt8Weights(w.data(), n, packed.data(), scales.data(), column_sums.data(), n, k);
+
+		// value (p, j) of the packed layout (see `kernels/int8.h`)
+		const auto packed_value = [&](size_t p, size_t j) -> int32_t {
+			return packed[((j / 16 * k_groups + p / 4) * 16 + j % 16) * 4 + p % 4];
+		};
+
+		size_t num_packed_wrong = 0;
+		for(size_t j = 0; j < padded_n; j+=1){
+			int32_t column_sum = 0;
+			for(size_t p = 0; p < padded_k; p+=1){
+				column_sum += packed_value(p, j);
+
+				if(p >= k || j >= n){
+					if(packed_value(p, j) != 0){ num_packed_wrong += 1; }
+				}else if(std::abs(float(packed_value(p, j)) * scales[j] - w[p * n + j]) > scales[j] * 0.5f * (1.0f + 1e-5f)){
+					num_packed_wrong += 1;
+				}
+			}
+			if(column_sum != column_sums[j]){ num_packed_wrong += 1; }
+		}
+		check(num_packed_wrong == 0, "packInt8Weights: {} values or column sums are wrong", num_packed_wrong);
+
+		const std::vector<float> x = randomValues(k, rng);
+		auto x_quantized = std::vector<int8_t>(padded_k);
+		const float x_scale = kernels::quantizeInt8(x.data(), x_quantized.data(), k);
+
+		for(kernels::Activation activation : ACTIVATIONS){
+			auto y = std::vector<float>(padded_n);
+			kernels::gemvInt8(
+				x_quantized.data(), x_scale, packed.data(), scales.data(), column_sums.data(), y.data(), n, k, activation
+			);
+
+			size_t num_y_wrong = 0;
+			for(size_t j = 0; j < n; j+=1){
+				int32_t dot = 0;
+				for(size_t p = 0; p < k; p+=1){
+					dot += int32_t(x_quantized[p]) * packed_value(p, j);
+				}
+
+				const float expected = kernels::activate(activation, float(dot) * x_scale * scales[j]);
+				if(std::abs(y[j] - expected) > 1e-5f * std::max(1.0f, std::abs(expected)) + 2e-6f){ num_y_wrong += 1; }
+			}
+			check(
+				num_y_wrong == 0,
+				"gemvInt8 (activation: {}): {} values are not the exact int32 dot product",
+				size_t(activation), num_y_wrong
+			);
+		}
+	}
+
+
+	static auto test_philox() -> void {
+		// Known answers (Random123, kat_vectors for philox4x32_10)
+		const auto check_philox = [](
+			std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key, std::array<uint32_t, 4> expected
+		) -> void {
+			check(
+				kernels::philox4x32(counter, key) == expected,
+				"philox4x32: wrong result for counter {:x} {:x} {:x} {:x}",
+				counter[0], counter[1], counter[2], counter[3]
+			);
+		};
+
+		check_philox({0, 0, 0, 0}, {0, 0}, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+		check_philox(
+			{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+			{0xffffffff, 0xffffffff},
+			{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}
+		);
+		check_philox(
+			{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+			{0xa4093822, 0x299f31d0},
+			{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}
+		);
+
+
+		// the SIMD implementations against the order documented in `kernels/philox.h`
+		const auto stream = kernels::RandomStream(0x0123'4567'89AB'CDEF, 0x1'0000'0007, 3);
+		const auto expected_uniform = [&](size_t index) -> float {
+			const size_t chunk = index / kernels::PHILOX_CHUNK_SIZE;
+			const size_t word = index % kernels::PHILOX_CHUNK_SIZE / 16;
+			const size_t lane = index % 16;
+
+			const std::array<uint32_t, 4> bits = kernels::philox4x32(
+				{uint32_t(chunk * 16 + lane), stream.sub_id, uint32_t(stream.id), uint32_t(stream.id >> 32)},
+				{uint32_t(stream.seed), uint32_t(stream.seed >> 32)}
+			);
+			return float(bits[word] >> 8) * 0x1p-24f;
+		};
+
+		for(size_t first_chunk : {0, 3}){
+			for(size_t size : {1, 63, 64, 65, 1000}){
+				auto uniform = std::vector<float>(size);
+				kernels::fillUniform01(uniform, stream, first_chunk);
+
+				size_t num_wrong = 0;
+				for(size_t i = 0; i < size; i+=1){
+					if(uniform[i] != expected_uniform(first_chunk * kernels::PHILOX_CHUNK_SIZE + i)){ num_wrong += 1; }
+				}
+				check(
+					num_wrong == 0,
+					"fillUniform01 (first chunk: {}, size: {}): {} values are not the values of the stream",
+					first_chunk, size, num_wrong
+				);
+
+				// Box-Muller on the same values
+				auto normal = std::vector<float>(size);
+				kernels::fillNormal(normal, stream, first_chunk);
+
+				size_t num_normal_wrong = 0;
+				for(size_t i = 0; i < size; i+=1){
+					const size_t index = first_chunk * kernels::PHILOX_CHUNK_SIZE + i;
+					const size_t chunk_start = index / kernels::PHILOX_CHUNK_SIZE * kernels::PHILOX_CHUNK_SIZE;
+					const size_t pair = index % (kernels::PHILOX_CHUNK_SIZE / 2);
+
+					const float radius = std::sqrt(-2.0f * std::log(1.0f - expected_uniform(chunk_start + pair)));
+					const float angle = 2.0f * std::numbers::pi_v<float>
+						* expected_uniform(chunk_start + pair + kernels::PHILOX_CHUNK_SIZE / 2);
+					const float expected = index % kernels::PHILOX_CHUNK_SIZE < kernels::PHILOX_CHUNK_SIZE / 2
+						? radius * std::cos(angle)
+						: radius * std::sin(angle);
+
+					if(std::abs(normal[i] - expected) > 2e-5f){ num_normal_wrong += 1; }
+				}
+				check(
+					num_normal_wrong == 0,
+					"fillNormal (first chunk: {}, size: {}): {} values are not Box-Muller of the stream",
+					first_chunk, size, num_normal_wrong
+				);
+			}
+		}
+
+		auto whole = std::vector<float>(4 * kernels::PHILOX_CHUNK_SIZE);
+		auto offset = std::vector<float>(kernels::PHILOX_CHUNK_SIZE);
+		kernels::fillUniform01(whole, stream);
+		kernels::fillUniform01(offset, stream, 2);
+		check(
+			std::ranges::equal(offset, std::span(whole).subspan(2 * kernels::PHILOX_CHUNK_SIZE, kernels::PHILOX_CHUNK_SIZE)),
+			"fillUniform01: starting at a chunk should give the same values as filling from the start"
+		);
+	}
+
+
+	auto kernelTests() -> void {
+		auto rng = std::mt19937(5489);
+
+		test_gemm(rng);
+		test_gemm_parallel(rng);
+		test_gemm_batched(rng);
+		test_gemv(rng);
+		test_fast_activations();
+		test_half(rng);
+		test_int8(rng);
+		test_philox();
+	}
+
+
+}
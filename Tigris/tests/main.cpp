@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "./tests.h"
+
+
+namespace tigris::tests{
+
+	static size_t num_failures = 0;
+
+	auto fail(std::string_view message) -> void {
+		num_failures += 1;
+		evo::printlnRed("\tFAILED: {}", message);
+	}
+
+	auto numFailures() -> size_t {
+		return num_failures;
+	}
+
+}
+
+
+
+struct TestGroup{
+	std::string_view name;
+	auto(*func)() -> void;
+};
+
+static constexpr auto TEST_GROUPS = std::to_array<TestGroup>({
+	{"kernels",    &tigris::tests::kernelTests},
+	{"inference",  &tigris::tests::inferenceTests},
+	{"population", &tigris::tests::populationTests},
+	{"mutation",   &tigris::tests::mutationTests},
+});
+
+
+// `tigris_tests [group...]` runs only the named groups (all of them by default)
+auto main(int argc, const char* argv[]) -> int {
+	const auto args = std::vector<std::string_view>(argv, argv + argc);
+
+	evo::log::setDefaultThreadSaferCallback();
+
+	for(size_t i = 1; i < args.size(); i+=1){
+		const bool is_known_group = std::ranges::any_of(TEST_GROUPS, [&](const TestGroup& group){
+			return group.name == args[i];
+		});
+
+		if(is_known_group == false){
+			evo::printlnRed("Unknown test group \"{}\"", args[i]);
+			return 1;
+		}
+	}
+
+	for(const TestGroup& group : TEST_GROUPS){
+		if(args.size() > 1 && std::ranges::find(args, group.name) == args.end()){ continue; }
+
+		evo::printlnCyan("{}", group.name);
+
+		const size_t failures_before = tigris::tests::numFailures();
+		group.func();
+
+		if(tigris::tests::numFailures() == failures_before){
+			evo::printlnGreen("\tpassed");
+		}
+	}
+
+	if(tigris::tests::numFailures() != 0){
+		evo::printlnRed("{} checks failed", tigris::tests::numFailures());
+		return 1;
+	}
+
+	evo::printlnGreen("All tests passed");
+	return 0;
+}
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "./tests.h"
+
+#include "AI.h"
+#include "kernels/mutation.h"
+
+
+namespace tigris::tests{
+
+	// `kernels::MutationSampler` must pick the same distribution of weights as a Bernoulli trial per weight:
+	// 	the number picked per trial is binomial, the gaps between picked weights are geometric, and the positions
+	// 	are uniform. The samplers are deterministic (fixed streams), so these never fail by chance.
+	static auto test_sampler_matches_bernoulli() -> void {
+		static constexpr size_t NUM_WEIGHTS = 1 << 16;
+		static constexpr size_t NUM_TRIALS = 200;
+		static constexpr size_t NUM_GAP_BINS = 16; // the last bin is every larger gap
+		static constexpr size_t NUM_POSITION_BINS = 16;
+
+		// 15 degrees of freedom, P(chi2 > 40) is about 0.0005
+		static constexpr double MAX_CHI2 = 40.0;
+
+		// number of standard errors the count mean and variance may be off by
+		static constexpr double MAX_ERRORS = 5.0;
+
+		for(float probability : {0.001f, 0.01f, 0.1f, 0.5f, 0.99f}){
+			auto gap_bins = std::array<double, NUM_GAP_BINS>();
+			auto position_bins = std::array<double, NUM_POSITION_BINS>();
+			double count_sum = 0.0;
+			double count_squared_sum = 0.0;
+
+			// gaps are binned in units of the mean gap so every probability uses the same bins
+			const double p = double(probability);
+			const double bin_width = std::max(1.0, std::ceil((1.0 - p) / p / 4.0));
+
+			for(size_t trial = 0; trial < NUM_TRIALS; trial+=1){
+				auto sampler = kernels::MutationSampler(probability, kernels::RandomStream(2, trial, 0));
+
+				size_t count = 0;
+				size_t next_gap_start = 0;
+				bool in_order = true;
+				sampler.forEachMutated(NUM_WEIGHTS, [&](size_t i) -> void {
+					if(i < next_gap_start || i >= NUM_WEIGHTS){
+						in_order = false;
+						return;
+					}
+
+					count += 1;
+					position_bins[i * NUM_POSITION_BINS / NUM_WEIGHTS] += 1.0;
+
+					const size_t gap = i - next_gap_start;
+					gap_bins[std::min(size_t(double(gap) / bin_width), NUM_GAP_BINS - 1)] += 1.0;
+					next_gap_start = i + 1;
+				});
+
+				if(check(in_order, "MutationSampler (p = {}): indices not ascending or out of range", p) == false){
+					return;
+				}
+
+				count_sum += double(count);
+				count_squared_sum += double(count) * double(count);
+			}
+
+			// binomial count
+			const double mean = count_sum / double(NUM_TRIALS);
+			const double variance = (count_squared_sum - count_sum * mean) / double(NUM_TRIALS - 1);
+			const double expected_mean = double(NUM_WEIGHTS) * p;
+			const double expected_variance = expected_mean * (1.0 - p);
+
+			const double mean_error = std::sqrt(expected_variance / double(NUM_TRIALS));
+			check(
+				std::abs(mean - expected_mean) < MAX_ERRORS * mean_error,
+				"MutationSampler (p = {}): mean count {} (expected {})", p, mean, expected_mean
+			);
+
+			const double variance_error = expected_variance * std::sqrt(2.0 / double(NUM_TRIALS - 1));
+			check(
+				std::abs(variance - expected_variance) < MAX_ERRORS * variance_error,
+				"MutationSampler (p = {}): count variance {} (expected {})", p, variance, expected_variance
+			);
+
+			// geometric gaps: P(gap >= g) = (1 - p)^g (ignoring the cut off at the end of the weights)
+			double gap_chi2 = 0.0;
+			for(size_t bin = 0; bin < NUM_GAP_BINS; bin+=1){
+				const double start = std::pow(1.0 - p, double(bin) * bin_width);
+				const double end = bin == NUM_GAP_BINS - 1 ? 0.0 : std::pow(1.0 - p, double(bin + 1) * bin_width);
+				const double expected = count_sum * (start - end);
+
+				// bins the distribution can (almost) never reach
+				if(expected < 5.0){
+					check(gap_bins[bin] < 5.0, "MutationSampler (p = {}): {} gaps in bin {}", p, gap_bins[bin], bin);
+					continue;
+				}
+				gap_chi2 += (gap_bins[bin] - expected) * (gap_bins[bin] - expected) / expected;
+			}
+			check(gap_chi2 < MAX_CHI2, "MutationSampler (p = {}): gap chi-squared {}", p, gap_chi2);
+
+			// uniform positions
+			double position_chi2 = 0.0;
+			const double expected_per_position_bin = count_sum / double(NUM_POSITION_BINS);
+			for(double bin : position_bins){
+				position_chi2 += (bin - expected_per_position_bin) * (bin - expected_per_position_bin)
+					/ expected_per_position_bin;
+			}
+			check(position_chi2 < MAX_CHI2, "MutationSampler (p = {}): position chi-squared {}", p, position_chi2);
+		}
+
+
+		auto always = kernels::MutationSampler(1.0f, kernels::RandomStream(2, 0, 0));
+		size_t num_always = 0;
+		always.forEachMutated(1000, [&](size_t i) -> void { if(i == num_always){ num_always += 1; } });
+		check(num_always == 1000, "MutationSampler (p = 1): picked {} of 1000 weights in order", num_always);
+
+		auto never = kernels::MutationSampler(0.0f, kernels::RandomStream(2, 0, 0));
+		size_t num_never = 0;
+		never.forEachMutated(1000, [&](size_t) -> void { num_never += 1; });
+		check(num_never == 0, "MutationSampler (p = 0): picked {} weights", num_never);
+	}
+
+
+	// `mutation_rate` is the probability of a weight being skipped
+	static auto test_mutation_rate() -> void {
+		const auto dimentions = std::to_array<size_t>({42, 128, 128, 1});
+
+		auto original = AI(dimentions);
+		original.randomize(7, 0);
+
+		size_t num_weights = 0;
+		for(const Matrix& layer : original.getMatrices()){
+			num_weights += layer.width() * layer.height();
+		}
+
+		for(float mutation_rate : {0.0f, 0.02f, 0.5f, 0.98f, 1.0f}){
+			auto ai = original;
+			ai.mutate(mutation_rate, kernels::RandomStream(3, 0, 0));
+
+			// every mutation adds a value in [0, 1), which is only 0 with probability 2^-24
+			size_t num_changed = 0;
+			for(size_t i = 0; i < ai.getMatrices().size(); i+=1){
+				const Matrix& layer = ai.getMatrices()[i];
+				const Matrix& original_layer = original.getMatrices()[i];
+
+				for(size_t y = 0; y < layer.height(); y+=1){
+					for(size_t x = 0; x < layer.width(); x+=1){
+						if(layer[x, y] != original_layer[x, y]){ num_changed += 1; }
+					}
+				}
+			}
+
+			const double expected = double(num_weights) * (1.0 - double(mutation_rate));
+			const double error = std::sqrt(expected * double(mutation_rate));
+			check(
+				std::abs(double(num_changed) - expected) <= 5.0 * error + 1.0,
+				"AI::mutate (rate {}): changed {} of {} weights (expected {})",
+				mutation_rate, num_changed, num_weights, expected
+			);
+		}
+	}
+
+
+	auto mutationTests() -> void {
+		test_sampler_matches_bernoulli();
+		test_mutation_rate();
+	}
+
+
+}
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "./tests.h"
+
+#include "Environment.h"
+
+
+namespace tigris::tests{
+
+	static constexpr auto PRECISIONS = std::to_array<kernels::WeightPrecision>({
+		kernels::WeightPrecision::FP32,
+		kernels::WeightPrecision::BF16,
+		kernels::WeightPrecision::FP16,
+	});
+
+
+	// exactly the same weights (compared in fp32, where every reduced precision value is exact)
+	static auto same_weights(const AI& lhs, const AI& rhs) -> bool {
+		if(lhs.getPrecision() != rhs.getPrecision()){ return false; }
+
+		const AI lhs_fp32 = lhs.withPrecision(kernels::WeightPrecision::FP32);
+		const AI rhs_fp32 = rhs.withPrecision(kernels::WeightPrecision::FP32);
+		return std::ranges::equal(lhs_fp32.getMatrices(), rhs_fp32.getMatrices());
+	}
+
+
+	// every operation on a genome of a `Population` gives the same weights as on an `AI` of the same precision
+	static auto test_population_matches_ai(std::mt19937& rng) -> void {
+		static constexpr size_t NUM_GENOMES = 6;
+		static constexpr uint64_t SEED = 12;
+		const auto dimentions = std::to_array<size_t>({42, 128, 7});
+
+		for(kernels::WeightPrecision precision : PRECISIONS){
+			auto population = Population(NUM_GENOMES, dimentions, precision, kernels::Activation::FAST_TANH);
+			check(population.getPrecision() == precision, "Population: wrong precision");
+
+			for(size_t i = 0; i < NUM_GENOMES; i+=1){
+				population.randomize(i, SEED);
+			}
+
+			auto ai = AI(dimentions, precision, kernels::Activation::FAST_TANH);
+			ai.randomize(SEED, 2);
+			check(
+				same_weights(population.toAI(2), ai),
+				"Population::randomize (precision {}): different weights than AI::randomize", size_t(precision)
+			);
+
+			const std::vector<float> inputs = randomValues(population.numInputs(), rng);
+			const float difference = maxDifference(population.calculate(2, inputs), ai.calculate(inputs));
+			check(
+				difference < 1e-5f,
+				"Population::calculate (precision {}): differs from AI::calculate by {}", size_t(precision), difference
+			);
+
+			// reduced precision mutations are rounded back to the stored precision
+			const auto stream = kernels::RandomStream(SEED, 2, 0);
+			population.mutate(2, 0.1f, stream);
+			ai.mutate(0.1f, stream);
+			check(
+				same_weights(population.toAI(2), ai),
+				"Population::mutate (precision {}): different weights than AI::mutate", size_t(precision)
+			);
+
+			population.mutateGaussian(2, 0.1f, 0.2f, stream);
+			ai.mutateGaussian(0.1f, 0.2f, stream);
+			check(
+				same_weights(population.toAI(2), ai),
+				"Population::mutateGaussian (precision {}): different weights than AI::mutateGaussian", size_t(precision)
+			);
+
+			population.copyGenome(4, 2);
+			check(
+				same_weights(population.toAI(4), ai),
+				"Population::copyGenome (precision {}): the copy has different weights", size_t(precision)
+			);
+
+			const auto other_ai = AI(dimentions, kernels::WeightPrecision::FP32, kernels::Activation::FAST_TANH);
+			population.setGenome(5, other_ai);
+			check(
+				same_weights(population.toAI(5), other_ai.withPrecision(precision)),
+				"Population::setGenome (precision {}): the weights were not rounded to the population", size_t(precision)
+			);
+		}
+	}
+
+
+	static auto test_reduced_precision_environment() -> void {
+		static constexpr size_t POPULATION = 40;
+		const auto dimentions = std::to_array<size_t>({9, 64, 1});
+
+		auto fp32_environment = Environment(POPULATION, dimentions, kernels::WeightPrecision::FP32);
+		auto bf16_environment = Environment(POPULATION, dimentions, kernels::WeightPrecision::BF16);
+		fp32_environment.initRandom(12);
+		bf16_environment.initRandom(12);
+
+		// {9, 64, 1} has no padding that depends on the weight type
+		check(
+			bf16_environment.population.weightBytes() * 2 == fp32_environment.population.weightBytes(),
+			"Environment (bf16): the population takes {} bytes instead of half of {}",
+			bf16_environment.population.weightBytes(), fp32_environment.population.weightBytes()
+		);
+
+		bf16_environment.beginGame();
+		std::ranges::fill(bf16_environment.scores, 1.0f);
+		bf16_environment.setScoresToReproductionChance();
+		bf16_environment.createNewPopulation(0.1f, 2);
+
+		check(
+			bf16_environment.population.getPrecision() == kernels::WeightPrecision::BF16
+				&& bf16_environment.getAI(POPULATION - 1).getPrecision() == kernels::WeightPrecision::BF16,
+			"Environment (bf16): the next generation is not stored in bf16"
+		);
+
+		const StackedAI stacked_ai = bf16_environment.stackPopulation();
+		const auto inputs = Matrix(9, 1, {1, 0, -1, 0, 1, 0, -1, 0, 1});
+		const ConstMatrixView outputs = stacked_ai.calculate(inputs.view());
+
+		float difference = 0.0f;
+		for(size_t i = 0; i < POPULATION; i+=1){
+			difference = std::max(difference, std::abs(outputs[i, 0] - bf16_environment.getAI(i).calculate(inputs.row(0))[0]));
+		}
+		check(difference < 1e-5f, "Environment::stackPopulation (bf16): differs from getAI() by {}", difference);
+	}
+
+
+	static auto test_create_new_population() -> void {
+		static constexpr size_t POPULATION = 40;
+		static constexpr size_t BEST = 7;
+
+		auto environment = Environment(POPULATION, std::to_array<size_t>({9, 64, 1}));
+		environment.initRandom(12);
+		environment.enableEvaluationCache(16);
+
+		environment.beginGame();
+		std::ranges::fill(environment.scores, 1.0f);
+		environment.scores[BEST] = 2.0f;
+		environment.setScoresToReproductionChance();
+
+		const AI best = environment.getAI(BEST);
+		environment.evaluationCaches[BEST].insert(1, 0.5f);
+		environment.evaluationCaches[BEST + 1].insert(1, 0.5f);
+
+		environment.createNewPopulation(0.1f, 2);
+
+		check(same_weights(environment.getAI(0), best), "Environment::createNewPopulation: did not keep the best genome");
+		check(
+			environment.evaluationCaches[0].find(1).has_value(),
+			"Environment::createNewPopulation: the kept genome lost the evaluations of its parent"
+		);
+
+		size_t num_cached_children = 0;
+		for(size_t i = 1; i < POPULATION; i+=1){
+			if(environment.evaluationCaches[i].find(1).has_value()){ num_cached_children += 1; }
+		}
+		check(
+			num_cached_children == 0,
+			"Environment::createNewPopulation: {} new or mutated genomes kept evaluations", num_cached_children
+		);
+	}
+
+
+	auto populationTests() -> void {
+		auto rng = std::mt19937(5489);
+
+		test_population_matches_ai(rng);
+		test_reduced_precision_environment();
+		test_create_new_population();
+	}
+
+
+}
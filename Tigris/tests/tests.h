@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////////
+//                                                                                //
+// Part of Tigris, under the MIT License.                                         //
+// You may not use this file except in compliance with the License.               //
+// See `https://github.com/12Thanjo/Tigris/blob/main/LICENSE`for info.            //
+//                                                                                //
+////////////////////////////////////////////////////////////////////////////////////
+
+
+
+
+#pragma once
+
+
+#include <Evo.h>
+
+#include <random>
+#include <span>
+
+
+namespace tigris::tests{
+
+	// Exceptions are off, so a failed check is counted (and printed) instead of thrown.
+	// 	`tigris_tests` returns non-zero if any check failed.
+
+	auto fail(std::string_view message) -> void;
+	EVO_NODISCARD auto numFailures() -> size_t;
+
+	// returns `condition`
+	template<class... Args>
+	auto check(bool condition, std::format_string<Args...> message, Args&&... args) -> bool {
+		if(condition == false){
+			fail(std::format(message, std::forward<Args>(args)...));
+		}
+		return condition;
+	}
+
+
+	// largest `|a[i] - b[i]|` (`a` and `b` must have the same size)
+	EVO_NODISCARD inline auto maxDifference(std::span<const float> a, std::span<const float> b) -> float {
+		evo::debugAssert(a.size() == b.size(), "Sizes do not match");
+
+		float max_difference = 0.0f;
+		for(size_t i = 0; i < a.size(); i+=1){
+			max_difference = std::max(max_difference, std::abs(a[i] - b[i]));
+		}
+		return max_difference;
+	}
+
+
+	// uniform in [min, max)
+	EVO_NODISCARD inline auto randomValues(size_t count, std::mt19937& rng, float min = -1.0f, float max = 1.0f)
+	-> std::vector<float> {
+		auto distribution = std::uniform_real_distribution<float>(min, max);
+
+		auto output = std::vector<float>(count);
+		for(float& value : output){
+			value = distribution(rng);
+		}
+		return output;
+	}
+
+
+	// one per file
+	auto kernelTests() -> void;
+	auto inferenceTests() -> void;
+	auto populationTests() -> void;
+	auto mutationTests() -> void;
+
+
+}